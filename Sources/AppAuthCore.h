@@ -19,9 +19,14 @@
 #import "OIDAuthState.h"
 #import "OIDAuthStateChangeDelegate.h"
 #import "OIDAuthStateErrorDelegate.h"
+#import "OIDAuthStateRegistry.h"
+#import "OIDAuthStateSnapshot.h"
 #import "OIDAuthorizationRequest.h"
 #import "OIDAuthorizationResponse.h"
 #import "OIDAuthorizationService.h"
+#import "OIDAuthorizedURLSession.h"
+#import "OIDCircuitBreaker.h"
+#import "OIDClock.h"
 #import "OIDError.h"
 #import "OIDErrorUtilities.h"
 #import "OIDExternalUserAgent.h"
@@ -29,6 +34,11 @@
 #import "OIDExternalUserAgentSession.h"
 #import "OIDGrantTypes.h"
 #import "OIDIDToken.h"
+#import "OIDIDTokenSignatureVerifier.h"
+#import "OIDJWKSCache.h"
+#import "OIDMetrics.h"
+#import "OIDMetricsAggregator.h"
+#import "OIDNetworkTask.h"
 #import "OIDRegistrationRequest.h"
 #import "OIDRegistrationResponse.h"
 #import "OIDResponseTypes.h"
@@ -36,9 +46,15 @@
 #import "OIDScopeUtilities.h"
 #import "OIDServiceConfiguration.h"
 #import "OIDServiceDiscovery.h"
+#import "OIDSharedAuthStateCoordinator.h"
+#import "OIDSharedTokenCache.h"
+#import "OIDTokenBroker.h"
+#import "OIDTokenRefreshRetryPolicy.h"
 #import "OIDTokenRequest.h"
+#import "OIDTokenRequestScheduler.h"
 #import "OIDTokenResponse.h"
 #import "OIDTokenUtilities.h"
+#import "OIDTrace.h"
 #import "OIDURLSessionProvider.h"
 #import "OIDEndSessionRequest.h"
 #import "OIDEndSessionResponse.h"
@@ -17,12 +17,17 @@
  */
 #import <Foundation/Foundation.h>
 
+#import "OIDTokenRequestScheduler.h"
+
 @class OIDAuthorizationRequest;
 @class OIDAuthorizationResponse;
 @class OIDAuthState;
+@class OIDAuthStateSnapshot;
+@class OIDNetworkTask;
 @class OIDRegistrationResponse;
 @class OIDTokenResponse;
 @class OIDTokenRequest;
+@class OIDTokenRefreshRetryPolicy;
 @protocol OIDAuthStateChangeDelegate;
 @protocol OIDAuthStateErrorDelegate;
 @protocol OIDExternalUserAgent;
@@ -48,6 +53,22 @@ typedef void (^OIDAuthStateAction)(NSString *_Nullable accessToken,
 typedef void (^OIDAuthStateAuthorizationCallback)(OIDAuthState *_Nullable authState,
                                                   NSError *_Nullable error);
 
+/*! @brief Called by @c OIDAuthState.decodeAuthStatesFromArchivedData:maximumConcurrency:
+        decodedHandler:completion: as soon as each auth state has been decoded.
+    @param key The key of the archived data the auth state was decoded from.
+    @param authState The decoded auth state.
+ */
+typedef void (^OIDAuthStateDecodedHandler)(NSString *key, OIDAuthState *authState);
+
+/*! @brief Called by @c OIDAuthState.decodeAuthStatesFromArchivedData:maximumConcurrency:
+        decodedHandler:completion: once all archived data has been decoded.
+    @param authStates The decoded auth states, by the key of the data they were decoded from.
+    @param errors The errors for the data which could not be decoded, by key.
+ */
+typedef void (^OIDAuthStateBulkDecodingCompletion)(
+    NSDictionary<NSString *, OIDAuthState *> *authStates,
+    NSDictionary<NSString *, NSError *> *errors);
+
 /*! @brief The exception thrown when a developer tries to create a refresh request from an
         authorization request with no authorization code.
  */
@@ -59,6 +80,14 @@ static NSString *const kRefreshTokenRequestException =
  */
 @interface OIDAuthState : NSObject <NSSecureCoding>
 
+/*! @brief The current state of the receiver, as an immutable snapshot.
+    @discussion Each change to the state publishes a new snapshot through a single atomic pointer
+        swap, so reading it from any thread never waits for a writer nor observes a partially
+        applied update. The other properties of this class read the current snapshot; read the
+        values which must be consistent with each other from the same snapshot instead.
+ */
+@property(atomic, readonly) OIDAuthStateSnapshot *snapshot;
+
 /*! @brief The most recent refresh token received from the server.
     @discussion Rather than using this property directly, you should call
         @c OIDAuthState.performActionWithFreshTokens:.
@@ -122,6 +151,16 @@ static NSString *const kRefreshTokenRequestException =
  */
 @property(nonatomic, weak, nullable) id<OIDAuthStateErrorDelegate> errorDelegate;
 
+/*! @brief The policy for retrying token refreshes which fail with a transient error, or nil to not
+        retry. Defaults to nil.
+    @discussion Actions passed to @c performActionWithFreshTokens: stay queued while a refresh is
+        retried, and are called once it succeeds or finally fails. The
+        OIDAuthStateErrorDelegate.authState:didEncounterTransientError: method of
+        @c #errorDelegate is only called when the refresh finally fails. The policy is not
+        archived.
+ */
+@property(nonatomic, strong, nullable) OIDTokenRefreshRetryPolicy *refreshRetryPolicy;
+
 /*! @brief Convenience method to create a @c OIDAuthState by presenting an authorization request
         and performing the authorization code exchange in the case of code flow requests. For
         the hybrid flow, the caller should validate the id_token and c_hash, then perform the token
@@ -140,6 +179,29 @@ static NSString *const kRefreshTokenRequestException =
                             externalUserAgent:(id<OIDExternalUserAgent>)externalUserAgent
                                      callback:(OIDAuthStateAuthorizationCallback)callback;
 
+/*! @brief Decodes an auth state archived with @c NSKeyedArchiver using secure coding.
+    @param data The archived auth state.
+    @param error The error if the auth state could not be decoded.
+    @return The auth state, or nil if it could not be decoded.
+ */
++ (nullable OIDAuthState *)authStateFromArchivedData:(NSData *)data
+                                               error:(NSError **_Nullable)error;
+
+/*! @brief Decodes many auth states archived with @c NSKeyedArchiver, such as those of a
+        multi-account client at startup, concurrently on a bounded number of worker threads.
+    @param archivedData The securely archived auth states, by key.
+    @param maximumConcurrency The maximum number of auth states decoded at once, or 0 for the
+        number of active processors.
+    @param decodedHandler Called with each auth state as soon as it has been decoded, so that its
+        token can be used before the rest have been decoded. Called on a worker thread, so it must
+        be thread safe.
+    @param completion Called on the main queue once all archived data has been decoded.
+ */
++ (void)decodeAuthStatesFromArchivedData:(NSDictionary<NSString *, NSData *> *)archivedData
+                      maximumConcurrency:(NSUInteger)maximumConcurrency
+                          decodedHandler:(nullable OIDAuthStateDecodedHandler)decodedHandler
+                              completion:(OIDAuthStateBulkDecodingCompletion)completion;
+
 /*! @internal
     @brief Unavailable. Please use @c initWithAuthorizationResponse:.
  */
@@ -202,6 +264,14 @@ static NSString *const kRefreshTokenRequestException =
  */
 - (void)updateWithRegistrationResponse:(nullable OIDRegistrationResponse *)registrationResponse;
 
+/*! @brief Replaces the authorization state with a snapshot of another copy of the same
+        authorization.
+    @param snapshot The snapshot to adopt.
+    @discussion Typically called with the snapshot of a copy decoded from storage shared with
+        another process, when that process has refreshed the tokens.
+ */
+- (void)updateWithSnapshot:(OIDAuthStateSnapshot *)snapshot;
+
 /*! @brief Updates the authorization state based on an authorization error.
     @param authorizationError The authorization error.
     @discussion Call this method if you receive an authorization error during an API call to
@@ -221,8 +291,9 @@ static NSString *const kRefreshTokenRequestException =
         refresh was needed and failed, with the error that caused it to fail.
     @param action The block to execute with a fresh token. This block will be executed on the main
         thread.
+    @return A handle with which the action can be cancelled while it waits for a refresh.
  */
-- (void)performActionWithFreshTokens:(OIDAuthStateAction)action;
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action;
 
 /*! @brief Calls the block with a valid access token (refreshing it first, if needed), or if a
         refresh was needed and failed, with the error that caused it to fail.
@@ -230,9 +301,10 @@ static NSString *const kRefreshTokenRequestException =
         thread.
     @param additionalParameters Additional parameters for the token request if token is
         refreshed.
+    @return A handle with which the action can be cancelled while it waits for a refresh.
  */
-- (void)performActionWithFreshTokens:(OIDAuthStateAction)action
-         additionalRefreshParameters:
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
     (nullable NSDictionary<NSString *, NSString *> *)additionalParameters;
 
 /*! @brief Calls the block with a valid access token (refreshing it first, if needed), or if a
@@ -242,17 +314,67 @@ static NSString *const kRefreshTokenRequestException =
     @param additionalParameters Additional parameters for the token request if token is
         refreshed.
     @param dispatchQueue The dispatchQueue on which to dispatch the action block.
+    @return A handle with which the action can be cancelled while it waits for a refresh.
  */
-- (void)performActionWithFreshTokens:(OIDAuthStateAction)action
-         additionalRefreshParameters:
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                                   dispatchQueue:(dispatch_queue_t)dispatchQueue;
+
+/*! @brief Calls the block with a valid access token (refreshing it first, if needed), or if a
+        refresh was needed and failed, with the error that caused it to fail.
+    @param action The block to execute with a fresh token.
+    @param additionalParameters Additional parameters for the token request if token is
+        refreshed.
+    @param dispatchQueue The dispatchQueue on which to dispatch the action block.
+    @param timeout The time in seconds the action may wait for a refresh, or 0 for no deadline.
+    @return A handle with which the action can be cancelled while it waits for a refresh.
+    @discussion An action which is cancelled, or misses its deadline, is called right away with
+        an @c OIDErrorCodeNetworkError whose underlying error is @c NSURLErrorCancelled or
+        @c NSURLErrorTimedOut. The refresh itself is shared by every action waiting for it. Once
+        none of them waits for it any more, it is withdrawn if it still waits to be sent;
+        otherwise it completes, and the tokens it returns are stored.
+ */
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                                   dispatchQueue:(dispatch_queue_t)dispatchQueue
+                                         timeout:(NSTimeInterval)timeout;
+
+/*! @brief Calls the block with a valid access token (refreshing it first, if needed), or if a
+        refresh was needed and failed, with the error that caused it to fail.
+    @param action The block to execute with a fresh token.
+    @param additionalParameters Additional parameters for the token request if token is
+        refreshed.
+    @param dispatchQueue The dispatchQueue on which to dispatch the action block.
+    @param priority The priority class of the refresh, if one is needed. A refresh shared by
+        several actions runs at the highest priority of those waiting for it, so an interactive
+        action joining a background refresh raises its priority. The other methods use
+        @c OIDTokenRequestPriorityNormal.
+    @param timeout The time in seconds the action may wait for a refresh, or 0 for no deadline.
+    @return A handle with which the action can be cancelled while it waits for a refresh.
+ */
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
     (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
-                       dispatchQueue:(dispatch_queue_t)dispatchQueue;
+                                   dispatchQueue:(dispatch_queue_t)dispatchQueue
+                                        priority:(OIDTokenRequestPriority)priority
+                                         timeout:(NSTimeInterval)timeout;
 
 /*! @brief Forces a token refresh the next time @c OIDAuthState.performActionWithFreshTokens: is
         called, even if the current tokens are considered valid.
+    @discussion The @c stateChangeDelegate is notified, so that stored copies of the state, such
+        as an @c OIDSharedTokenCache, stop handing out the access token.
  */
 - (void)setNeedsTokenRefresh;
 
+/*! @brief Returns the access token if it can be used without refreshing it first.
+    @return The access token, or nil if it has expired, a refresh was forced with
+        @c OIDAuthState.setNeedsTokenRefresh, or there is none. In that case use
+        @c OIDAuthState.performActionWithFreshTokens: to obtain a fresh one.
+ */
+- (nullable NSString *)freshAccessToken;
+
 /*! @brief Creates a token request suitable for refreshing an access token.
     @return A @c OIDTokenRequest suitable for using a refresh token to obtain a new access token.
     @discussion After performing the refresh, call @c OIDAuthState.updateWithTokenResponse:error:
@@ -20,13 +20,18 @@
 
 #import "OIDAuthStateChangeDelegate.h"
 #import "OIDAuthStateErrorDelegate.h"
+#import "OIDAuthStateSnapshot.h"
 #import "OIDAuthorizationRequest.h"
 #import "OIDAuthorizationResponse.h"
 #import "OIDAuthorizationService.h"
+#import "OIDClock.h"
 #import "OIDDefines.h"
 #import "OIDError.h"
 #import "OIDErrorUtilities.h"
+#import "OIDMetrics.h"
+#import "OIDNetworkTask.h"
 #import "OIDRegistrationResponse.h"
+#import "OIDTokenRefreshRetryPolicy.h"
 #import "OIDTokenRequest.h"
 #import "OIDTokenResponse.h"
 #import "OIDTokenUtilities.h"
@@ -55,15 +60,13 @@ static NSString *const kLastTokenResponseKey = @"lastTokenResponse";
  */
 static NSString *const kAuthorizationErrorKey = @"authorizationError";
 
-/*! @brief Number of seconds the access token is refreshed before it actually expires.
- */
-static const NSUInteger kExpiryTimeTolerance = 60;
-
 /*! @brief Object to hold OIDAuthState pending actions.
  */
 @interface OIDAuthStatePendingAction : NSObject
 @property(nonatomic, readonly, nullable) OIDAuthStateAction action;
 @property(nonatomic, readonly, nullable) dispatch_queue_t dispatchQueue;
+@property(nonatomic, readonly) CFAbsoluteTime queuedTime;
+@property(nonatomic, strong) OIDNetworkTask *networkTask;
 @end
 @implementation OIDAuthStatePendingAction
 - (id)initWithAction:(OIDAuthStateAction)action andDispatchQueue:(dispatch_queue_t)dispatchQueue {
@@ -71,13 +74,40 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   if (self) {
     _action = action;
     _dispatchQueue = dispatchQueue;
+    _queuedTime = CFAbsoluteTimeGetCurrent();
   }
   return self;
 }
 @end
 
+/*! @brief Determines whether the tokens of a snapshot can be used without refreshing them first.
+    @param snapshot The snapshot, whose values are all read together.
+ */
+static BOOL OIDAuthStateSnapshotIsFresh(OIDAuthStateSnapshot *snapshot) {
+  if (snapshot.needsTokenRefresh) {
+    // forced refresh
+    return NO;
+  }
+
+  NSDate *accessTokenExpirationDate = snapshot.accessTokenExpirationDate;
+  if (!accessTokenExpirationDate) {
+    // if there is no expiration time but we have an access token, it is assumed to never expire
+    return !!snapshot.accessToken;
+  }
+
+  // has the token expired?
+  OIDClock *clock = [OIDClock sharedClock];
+  NSTimeInterval expiresIn = [accessTokenExpirationDate timeIntervalSinceDate:[clock now]];
+  BOOL tokenFresh = expiresIn > clock.accessTokenRefreshTolerance;
+  return tokenFresh;
+}
+
 @interface OIDAuthState ()
 
+/*! @brief The current state. Writers publish a new snapshot while synchronized on the receiver.
+ */
+@property(atomic, readwrite) OIDAuthStateSnapshot *snapshot;
+
 /*! @brief The access token generated by the authorization server.
     @discussion Rather than using this property directly, you should call
         @c OIDAuthState.withFreshTokenPerformAction:.
@@ -112,9 +142,15 @@ static const NSUInteger kExpiryTimeTolerance = 60;
    */
   id _pendingActionsSyncObject;
 
-  /*! @brief If YES, tokens will be refreshed on the next API call regardless of expiry.
+  /*! @brief The token refresh request the pending actions wait for, cancelled once none of them
+          waits for it any more (use @c _pendingActionsSyncObject to synchronize access).
+   */
+  OIDNetworkTask *_refreshTask;
+
+  /*! @brief The highest priority of the pending actions, at which their refresh is made (use
+          @c _pendingActionsSyncObject to synchronize access).
    */
-  BOOL _needsTokenRefresh;
+  OIDTokenRequestPriority _refreshPriority;
 }
 
 #pragma mark - Convenience initializers
@@ -171,6 +207,81 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   return authFlowSession;
 }
 
+#pragma mark - Bulk decoding
+
++ (nullable OIDAuthState *)authStateFromArchivedData:(NSData *)data
+                                               error:(NSError **_Nullable)error {
+  OIDAuthState *authState;
+  NSError *decodingError;
+  if (@available(iOS 11.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    authState = [NSKeyedUnarchiver unarchivedObjectOfClass:[OIDAuthState class]
+                                                  fromData:data
+                                                     error:&decodingError];
+  } else {
+#if !TARGET_OS_IOS
+    NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
+    unarchiver.requiresSecureCoding = YES;
+    unarchiver.decodingFailurePolicy = NSDecodingFailurePolicySetErrorAndReturn;
+    authState = [unarchiver decodeObjectOfClass:[OIDAuthState class]
+                                         forKey:NSKeyedArchiveRootObjectKey];
+    [unarchiver finishDecoding];
+    decodingError = unarchiver.error;
+#endif
+  }
+  if (!authState && error) {
+    *error = [OIDErrorUtilities errorWithCode:OIDErrorCodeAuthStateDecodingError
+                              underlyingError:decodingError
+                                  description:@"The archived auth state could not be decoded."];
+  }
+  return authState;
+}
+
++ (void)decodeAuthStatesFromArchivedData:(NSDictionary<NSString *, NSData *> *)archivedData
+                      maximumConcurrency:(NSUInteger)maximumConcurrency
+                          decodedHandler:(nullable OIDAuthStateDecodedHandler)decodedHandler
+                              completion:(OIDAuthStateBulkDecodingCompletion)completion {
+  NSArray<NSString *> *keys = archivedData.allKeys;
+  NSUInteger workerCount = maximumConcurrency ?: [NSProcessInfo processInfo].activeProcessorCount;
+  workerCount = MAX(1, MIN(workerCount, keys.count));
+
+  NSMutableDictionary<NSString *, OIDAuthState *> *authStates =
+      [NSMutableDictionary dictionaryWithCapacity:keys.count];
+  NSMutableDictionary<NSString *, NSError *> *errors = [NSMutableDictionary dictionary];
+  dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+  dispatch_group_t group = dispatch_group_create();
+  // Each worker decodes every workerCount-th archive, and merges its results once done so the
+  // workers only contend for the shared dictionaries once each.
+  for (NSUInteger worker = 0; worker < workerCount; worker++) {
+    dispatch_group_async(group, queue, ^{
+      NSMutableDictionary<NSString *, OIDAuthState *> *workerAuthStates =
+          [NSMutableDictionary dictionary];
+      NSMutableDictionary<NSString *, NSError *> *workerErrors = [NSMutableDictionary dictionary];
+      for (NSUInteger i = worker; i < keys.count; i += workerCount) {
+        @autoreleasepool {
+          NSString *key = keys[i];
+          NSError *error;
+          OIDAuthState *authState = [self authStateFromArchivedData:archivedData[key] error:&error];
+          if (!authState) {
+            workerErrors[key] = error;
+            continue;
+          }
+          workerAuthStates[key] = authState;
+          if (decodedHandler) {
+            decodedHandler(key, authState);
+          }
+        }
+      }
+      @synchronized(authStates) {
+        [authStates addEntriesFromDictionary:workerAuthStates];
+        [errors addEntriesFromDictionary:workerErrors];
+      }
+    });
+  }
+  dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+    completion([authStates copy], [errors copy]);
+  });
+}
+
 #pragma mark - Initializers
 
 - (nonnull instancetype)init
@@ -211,6 +322,13 @@ static const NSUInteger kExpiryTimeTolerance = 60;
   self = [super init];
   if (self) {
     _pendingActionsSyncObject = [[NSObject alloc] init];
+    _snapshot = [[OIDAuthStateSnapshot alloc] initWithRefreshToken:nil
+                                                             scope:nil
+                                         lastAuthorizationResponse:nil
+                                                 lastTokenResponse:nil
+                                          lastRegistrationResponse:nil
+                                                authorizationError:nil
+                                                 needsTokenRefresh:NO];
 
     if (registrationResponse) {
       [self updateWithRegistrationResponse:registrationResponse];
@@ -230,6 +348,7 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 #pragma mark - NSObject overrides
 
 - (NSString *)description {
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
   return [NSString stringWithFormat:@"<%@: %p, isAuthorized: %@, refreshToken: \"%@\", "
                                      "scope: \"%@\", accessToken: \"%@\", "
                                      "accessTokenExpirationDate: %@, idToken: \"%@\", "
@@ -237,16 +356,16 @@ static const NSUInteger kExpiryTimeTolerance = 60;
                                      "lastRegistrationResponse: %@, authorizationError: %@>",
                                     NSStringFromClass([self class]),
                                     (void *)self,
-                                    (self.isAuthorized) ? @"YES" : @"NO",
-                                    [OIDTokenUtilities redact:_refreshToken],
-                                    _scope,
-                                    [OIDTokenUtilities redact:self.accessToken],
-                                    self.accessTokenExpirationDate,
-                                    [OIDTokenUtilities redact:self.idToken],
-                                    _lastAuthorizationResponse,
-                                    _lastTokenResponse,
-                                    _lastRegistrationResponse,
-                                    _authorizationError];
+                                    (snapshot.isAuthorized) ? @"YES" : @"NO",
+                                    [OIDTokenUtilities redact:snapshot.refreshToken],
+                                    snapshot.scope,
+                                    [OIDTokenUtilities redact:snapshot.accessToken],
+                                    snapshot.accessTokenExpirationDate,
+                                    [OIDTokenUtilities redact:snapshot.idToken],
+                                    snapshot.lastAuthorizationResponse,
+                                    snapshot.lastTokenResponse,
+                                    snapshot.lastRegistrationResponse,
+                                    snapshot.authorizationError];
 }
 
 #pragma mark - NSSecureCoding
@@ -256,85 +375,117 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
-  _lastAuthorizationResponse = [aDecoder decodeObjectOfClass:[OIDAuthorizationResponse class]
-                                                      forKey:kLastAuthorizationResponseKey];
-  _lastTokenResponse = [aDecoder decodeObjectOfClass:[OIDTokenResponse class]
-                                              forKey:kLastTokenResponseKey];
-  self = [self initWithAuthorizationResponse:_lastAuthorizationResponse
-                               tokenResponse:_lastTokenResponse];
+  OIDAuthorizationResponse *lastAuthorizationResponse =
+      [aDecoder decodeObjectOfClass:[OIDAuthorizationResponse class]
+                             forKey:kLastAuthorizationResponseKey];
+  OIDTokenResponse *lastTokenResponse = [aDecoder decodeObjectOfClass:[OIDTokenResponse class]
+                                                               forKey:kLastTokenResponseKey];
+  self = [self initWithAuthorizationResponse:lastAuthorizationResponse
+                               tokenResponse:lastTokenResponse];
   if (self) {
-    _authorizationError =
-        [aDecoder decodeObjectOfClass:[NSError class] forKey:kAuthorizationErrorKey];
-    _scope = [aDecoder decodeObjectOfClass:[NSString class] forKey:kScopeKey];
-    _refreshToken = [aDecoder decodeObjectOfClass:[NSString class] forKey:kRefreshTokenKey];
-    _needsTokenRefresh = [aDecoder decodeBoolForKey:kNeedsTokenRefreshKey];
+    OIDAuthStateSnapshot *snapshot = self.snapshot;
+    _snapshot = [[OIDAuthStateSnapshot alloc]
+        initWithRefreshToken:[aDecoder decodeObjectOfClass:[NSString class]
+                                                    forKey:kRefreshTokenKey]
+                       scope:[aDecoder decodeObjectOfClass:[NSString class] forKey:kScopeKey]
+   lastAuthorizationResponse:snapshot.lastAuthorizationResponse
+           lastTokenResponse:snapshot.lastTokenResponse
+    lastRegistrationResponse:snapshot.lastRegistrationResponse
+          authorizationError:[aDecoder decodeObjectOfClass:[NSError class]
+                                                    forKey:kAuthorizationErrorKey]
+           needsTokenRefresh:[aDecoder decodeBoolForKey:kNeedsTokenRefreshKey]];
   }
   return self;
 }
 
 - (void)encodeWithCoder:(NSCoder *)aCoder {
-  [aCoder encodeObject:_lastAuthorizationResponse forKey:kLastAuthorizationResponseKey];
-  [aCoder encodeObject:_lastTokenResponse forKey:kLastTokenResponseKey];
-  if (_authorizationError) {
-    NSError *codingSafeAuthorizationError = [NSError errorWithDomain:_authorizationError.domain
-                                                                code:_authorizationError.code
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
+  [aCoder encodeObject:snapshot.lastAuthorizationResponse forKey:kLastAuthorizationResponseKey];
+  [aCoder encodeObject:snapshot.lastTokenResponse forKey:kLastTokenResponseKey];
+  NSError *authorizationError = snapshot.authorizationError;
+  if (authorizationError) {
+    NSError *codingSafeAuthorizationError = [NSError errorWithDomain:authorizationError.domain
+                                                                code:authorizationError.code
                                                             userInfo:nil];
     [aCoder encodeObject:codingSafeAuthorizationError forKey:kAuthorizationErrorKey];
   }
-  [aCoder encodeObject:_scope forKey:kScopeKey];
-  [aCoder encodeObject:_refreshToken forKey:kRefreshTokenKey];
-  [aCoder encodeBool:_needsTokenRefresh forKey:kNeedsTokenRefreshKey];
+  [aCoder encodeObject:snapshot.scope forKey:kScopeKey];
+  [aCoder encodeObject:snapshot.refreshToken forKey:kRefreshTokenKey];
+  [aCoder encodeBool:snapshot.needsTokenRefresh forKey:kNeedsTokenRefreshKey];
 }
 
 #pragma mark - Private convenience getters
 
 - (NSString *)accessToken {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.accessToken
-                            : _lastAuthorizationResponse.accessToken;
+  return self.snapshot.accessToken;
 }
 
 - (NSString *)tokenType {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.tokenType
-                            : _lastAuthorizationResponse.tokenType;
+  return self.snapshot.tokenType;
 }
 
 - (NSDate *)accessTokenExpirationDate {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.accessTokenExpirationDate
-                            : _lastAuthorizationResponse.accessTokenExpirationDate;
+  return self.snapshot.accessTokenExpirationDate;
 }
 
 - (NSString *)idToken {
-  if (_authorizationError) {
-    return nil;
-  }
-  return _lastTokenResponse ? _lastTokenResponse.idToken
-                            : _lastAuthorizationResponse.idToken;
+  return self.snapshot.idToken;
 }
 
 #pragma mark - Getters
 
+- (nullable NSString *)refreshToken {
+  return self.snapshot.refreshToken;
+}
+
+- (nullable NSString *)scope {
+  return self.snapshot.scope;
+}
+
+- (OIDAuthorizationResponse *)lastAuthorizationResponse {
+  return self.snapshot.lastAuthorizationResponse;
+}
+
+- (nullable OIDTokenResponse *)lastTokenResponse {
+  return self.snapshot.lastTokenResponse;
+}
+
+- (nullable OIDRegistrationResponse *)lastRegistrationResponse {
+  return self.snapshot.lastRegistrationResponse;
+}
+
+- (nullable NSError *)authorizationError {
+  return self.snapshot.authorizationError;
+}
+
 - (BOOL)isAuthorized {
-  return !self.authorizationError && (self.accessToken || self.idToken || self.refreshToken);
+  return self.snapshot.isAuthorized;
 }
 
 #pragma mark - Updating the state
 
+/*! @brief Publishes a new snapshot of the state.
+    @param update Returns the new snapshot, given the current one.
+    @discussion Writers are serialized by synchronizing on the receiver so that no update is lost.
+        Readers only load the snapshot pointer, so they never wait for writers and never observe a
+        partially applied update.
+ */
+- (void)updateSnapshot:(OIDAuthStateSnapshot *(^)(OIDAuthStateSnapshot *snapshot))update {
+  @synchronized(self) {
+    self.snapshot = update(self.snapshot);
+  }
+}
+
 - (void)updateWithRegistrationResponse:(OIDRegistrationResponse *)registrationResponse {
-  _lastRegistrationResponse = registrationResponse;
-  _refreshToken = nil;
-  _scope = nil;
-  _lastAuthorizationResponse = nil;
-  _lastTokenResponse = nil;
-  _authorizationError = nil;
+  [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *snapshot) {
+    return [[OIDAuthStateSnapshot alloc] initWithRefreshToken:nil
+                                                        scope:nil
+                                    lastAuthorizationResponse:nil
+                                            lastTokenResponse:nil
+                                     lastRegistrationResponse:registrationResponse
+                                           authorizationError:nil
+                                            needsTokenRefresh:snapshot.needsTokenRefresh];
+  }];
   [self didChangeState];
 }
 
@@ -349,63 +500,114 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     return;
   }
 
-  _lastAuthorizationResponse = authorizationResponse;
-
   // clears the last token response and refresh token as these now relate to an old authorization
-  // that is no longer relevant
-  _lastTokenResponse = nil;
-  _refreshToken = nil;
-  _authorizationError = nil;
-
+  // that is no longer relevant.
   // if the response's scope is nil, it means that it equals that of the request
   // see: https://tools.ietf.org/html/rfc6749#section-5.1
-  _scope = (authorizationResponse.scope) ? authorizationResponse.scope
-                                         : authorizationResponse.request.scope;
+  NSString *scope = (authorizationResponse.scope) ? authorizationResponse.scope
+                                                  : authorizationResponse.request.scope;
+  [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *snapshot) {
+    return [[OIDAuthStateSnapshot alloc] initWithRefreshToken:nil
+                                                        scope:scope
+                                    lastAuthorizationResponse:authorizationResponse
+                                            lastTokenResponse:nil
+                                     lastRegistrationResponse:snapshot.lastRegistrationResponse
+                                           authorizationError:nil
+                                            needsTokenRefresh:snapshot.needsTokenRefresh];
+  }];
 
   [self didChangeState];
 }
 
 - (void)updateWithTokenResponse:(nullable OIDTokenResponse *)tokenResponse
                           error:(nullable NSError *)error {
-  if (_authorizationError) {
+  [self updateWithTokenResponse:tokenResponse error:error clearingNeedsTokenRefresh:NO];
+}
+
+/*! @brief Updates the state based on a new token response, in a single update of the snapshot.
+    @param clearNeedsTokenRefresh Whether a forced refresh is no longer needed, when the token
+        response or error results from a refresh.
+ */
+- (void)updateWithTokenResponse:(nullable OIDTokenResponse *)tokenResponse
+                          error:(nullable NSError *)error
+      clearingNeedsTokenRefresh:(BOOL)clearNeedsTokenRefresh {
+  NSError *authorizationError = self.authorizationError;
+  if (authorizationError) {
     // Calling updateWithTokenResponse while in an error state probably means the developer obtained
     // a new token and did the exchange without also calling updateWithAuthorizationResponse.
     // Attempts to handle gracefully, but warns the developer that this is unexpected.
     NSLog(@"OIDAuthState:updateWithTokenResponse should not be called in an error state [%@] call"
          "updateWithAuthorizationResponse with the result of the fresh authorization response"
          "first",
-         _authorizationError);
-
-    _authorizationError = nil;
+         authorizationError);
   }
 
   // If the error is an OAuth authorization error, updates the state. Other errors are ignored.
   if (error.domain == OIDOAuthTokenErrorDomain) {
-    [self updateWithAuthorizationError:error];
+    [self updateWithAuthorizationError:error clearingNeedsTokenRefresh:clearNeedsTokenRefresh];
     return;
   }
   if (!tokenResponse) {
+    if (authorizationError) {
+      [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *snapshot) {
+        return [[OIDAuthStateSnapshot alloc]
+            initWithRefreshToken:snapshot.refreshToken
+                           scope:snapshot.scope
+       lastAuthorizationResponse:snapshot.lastAuthorizationResponse
+               lastTokenResponse:snapshot.lastTokenResponse
+        lastRegistrationResponse:snapshot.lastRegistrationResponse
+              authorizationError:nil
+               needsTokenRefresh:snapshot.needsTokenRefresh];
+      }];
+    }
     return;
   }
 
-  _lastTokenResponse = tokenResponse;
-
   // updates the scope and refresh token if they are present on the TokenResponse.
   // according to the spec, these may be changed by the server, including when refreshing the
   // access token. See: https://tools.ietf.org/html/rfc6749#section-5.1 and
   // https://tools.ietf.org/html/rfc6749#section-6
-  if (tokenResponse.scope) {
-    _scope = tokenResponse.scope;
-  }
-  if (tokenResponse.refreshToken) {
-    _refreshToken = tokenResponse.refreshToken;
-  }
+  [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *snapshot) {
+    return [[OIDAuthStateSnapshot alloc]
+        initWithRefreshToken:tokenResponse.refreshToken ?: snapshot.refreshToken
+                       scope:tokenResponse.scope ?: snapshot.scope
+   lastAuthorizationResponse:snapshot.lastAuthorizationResponse
+           lastTokenResponse:tokenResponse
+    lastRegistrationResponse:snapshot.lastRegistrationResponse
+          authorizationError:nil
+           needsTokenRefresh:snapshot.needsTokenRefresh && !clearNeedsTokenRefresh];
+  }];
 
   [self didChangeState];
 }
 
+- (void)updateWithSnapshot:(OIDAuthStateSnapshot *)snapshot {
+  [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *currentSnapshot) {
+    return snapshot;
+  }];
+  [self didChangeState];
+}
+
 - (void)updateWithAuthorizationError:(NSError *)oauthError {
-  _authorizationError = oauthError;
+  [self updateWithAuthorizationError:oauthError clearingNeedsTokenRefresh:NO];
+}
+
+/*! @brief Updates the state based on an authorization error, in a single update of the snapshot.
+    @param clearNeedsTokenRefresh Whether a forced refresh is no longer needed, when the error
+        results from a refresh.
+ */
+- (void)updateWithAuthorizationError:(NSError *)oauthError
+           clearingNeedsTokenRefresh:(BOOL)clearNeedsTokenRefresh {
+  [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *snapshot) {
+    return [[OIDAuthStateSnapshot alloc]
+        initWithRefreshToken:snapshot.refreshToken
+                       scope:snapshot.scope
+   lastAuthorizationResponse:snapshot.lastAuthorizationResponse
+           lastTokenResponse:snapshot.lastTokenResponse
+    lastRegistrationResponse:snapshot.lastRegistrationResponse
+          authorizationError:oauthError
+           needsTokenRefresh:snapshot.needsTokenRefresh && !clearNeedsTokenRefresh];
+  }];
 
   [self didChangeState];
 
@@ -421,18 +623,20 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 - (OIDTokenRequest *)tokenRefreshRequestWithAdditionalParameters:
     (NSDictionary<NSString *, NSString *> *)additionalParameters {
 
-  if (!_refreshToken) {
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
+  if (!snapshot.refreshToken) {
     [OIDErrorUtilities raiseException:kRefreshTokenRequestException];
   }
+  OIDAuthorizationRequest *authorizationRequest = snapshot.lastAuthorizationResponse.request;
   return [[OIDTokenRequest alloc]
-      initWithConfiguration:_lastAuthorizationResponse.request.configuration
+      initWithConfiguration:authorizationRequest.configuration
                   grantType:OIDGrantTypeRefreshToken
           authorizationCode:nil
                 redirectURL:nil
-                   clientID:_lastAuthorizationResponse.request.clientID
-               clientSecret:_lastAuthorizationResponse.request.clientSecret
+                   clientID:authorizationRequest.clientID
+               clientSecret:authorizationRequest.clientSecret
                       scope:nil
-               refreshToken:_refreshToken
+               refreshToken:snapshot.refreshToken
                codeVerifier:nil
        additionalParameters:additionalParameters
           additionalHeaders:nil];
@@ -443,18 +647,20 @@ static const NSUInteger kExpiryTimeTolerance = 60;
                                                additionalHeaders:
     (NSDictionary<NSString *,NSString *> *)additionalHeaders {
 
-  if (!_refreshToken) {
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
+  if (!snapshot.refreshToken) {
     [OIDErrorUtilities raiseException:kRefreshTokenRequestException];
   }
+  OIDAuthorizationRequest *authorizationRequest = snapshot.lastAuthorizationResponse.request;
   return [[OIDTokenRequest alloc]
-      initWithConfiguration:_lastAuthorizationResponse.request.configuration
+      initWithConfiguration:authorizationRequest.configuration
                   grantType:OIDGrantTypeRefreshToken
           authorizationCode:nil
                 redirectURL:nil
-                   clientID:_lastAuthorizationResponse.request.clientID
-               clientSecret:_lastAuthorizationResponse.request.clientSecret
+                   clientID:authorizationRequest.clientID
+               clientSecret:authorizationRequest.clientSecret
                       scope:nil
-               refreshToken:_refreshToken
+               refreshToken:snapshot.refreshToken
                codeVerifier:nil
        additionalParameters:additionalParameters
           additionalHeaders:additionalHeaders];
@@ -463,18 +669,20 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 - (OIDTokenRequest *)tokenRefreshRequestWithAdditionalHeaders:
     (NSDictionary<NSString *, NSString *> *)additionalHeaders {
 
-  if (!_refreshToken) {
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
+  if (!snapshot.refreshToken) {
     [OIDErrorUtilities raiseException:kRefreshTokenRequestException];
   }
+  OIDAuthorizationRequest *authorizationRequest = snapshot.lastAuthorizationResponse.request;
   return [[OIDTokenRequest alloc]
-      initWithConfiguration:_lastAuthorizationResponse.request.configuration
+      initWithConfiguration:authorizationRequest.configuration
                   grantType:OIDGrantTypeRefreshToken
           authorizationCode:nil
                 redirectURL:nil
-                   clientID:_lastAuthorizationResponse.request.clientID
-               clientSecret:_lastAuthorizationResponse.request.clientSecret
+                   clientID:authorizationRequest.clientID
+               clientSecret:authorizationRequest.clientSecret
                       scope:nil
-               refreshToken:_refreshToken
+               refreshToken:snapshot.refreshToken
                codeVerifier:nil
        additionalParameters:nil
           additionalHeaders:additionalHeaders];
@@ -487,35 +695,75 @@ static const NSUInteger kExpiryTimeTolerance = 60;
 }
 
 - (void)setNeedsTokenRefresh {
-  _needsTokenRefresh = YES;
+  [self updateSnapshot:^OIDAuthStateSnapshot *(OIDAuthStateSnapshot *snapshot) {
+    return [[OIDAuthStateSnapshot alloc]
+        initWithRefreshToken:snapshot.refreshToken
+                       scope:snapshot.scope
+   lastAuthorizationResponse:snapshot.lastAuthorizationResponse
+           lastTokenResponse:snapshot.lastTokenResponse
+    lastRegistrationResponse:snapshot.lastRegistrationResponse
+          authorizationError:snapshot.authorizationError
+           needsTokenRefresh:YES];
+  }];
+  [self didChangeState];
+}
+
+- (nullable NSString *)freshAccessToken {
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
+  return OIDAuthStateSnapshotIsFresh(snapshot) ? snapshot.accessToken : nil;
 }
 
-- (void)performActionWithFreshTokens:(OIDAuthStateAction)action {
-  [self performActionWithFreshTokens:action additionalRefreshParameters:nil];
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action {
+  return [self performActionWithFreshTokens:action additionalRefreshParameters:nil];
 }
 
-- (void)performActionWithFreshTokens:(OIDAuthStateAction)action
-         additionalRefreshParameters:
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
     (nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
-  [self performActionWithFreshTokens:action
-         additionalRefreshParameters:additionalParameters
-                       dispatchQueue:dispatch_get_main_queue()];
+  return [self performActionWithFreshTokens:action
+                additionalRefreshParameters:additionalParameters
+                              dispatchQueue:dispatch_get_main_queue()];
 }
 
-- (void)performActionWithFreshTokens:(OIDAuthStateAction)action
-         additionalRefreshParameters:
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
     (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
-                       dispatchQueue:(dispatch_queue_t)dispatchQueue {
+                                   dispatchQueue:(dispatch_queue_t)dispatchQueue {
+  return [self performActionWithFreshTokens:action
+                additionalRefreshParameters:additionalParameters
+                              dispatchQueue:dispatchQueue
+                                    timeout:0];
+}
 
-  if ([self isTokenFresh]) {
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                                   dispatchQueue:(dispatch_queue_t)dispatchQueue
+                                         timeout:(NSTimeInterval)timeout {
+  return [self performActionWithFreshTokens:action
+                additionalRefreshParameters:additionalParameters
+                              dispatchQueue:dispatchQueue
+                                   priority:OIDTokenRequestPriorityNormal
+                                    timeout:timeout];
+}
+
+- (OIDNetworkTask *)performActionWithFreshTokens:(OIDAuthStateAction)action
+                     additionalRefreshParameters:
+    (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                                   dispatchQueue:(dispatch_queue_t)dispatchQueue
+                                        priority:(OIDTokenRequestPriority)priority
+                                         timeout:(NSTimeInterval)timeout {
+
+  OIDAuthStateSnapshot *snapshot = self.snapshot;
+  if (OIDAuthStateSnapshotIsFresh(snapshot)) {
     // access token is valid within tolerance levels, perform action
     dispatch_async(dispatchQueue, ^{
-      action(self.accessToken, self.idToken, nil);
+      action(snapshot.accessToken, snapshot.idToken, nil);
     });
-    return;
+    return [OIDNetworkTask finishedTask];
   }
 
-  if (!_refreshToken) {
+  if (!snapshot.refreshToken) {
     // no refresh token available and token has expired
     NSError *tokenRefreshError = [
       OIDErrorUtilities errorWithCode:OIDErrorCodeTokenRefreshError
@@ -524,39 +772,137 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     dispatch_async(dispatchQueue, ^{
         action(nil, nil, tokenRefreshError);
     });
-    return;
+    return [OIDNetworkTask finishedTask];
   }
 
   // access token is expired, first refresh the token, then perform action
   NSAssert(_pendingActionsSyncObject, @"_pendingActionsSyncObject cannot be nil", @"");
   OIDAuthStatePendingAction* pendingAction =
       [[OIDAuthStatePendingAction alloc] initWithAction:action andDispatchQueue:dispatchQueue];
+  pendingAction.networkTask =
+      [[OIDNetworkTask alloc] initWithTimeout:timeout cancellationHandler:^(NSError *error) {
+    // stops waiting for the refresh, and withdraws it if no other action waits for it and it was
+    // not sent yet. A sent refresh completes without actions, so that its tokens are stored.
+    @synchronized(self->_pendingActionsSyncObject) {
+      [self->_pendingActions removeObjectIdenticalTo:pendingAction];
+      if (self->_pendingActions && !self->_pendingActions.count &&
+          [self->_refreshTask cancelUnlessSent]) {
+        self->_pendingActions = nil;
+        self->_refreshTask = nil;
+      }
+    }
+    dispatch_async(dispatchQueue, ^{
+      action(nil, nil, error);
+    });
+  }];
+  OIDNetworkTask *networkTask = pendingAction.networkTask;
+  id<OIDMetricsObserver> metricsObserver = [OIDMetrics observer];
+  NSMutableArray *refreshingActions;
+  OIDNetworkTask *raisedRefreshTask;
   @synchronized(_pendingActionsSyncObject) {
     // if a token is already in the process of being refreshed, adds to pending actions
     if (_pendingActions) {
       [_pendingActions addObject:pendingAction];
-      return;
+      if ([metricsObserver respondsToSelector:@selector(pendingActionQueuedWithDepth:)]) {
+        [metricsObserver pendingActionQueuedWithDepth:_pendingActions.count];
+      }
+      // lower values are higher priorities
+      if (priority < _refreshPriority) {
+        _refreshPriority = priority;
+        raisedRefreshTask = _refreshTask;
+      }
+    } else {
+      // creates a list of pending actions, starting with this one
+      _pendingActions = [NSMutableArray arrayWithObject:pendingAction];
+      _refreshPriority = priority;
+      refreshingActions = _pendingActions;
     }
-
-    // creates a list of pending actions, starting with this one
-    _pendingActions = [NSMutableArray arrayWithObject:pendingAction];
+  }
+  if (!refreshingActions) {
+    [raisedRefreshTask raisePriority:priority];
+    return networkTask;
+  }
+  if ([metricsObserver respondsToSelector:@selector(pendingActionQueuedWithDepth:)]) {
+    [metricsObserver pendingActionQueuedWithDepth:1];
   }
 
   // refresh the tokens
+  [self performTokenRefreshWithAdditionalParameters:additionalParameters
+                                            attempt:1
+                                  refreshingActions:refreshingActions];
+  return networkTask;
+}
+
+/*! @brief Performs an attempt to refresh the tokens, then processes the pending actions unless the
+        attempt is retried.
+    @param additionalParameters Additional parameters for the token refresh request. The request
+        is built for each attempt, so that a retry uses the refresh token current at that time,
+        which may have been rotated since the previous attempt.
+    @param attempt The number of the attempt, starting at 1.
+    @param refreshingActions The pending actions the refresh was started for. Once they were all
+        cancelled before the request was sent, @c _pendingActions no longer refers to them, and
+        the refresh is abandoned.
+ */
+- (void)performTokenRefreshWithAdditionalParameters:
+            (nullable NSDictionary<NSString *, NSString *> *)additionalParameters
+                                            attempt:(NSUInteger)attempt
+                                  refreshingActions:(NSMutableArray *)refreshingActions {
+  OIDTokenRequestPriority priority;
+  @synchronized(_pendingActionsSyncObject) {
+    if (_pendingActions != refreshingActions) {
+      return;
+    }
+    if (!_pendingActions.count) {
+      // every action was cancelled while the retry was scheduled
+      _pendingActions = nil;
+      _refreshTask = nil;
+      return;
+    }
+    priority = _refreshPriority;
+  }
   OIDTokenRequest *tokenRefreshRequest =
       [self tokenRefreshRequestWithAdditionalParameters:additionalParameters];
-  [OIDAuthorizationService performTokenRequest:tokenRefreshRequest
-                 originalAuthorizationResponse:_lastAuthorizationResponse
-                                      callback:^(OIDTokenResponse *_Nullable response,
-                                                 NSError *_Nullable error) {
-    // update OIDAuthState based on response
+  id<OIDMetricsObserver> metricsObserver = [OIDMetrics observer];
+  OIDNetworkTask *refreshTask =
+      [OIDAuthorizationService performTokenRequest:tokenRefreshRequest
+                     originalAuthorizationResponse:self.lastAuthorizationResponse
+                                          priority:priority
+                                           timeout:0
+                                          callback:^(OIDTokenResponse *_Nullable response,
+                                                     NSError *_Nullable error) {
+    BOOL abandoned;
+    @synchronized(self->_pendingActionsSyncObject) {
+      abandoned = self->_pendingActions != refreshingActions;
+    }
+    if (!response && abandoned) {
+      // withdrawn before it was sent, along with every action waiting for it
+      return;
+    }
+
+    // retry transient errors according to the retry policy, keeping the actions queued
+    OIDTokenRefreshRetryPolicy *retryPolicy = self->_refreshRetryPolicy;
+    NSTimeInterval retryDelay = 0;
+    if (!response &&
+        [retryPolicy shouldRetryAttempt:attempt afterError:error delay:&retryDelay]) {
+      if ([metricsObserver respondsToSelector:@selector(tokenRefreshWillRetryAfterError:)]) {
+        [metricsObserver tokenRefreshWillRetryAfterError:error];
+      }
+      retryPolicy.scheduler(retryDelay, ^{
+        [self performTokenRefreshWithAdditionalParameters:additionalParameters
+                                                  attempt:attempt + 1
+                                        refreshingActions:refreshingActions];
+      });
+      return;
+    }
+
+    // update OIDAuthState based on response, clearing any forced refresh in the same update so
+    // that readers never see the old tokens as fresh. A response is kept even when every action
+    // was cancelled, as the server may have rotated the refresh token.
     if (response) {
-      self->_needsTokenRefresh = NO;
-      [self updateWithTokenResponse:response error:nil];
+      [self updateWithTokenResponse:response error:nil clearingNeedsTokenRefresh:YES];
     } else {
       if (error.domain == OIDOAuthTokenErrorDomain) {
-        self->_needsTokenRefresh = NO;
-        [self updateWithAuthorizationError:error];
+        [self updateWithAuthorizationError:error clearingNeedsTokenRefresh:YES];
       } else {
         if ([self->_errorDelegate respondsToSelector:
             @selector(authState:didEncounterTransientError:)]) {
@@ -565,18 +911,52 @@ static const NSUInteger kExpiryTimeTolerance = 60;
       }
     }
 
+    if ([metricsObserver respondsToSelector:@selector(tokenRefreshDidCompleteWithError:)]) {
+      [metricsObserver tokenRefreshDidCompleteWithError:error];
+    }
+
     // nil the pending queue and process everything that was queued up
     NSArray *actionsToProcess;
     @synchronized(self->_pendingActionsSyncObject) {
-      actionsToProcess = self->_pendingActions;
-      self->_pendingActions = nil;
+      if (self->_pendingActions == refreshingActions) {
+        actionsToProcess = self->_pendingActions;
+        self->_pendingActions = nil;
+        self->_refreshTask = nil;
+      }
     }
+    BOOL recordsWait =
+        [metricsObserver respondsToSelector:@selector(pendingActionDispatchedAfterWaiting:)];
+    CFAbsoluteTime dispatchTime = CFAbsoluteTimeGetCurrent();
     for (OIDAuthStatePendingAction* actionToProcess in actionsToProcess) {
+      if (![actionToProcess.networkTask finish]) {
+        // cancelled, and already called with the cancellation error
+        continue;
+      }
+      if (recordsWait) {
+        [metricsObserver
+            pendingActionDispatchedAfterWaiting:dispatchTime - actionToProcess.queuedTime];
+      }
+      OIDAuthStateSnapshot *refreshedSnapshot = self.snapshot;
       dispatch_async(actionToProcess.dispatchQueue, ^{
-        actionToProcess.action(self.accessToken, self.idToken, error);
+        actionToProcess.action(refreshedSnapshot.accessToken, refreshedSnapshot.idToken, error);
       });
     }
   }];
+  @synchronized(_pendingActionsSyncObject) {
+    if (_pendingActions != refreshingActions) {
+      // the refresh already completed
+      return;
+    }
+    if (!_pendingActions.count && [refreshTask cancelUnlessSent]) {
+      // every action was cancelled while the request was being scheduled
+      _pendingActions = nil;
+      return;
+    }
+    _refreshTask = refreshTask;
+    priority = _refreshPriority;
+  }
+  // catches up with actions of a higher priority which joined while the request was being sent
+  [refreshTask raisePriority:priority];
 }
 
 #pragma mark -
@@ -585,19 +965,7 @@ static const NSUInteger kExpiryTimeTolerance = 60;
     @brief Determines whether a token refresh request must be made to refresh the tokens.
  */
 - (BOOL)isTokenFresh {
-  if (_needsTokenRefresh) {
-    // forced refresh
-    return NO;
-  }
-
-  if (!self.accessTokenExpirationDate) {
-    // if there is no expiration time but we have an access token, it is assumed to never expire
-    return !!self.accessToken;
-  }
-
-  // has the token expired?
-  BOOL tokenFresh = [self.accessTokenExpirationDate timeIntervalSinceNow] > kExpiryTimeTolerance;
-  return tokenFresh;
+  return OIDAuthStateSnapshotIsFresh(self.snapshot);
 }
 
 @end
@@ -0,0 +1,107 @@
+/*! @file OIDAuthStateRegistry.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDAuthState;
+@class OIDServiceConfiguration;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The type of block called when the refreshes started by
+        @c OIDAuthStateRegistry.refreshAuthStatesExpiringWithin:completion: have all completed.
+    @param errors The errors of the refreshes which failed, by account ID.
+ */
+typedef void (^OIDAuthStateRegistryRefreshCompletion)(NSDictionary<NSString *, NSError *> *errors);
+
+/*! @brief Holds the @c OIDAuthState of many accounts, possibly across several issuers, and
+        schedules their token refreshes.
+    @discussion Accounts are looked up by account ID or by the subject of their ID Token in constant
+        time. Accounts of the same issuer share a single @c OIDServiceConfiguration, returned by
+        @c configurationForAccountID:. Refreshes are started soonest expiry first, with at most
+        @c maximumConcurrentRefreshesPerIssuer in flight for each issuer, so refreshing many
+        accounts neither floods one issuer nor delays the accounts closest to expiry. All methods
+        are thread safe.
+ */
+@interface OIDAuthStateRegistry : NSObject
+
+/*! @brief The maximum number of token refreshes in flight for each issuer.
+ */
+@property(nonatomic, readonly) NSUInteger maximumConcurrentRefreshesPerIssuer;
+
+/*! @brief The number of accounts in the registry.
+ */
+@property(nonatomic, readonly) NSUInteger count;
+
+/*! @brief The IDs of the accounts in the registry, in no particular order.
+ */
+@property(nonatomic, readonly) NSArray<NSString *> *accountIDs;
+
+/*! @brief Creates a registry which refreshes at most two accounts of each issuer at a time.
+ */
+- (instancetype)init;
+
+/*! @brief Designated initializer.
+    @param maximumConcurrentRefreshesPerIssuer The maximum number of token refreshes in flight for
+        each issuer. Values below 1 are treated as 1.
+ */
+- (instancetype)initWithMaximumConcurrentRefreshesPerIssuer:
+    (NSUInteger)maximumConcurrentRefreshesPerIssuer NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Adds an account, replacing any account with the same ID.
+    @param authState The authorization state of the account.
+    @param accountID The ID of the account.
+    @discussion The account is indexed by the subject of its current ID Token, if it has one.
+ */
+- (void)setAuthState:(OIDAuthState *)authState forAccountID:(NSString *)accountID;
+
+/*! @brief Removes an account.
+    @param accountID The ID of the account.
+ */
+- (void)removeAuthStateForAccountID:(NSString *)accountID;
+
+/*! @brief Returns the authorization state of an account.
+    @param accountID The ID of the account.
+ */
+- (nullable OIDAuthState *)authStateForAccountID:(NSString *)accountID;
+
+/*! @brief Returns the IDs of the accounts whose ID Token had a subject when they were added.
+    @param subject The subject of the ID Token.
+ */
+- (NSArray<NSString *> *)accountIDsForSubject:(NSString *)subject;
+
+/*! @brief Returns the configuration shared by the accounts of the same issuer as an account.
+    @param accountID The ID of the account.
+    @return The configuration of the first account added for the issuer, or nil if the account is
+        unknown or has no configuration.
+ */
+- (nullable OIDServiceConfiguration *)configurationForAccountID:(NSString *)accountID;
+
+/*! @brief Refreshes the tokens of every account whose access token expires within an interval, or
+        whose refresh was forced with @c OIDAuthState.setNeedsTokenRefresh.
+    @param interval The interval from now, in seconds.
+    @param completion Called on the main queue once all the refreshes have completed.
+    @discussion Accounts without a refresh token, and accounts already being refreshed by the
+        registry, are skipped. The refreshes are made at @c OIDTokenRequestPriorityBackground.
+ */
+- (void)refreshAuthStatesExpiringWithin:(NSTimeInterval)interval
+                             completion:(OIDAuthStateRegistryRefreshCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
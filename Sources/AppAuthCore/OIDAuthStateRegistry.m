@@ -0,0 +1,337 @@
+/*! @file OIDAuthStateRegistry.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDAuthStateRegistry.h"
+
+#import "OIDAuthState.h"
+#import "OIDAuthStateSnapshot.h"
+#import "OIDAuthorizationRequest.h"
+#import "OIDAuthorizationResponse.h"
+#import "OIDCircuitBreaker.h"
+#import "OIDClock.h"
+#import "OIDIDToken.h"
+#import "OIDServiceConfiguration.h"
+
+/*! @brief The default maximum number of token refreshes in flight for each issuer.
+ */
+static NSUInteger const kDefaultMaximumConcurrentRefreshesPerIssuer = 2;
+
+/*! @brief An account of the registry.
+ */
+@interface OIDAuthStateRegistryAccount : NSObject
+
+/*! @brief The authorization state of the account.
+ */
+@property(nonatomic, strong) OIDAuthState *authState;
+
+/*! @brief The key of the issuer of the account, if it has a configuration.
+ */
+@property(nonatomic, copy, nullable) NSString *issuerKey;
+
+/*! @brief The subject the account is indexed by, if any.
+ */
+@property(nonatomic, copy, nullable) NSString *subject;
+
+@end
+
+@implementation OIDAuthStateRegistryAccount
+@end
+
+/*! @brief A token refresh scheduled by the registry.
+ */
+@interface OIDAuthStateRegistryRefresh : NSObject
+
+/*! @brief The ID of the account to refresh.
+ */
+@property(nonatomic, copy) NSString *accountID;
+
+/*! @brief The authorization state to refresh.
+ */
+@property(nonatomic, strong) OIDAuthState *authState;
+
+/*! @brief The expiration date of the access token when the refresh was scheduled, if any.
+ */
+@property(nonatomic, strong, nullable) NSDate *expirationDate;
+
+/*! @brief Called with the error of the refresh, or nil if it succeeded.
+ */
+@property(nonatomic, copy) void (^completion)(NSError *_Nullable error);
+
+@end
+
+@implementation OIDAuthStateRegistryRefresh
+@end
+
+@implementation OIDAuthStateRegistry {
+  /*! @brief The accounts by account ID. Guarded by @synchronized on self.
+   */
+  NSMutableDictionary<NSString *, OIDAuthStateRegistryAccount *> *_accounts;
+
+  /*! @brief The account IDs by subject. Guarded by @synchronized on self.
+   */
+  NSMutableDictionary<NSString *, NSMutableSet<NSString *> *> *_accountIDsBySubject;
+
+  /*! @brief The configuration shared by the accounts of each issuer, by issuer key. Guarded by
+          @synchronized on self.
+   */
+  NSMutableDictionary<NSString *, OIDServiceConfiguration *> *_configurations;
+
+  /*! @brief The number of accounts of each issuer, by issuer key. Guarded by @synchronized on self.
+   */
+  NSCountedSet<NSString *> *_accountCounts;
+
+  /*! @brief The refreshes waiting for a free slot, soonest expiry first, by issuer key. Guarded by
+          @synchronized on self.
+   */
+  NSMutableDictionary<NSString *, NSMutableArray<OIDAuthStateRegistryRefresh *> *>
+      *_queuedRefreshes;
+
+  /*! @brief The number of refreshes in flight, by issuer key. Guarded by @synchronized on self.
+   */
+  NSCountedSet<NSString *> *_activeRefreshCounts;
+
+  /*! @brief The IDs of the accounts with a queued or active refresh. Guarded by @synchronized on
+          self.
+   */
+  NSMutableSet<NSString *> *_refreshingAccountIDs;
+}
+
+- (instancetype)init {
+  return [self initWithMaximumConcurrentRefreshesPerIssuer:
+      kDefaultMaximumConcurrentRefreshesPerIssuer];
+}
+
+- (instancetype)initWithMaximumConcurrentRefreshesPerIssuer:
+    (NSUInteger)maximumConcurrentRefreshesPerIssuer {
+  self = [super init];
+  if (self) {
+    _maximumConcurrentRefreshesPerIssuer = MAX(maximumConcurrentRefreshesPerIssuer, 1);
+    _accounts = [NSMutableDictionary dictionary];
+    _accountIDsBySubject = [NSMutableDictionary dictionary];
+    _configurations = [NSMutableDictionary dictionary];
+    _accountCounts = [[NSCountedSet alloc] init];
+    _queuedRefreshes = [NSMutableDictionary dictionary];
+    _activeRefreshCounts = [[NSCountedSet alloc] init];
+    _refreshingAccountIDs = [NSMutableSet set];
+  }
+  return self;
+}
+
+#pragma mark - Accounts
+
+- (NSUInteger)count {
+  @synchronized(self) {
+    return _accounts.count;
+  }
+}
+
+- (NSArray<NSString *> *)accountIDs {
+  @synchronized(self) {
+    return _accounts.allKeys;
+  }
+}
+
+- (void)setAuthState:(OIDAuthState *)authState forAccountID:(NSString *)accountID {
+  OIDAuthStateSnapshot *snapshot = authState.snapshot;
+  OIDServiceConfiguration *configuration = snapshot.lastAuthorizationResponse.request.configuration;
+  OIDAuthStateRegistryAccount *account = [[OIDAuthStateRegistryAccount alloc] init];
+  account.authState = authState;
+  account.issuerKey = configuration ? [OIDCircuitBreaker keyForConfiguration:configuration] : nil;
+  if (snapshot.idToken) {
+    account.subject = [[OIDIDToken alloc] initWithIDTokenString:snapshot.idToken].subject;
+  }
+
+  @synchronized(self) {
+    [self removeAccountWithID:accountID];
+    _accounts[accountID] = account;
+    if (account.subject) {
+      NSMutableSet<NSString *> *accountIDs = _accountIDsBySubject[account.subject];
+      if (!accountIDs) {
+        accountIDs = [NSMutableSet set];
+        _accountIDsBySubject[account.subject] = accountIDs;
+      }
+      [accountIDs addObject:accountID];
+    }
+    if (account.issuerKey) {
+      if (!_configurations[account.issuerKey]) {
+        _configurations[account.issuerKey] = configuration;
+      }
+      [_accountCounts addObject:account.issuerKey];
+    }
+  }
+}
+
+- (void)removeAuthStateForAccountID:(NSString *)accountID {
+  @synchronized(self) {
+    [self removeAccountWithID:accountID];
+  }
+}
+
+/*! @brief Removes an account and its index entries. Must be called while synchronized on self.
+    @param accountID The ID of the account.
+ */
+- (void)removeAccountWithID:(NSString *)accountID {
+  OIDAuthStateRegistryAccount *account = _accounts[accountID];
+  if (!account) {
+    return;
+  }
+  [_accounts removeObjectForKey:accountID];
+  if (account.subject) {
+    NSMutableSet<NSString *> *accountIDs = _accountIDsBySubject[account.subject];
+    [accountIDs removeObject:accountID];
+    if (!accountIDs.count) {
+      [_accountIDsBySubject removeObjectForKey:account.subject];
+    }
+  }
+  if (account.issuerKey) {
+    [_accountCounts removeObject:account.issuerKey];
+    if (![_accountCounts countForObject:account.issuerKey]) {
+      [_configurations removeObjectForKey:account.issuerKey];
+    }
+  }
+}
+
+- (nullable OIDAuthState *)authStateForAccountID:(NSString *)accountID {
+  @synchronized(self) {
+    return _accounts[accountID].authState;
+  }
+}
+
+- (NSArray<NSString *> *)accountIDsForSubject:(NSString *)subject {
+  @synchronized(self) {
+    return _accountIDsBySubject[subject].allObjects ?: @[];
+  }
+}
+
+- (nullable OIDServiceConfiguration *)configurationForAccountID:(NSString *)accountID {
+  @synchronized(self) {
+    NSString *issuerKey = _accounts[accountID].issuerKey;
+    return issuerKey ? _configurations[issuerKey] : nil;
+  }
+}
+
+#pragma mark - Refreshing
+
+- (void)refreshAuthStatesExpiringWithin:(NSTimeInterval)interval
+                             completion:(OIDAuthStateRegistryRefreshCompletion)completion {
+  NSDate *deadline = [[[OIDClock sharedClock] now] dateByAddingTimeInterval:interval];
+  NSMutableDictionary<NSString *, NSError *> *errors = [NSMutableDictionary dictionary];
+  dispatch_group_t group = dispatch_group_create();
+  void (^refreshCompletion)(NSString *, NSError *) = ^(NSString *accountID, NSError *error) {
+    if (error) {
+      @synchronized(errors) {
+        errors[accountID] = error;
+      }
+    }
+    dispatch_group_leave(group);
+  };
+
+  NSMutableSet<NSString *> *issuerKeys = [NSMutableSet set];
+  @synchronized(self) {
+    NSMutableArray<OIDAuthStateRegistryRefresh *> *refreshes = [NSMutableArray array];
+    for (NSString *accountID in _accounts) {
+      OIDAuthStateRegistryAccount *account = _accounts[accountID];
+      OIDAuthStateSnapshot *snapshot = account.authState.snapshot;
+      if (!account.issuerKey || !snapshot.refreshToken ||
+          [_refreshingAccountIDs containsObject:accountID]) {
+        continue;
+      }
+      NSDate *expirationDate = snapshot.accessTokenExpirationDate;
+      BOOL expiring = expirationDate && [expirationDate compare:deadline] != NSOrderedDescending;
+      if (!expiring && !snapshot.needsTokenRefresh) {
+        continue;
+      }
+      OIDAuthStateRegistryRefresh *refresh = [[OIDAuthStateRegistryRefresh alloc] init];
+      refresh.accountID = accountID;
+      refresh.authState = account.authState;
+      refresh.expirationDate = expirationDate;
+      refresh.completion = ^(NSError *_Nullable error) {
+        refreshCompletion(accountID, error);
+      };
+      [refreshes addObject:refresh];
+    }
+
+    // soonest expiry first; forced refreshes without an expiration date go first
+    [refreshes sortUsingComparator:^NSComparisonResult(OIDAuthStateRegistryRefresh *refresh1,
+                                                       OIDAuthStateRegistryRefresh *refresh2) {
+      NSDate *date1 = refresh1.expirationDate ?: [NSDate distantPast];
+      NSDate *date2 = refresh2.expirationDate ?: [NSDate distantPast];
+      return [date1 compare:date2];
+    }];
+
+    for (OIDAuthStateRegistryRefresh *refresh in refreshes) {
+      NSString *issuerKey = _accounts[refresh.accountID].issuerKey;
+      NSMutableArray<OIDAuthStateRegistryRefresh *> *queue = _queuedRefreshes[issuerKey];
+      if (!queue) {
+        queue = [NSMutableArray array];
+        _queuedRefreshes[issuerKey] = queue;
+      }
+      [queue addObject:refresh];
+      [_refreshingAccountIDs addObject:refresh.accountID];
+      [issuerKeys addObject:issuerKey];
+      dispatch_group_enter(group);
+    }
+  }
+
+  for (NSString *issuerKey in issuerKeys) {
+    [self startQueuedRefreshesForIssuerKey:issuerKey];
+  }
+  dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+    completion([errors copy]);
+  });
+}
+
+/*! @brief Starts queued refreshes of an issuer while it has fewer refreshes in flight than allowed.
+    @param issuerKey The key of the issuer.
+ */
+- (void)startQueuedRefreshesForIssuerKey:(NSString *)issuerKey {
+  NSMutableArray<OIDAuthStateRegistryRefresh *> *refreshesToStart = [NSMutableArray array];
+  @synchronized(self) {
+    NSMutableArray<OIDAuthStateRegistryRefresh *> *queue = _queuedRefreshes[issuerKey];
+    while (queue.count &&
+           [_activeRefreshCounts countForObject:issuerKey] < _maximumConcurrentRefreshesPerIssuer) {
+      [refreshesToStart addObject:queue.firstObject];
+      [queue removeObjectAtIndex:0];
+      [_activeRefreshCounts addObject:issuerKey];
+    }
+    if (queue && !queue.count) {
+      [_queuedRefreshes removeObjectForKey:issuerKey];
+    }
+  }
+
+  for (OIDAuthStateRegistryRefresh *refresh in refreshesToStart) {
+    [refresh.authState setNeedsTokenRefresh];
+    [refresh.authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                                      NSString *_Nullable idToken,
+                                                      NSError *_Nullable error) {
+      @synchronized(self) {
+        [self->_activeRefreshCounts removeObject:issuerKey];
+        [self->_refreshingAccountIDs removeObject:refresh.accountID];
+      }
+      refresh.completion(accessToken ? nil : error);
+      [self startQueuedRefreshesForIssuerKey:issuerKey];
+    }
+                                additionalRefreshParameters:nil
+                                              dispatchQueue:dispatch_get_global_queue(
+                                                  DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)
+                                                   priority:OIDTokenRequestPriorityBackground
+                                                    timeout:0];
+  }
+}
+
+@end
@@ -0,0 +1,109 @@
+/*! @file OIDAuthStateSnapshot.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDAuthorizationResponse;
+@class OIDRegistrationResponse;
+@class OIDTokenResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief An immutable copy of the state of an @c OIDAuthState at one point in time.
+    @discussion @c OIDAuthState publishes a new snapshot each time it changes, so all the values of
+        one snapshot were current together, and a snapshot can be read from any thread.
+ */
+@interface OIDAuthStateSnapshot : NSObject
+
+/*! @brief The most recent refresh token received from the server.
+ */
+@property(nonatomic, readonly, nullable) NSString *refreshToken;
+
+/*! @brief The scope of the current authorization grant.
+ */
+@property(nonatomic, readonly, nullable) NSString *scope;
+
+/*! @brief The most recent authorization response.
+ */
+@property(nonatomic, readonly, nullable) OIDAuthorizationResponse *lastAuthorizationResponse;
+
+/*! @brief The most recent token response.
+ */
+@property(nonatomic, readonly, nullable) OIDTokenResponse *lastTokenResponse;
+
+/*! @brief The most recent registration response.
+ */
+@property(nonatomic, readonly, nullable) OIDRegistrationResponse *lastRegistrationResponse;
+
+/*! @brief The authorization error that invalidated the state, if any.
+ */
+@property(nonatomic, readonly, nullable) NSError *authorizationError;
+
+/*! @brief Whether the tokens must be refreshed before their next use regardless of expiry.
+ */
+@property(nonatomic, readonly) BOOL needsTokenRefresh;
+
+/*! @brief The access token of the most recent token or authorization response, or nil if there is
+        an authorization error.
+ */
+@property(nonatomic, readonly, nullable) NSString *accessToken;
+
+/*! @brief The type of @c #accessToken, or nil if there is an authorization error.
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenType;
+
+/*! @brief The approximate expiration date of @c #accessToken, or nil if there is an authorization
+        error.
+ */
+@property(nonatomic, readonly, nullable) NSDate *accessTokenExpirationDate;
+
+/*! @brief The ID Token of the most recent token or authorization response, or nil if there is an
+        authorization error.
+ */
+@property(nonatomic, readonly, nullable) NSString *idToken;
+
+/*! @brief Whether the state is not known to be invalid.
+    @see OIDAuthState.isAuthorized
+ */
+@property(nonatomic, readonly) BOOL isAuthorized;
+
+/*! @internal
+    @brief Unavailable. Please use the designated initializer.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param refreshToken The most recent refresh token.
+    @param scope The scope of the current authorization grant.
+    @param lastAuthorizationResponse The most recent authorization response.
+    @param lastTokenResponse The most recent token response.
+    @param lastRegistrationResponse The most recent registration response.
+    @param authorizationError The authorization error that invalidated the state.
+    @param needsTokenRefresh Whether the tokens must be refreshed before their next use.
+ */
+- (instancetype)initWithRefreshToken:(nullable NSString *)refreshToken
+                               scope:(nullable NSString *)scope
+           lastAuthorizationResponse:(nullable OIDAuthorizationResponse *)lastAuthorizationResponse
+                   lastTokenResponse:(nullable OIDTokenResponse *)lastTokenResponse
+            lastRegistrationResponse:(nullable OIDRegistrationResponse *)lastRegistrationResponse
+                  authorizationError:(nullable NSError *)authorizationError
+                   needsTokenRefresh:(BOOL)needsTokenRefresh NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,95 @@
+/*! @file OIDAuthStateSnapshot.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDAuthStateSnapshot.h"
+
+#import "OIDAuthorizationResponse.h"
+#import "OIDDefines.h"
+#import "OIDTokenResponse.h"
+
+@implementation OIDAuthStateSnapshot
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithRefreshToken:
+                                 scope:
+             lastAuthorizationResponse:
+                     lastTokenResponse:
+              lastRegistrationResponse:
+                    authorizationError:
+                     needsTokenRefresh:))
+
+- (instancetype)initWithRefreshToken:(nullable NSString *)refreshToken
+                               scope:(nullable NSString *)scope
+           lastAuthorizationResponse:(nullable OIDAuthorizationResponse *)lastAuthorizationResponse
+                   lastTokenResponse:(nullable OIDTokenResponse *)lastTokenResponse
+            lastRegistrationResponse:(nullable OIDRegistrationResponse *)lastRegistrationResponse
+                  authorizationError:(nullable NSError *)authorizationError
+                   needsTokenRefresh:(BOOL)needsTokenRefresh {
+  self = [super init];
+  if (self) {
+    _refreshToken = [refreshToken copy];
+    _scope = [scope copy];
+    _lastAuthorizationResponse = lastAuthorizationResponse;
+    _lastTokenResponse = lastTokenResponse;
+    _lastRegistrationResponse = lastRegistrationResponse;
+    _authorizationError = authorizationError;
+    _needsTokenRefresh = needsTokenRefresh;
+  }
+  return self;
+}
+
+#pragma mark - Convenience getters
+
+- (nullable NSString *)accessToken {
+  if (_authorizationError) {
+    return nil;
+  }
+  return _lastTokenResponse ? _lastTokenResponse.accessToken
+                            : _lastAuthorizationResponse.accessToken;
+}
+
+- (nullable NSString *)tokenType {
+  if (_authorizationError) {
+    return nil;
+  }
+  return _lastTokenResponse ? _lastTokenResponse.tokenType
+                            : _lastAuthorizationResponse.tokenType;
+}
+
+- (nullable NSDate *)accessTokenExpirationDate {
+  if (_authorizationError) {
+    return nil;
+  }
+  return _lastTokenResponse ? _lastTokenResponse.accessTokenExpirationDate
+                            : _lastAuthorizationResponse.accessTokenExpirationDate;
+}
+
+- (nullable NSString *)idToken {
+  if (_authorizationError) {
+    return nil;
+  }
+  return _lastTokenResponse ? _lastTokenResponse.idToken
+                            : _lastAuthorizationResponse.idToken;
+}
+
+- (BOOL)isAuthorized {
+  return !_authorizationError && (self.accessToken || self.idToken || _refreshToken);
+}
+
+@end
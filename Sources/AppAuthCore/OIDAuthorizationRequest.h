@@ -268,6 +268,17 @@ extern NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256;
  */
 + (nullable NSString *)codeChallengeS256ForVerifier:(nullable NSString *)codeVerifier;
 
+/*! @brief Starts keeping a small pool of state, nonce and PKCE values generated ahead of time on a
+        background queue.
+    @discussion Once called, the convenience initializers which generate these values take them
+        from the pool instead of generating them on the calling thread, and the pool is refilled in
+        the background after each use. Call this early, for example at launch, so that creating the
+        request when the user signs in does no random generation or hashing on the main thread.
+        Each pooled value is used for one request only. If the pool is empty, values are generated
+        synchronously as usual.
+ */
++ (void)pregenerateParameters;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -19,6 +19,7 @@
 #import "OIDAuthorizationRequest.h"
 
 #import "OIDDefines.h"
+#import "OIDFieldMapping.h"
 #import "OIDScopeUtilities.h"
 #import "OIDServiceConfiguration.h"
 #import "OIDTokenUtilities.h"
@@ -84,6 +85,16 @@ static NSUInteger const kStateSizeBytes = 32;
  */
 static NSUInteger const kCodeVerifierBytes = 32;
 
+/*! @brief Number of pre-generated parameter sets kept ready once
+        @c OIDAuthorizationRequest.pregenerateParameters has been called.
+ */
+static NSUInteger const kGeneratedParametersPoolSize = 4;
+
+/*! @brief Maximum number of authorization URL templates kept in
+        @c gAuthorizationRequestURLTemplates.
+ */
+static NSUInteger const kAuthorizationRequestURLTemplateCacheLimit = 16;
+
 /*! @brief Assertion text for unsupported response types.
  */
 static NSString *const OIDOAuthUnsupportedResponseTypeMessage =
@@ -93,6 +104,59 @@ static NSString *const OIDOAuthUnsupportedResponseTypeMessage =
  */
 NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
 
+/*! @brief The random values needed by a new authorization request: state, nonce and a PKCE
+        verifier with its S256 challenge.
+ */
+@interface OIDAuthorizationRequestGeneratedParameters : NSObject
+
+@property(nonatomic, readonly, nullable) NSString *state;
+@property(nonatomic, readonly, nullable) NSString *nonce;
+@property(nonatomic, readonly, nullable) NSString *codeVerifier;
+@property(nonatomic, readonly, nullable) NSString *codeChallenge;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithState:(nullable NSString *)state
+                        nonce:(nullable NSString *)nonce
+                 codeVerifier:(nullable NSString *)codeVerifier
+                codeChallenge:(nullable NSString *)codeChallenge NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation OIDAuthorizationRequestGeneratedParameters
+
+- (instancetype)init OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithState:nonce:codeVerifier:codeChallenge:))
+
+- (instancetype)initWithState:(nullable NSString *)state
+                        nonce:(nullable NSString *)nonce
+                 codeVerifier:(nullable NSString *)codeVerifier
+                codeChallenge:(nullable NSString *)codeChallenge {
+  self = [super init];
+  if (self) {
+    _state = [state copy];
+    _nonce = [nonce copy];
+    _codeVerifier = [codeVerifier copy];
+    _codeChallenge = [codeChallenge copy];
+  }
+  return self;
+}
+
+@end
+
+/*! @brief Pre-generated parameter sets, guarded by @synchronized on the array itself. Remains nil
+        until @c OIDAuthorizationRequest.pregenerateParameters is called.
+ */
+static NSMutableArray<OIDAuthorizationRequestGeneratedParameters *> *gGeneratedParametersPool;
+
+/*! @brief Whether a refill of @c gGeneratedParametersPool is already queued. Guarded by the pool.
+ */
+static BOOL gGeneratedParametersRefillScheduled;
+
+/*! @brief Already-encoded authorization URLs containing only the parameters that are the same for
+        every request of a client, keyed by the values they were built from.
+ */
+static NSCache<NSArray *, NSString *> *gAuthorizationRequestURLTemplates;
+
 @implementation OIDAuthorizationRequest
 
 - (instancetype)init
@@ -168,9 +232,8 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
             responseType:(NSString *)responseType
     additionalParameters:(nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
 
-  // generates PKCE code verifier and challenge
-  NSString *codeVerifier = [[self class] generateCodeVerifier];
-  NSString *codeChallenge = [[self class] codeChallengeS256ForVerifier:codeVerifier];
+  // generates state, nonce and PKCE code verifier and challenge
+  OIDAuthorizationRequestGeneratedParameters *generated = [[self class] dequeueGeneratedParameters];
 
   return [self initWithConfiguration:configuration
                             clientId:clientID
@@ -178,10 +241,10 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
                                scope:[OIDScopeUtilities scopesWithArray:scopes]
                          redirectURL:redirectURL
                         responseType:responseType
-                               state:[[self class] generateState]
-                               nonce:[[self class] generateState]
-                        codeVerifier:codeVerifier
-                       codeChallenge:codeChallenge
+                               state:generated.state
+                               nonce:generated.nonce
+                        codeVerifier:generated.codeVerifier
+                       codeChallenge:generated.codeChallenge
                  codeChallengeMethod:OIDOAuthorizationRequestCodeChallengeMethodS256
                 additionalParameters:additionalParameters];
 }
@@ -210,9 +273,8 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
              responseType:(NSString *)responseType
                     nonce:(nullable NSString *)nonce
     additionalParameters:(nullable NSDictionary<NSString *, NSString *> *)additionalParameters {
-  // generates PKCE code verifier and challenge
-  NSString *codeVerifier = [[self class] generateCodeVerifier];
-  NSString *codeChallenge = [[self class] codeChallengeS256ForVerifier:codeVerifier];
+  // generates state and PKCE code verifier and challenge
+  OIDAuthorizationRequestGeneratedParameters *generated = [[self class] dequeueGeneratedParameters];
 
   return [self initWithConfiguration:configuration
                             clientId:clientID
@@ -220,10 +282,10 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
                                scope:[OIDScopeUtilities scopesWithArray:scopes]
                          redirectURL:redirectURL
                         responseType:responseType
-                               state:[[self class] generateState]
+                               state:generated.state
                                nonce:nonce
-                        codeVerifier:codeVerifier
-                       codeChallenge:codeChallenge
+                        codeVerifier:generated.codeVerifier
+                       codeChallenge:generated.codeChallenge
                  codeChallengeMethod:OIDOAuthorizationRequestCodeChallengeMethodS256
                 additionalParameters:additionalParameters];
 }
@@ -260,12 +322,8 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
       [aDecoder decodeObjectOfClass:[NSString class] forKey:kCodeChallengeKey];
   NSString *codeChallengeMethod =
       [aDecoder decodeObjectOfClass:[NSString class] forKey:kCodeChallengeMethodKey];
-  NSSet *additionalParameterCodingClasses = [NSSet setWithArray:@[
-    [NSDictionary class],
-    [NSString class]
-  ]];
   NSDictionary *additionalParameters =
-      [aDecoder decodeObjectOfClasses:additionalParameterCodingClasses
+      [aDecoder decodeObjectOfClasses:[OIDFieldMapping stringDictionaryTypes]
                                forKey:kAdditionalParametersKey];
 
   self = [self initWithConfiguration:configuration
@@ -328,9 +386,150 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
   return [OIDTokenUtilities encodeBase64urlNoPadding:sha256Verifier];
 }
 
++ (void)pregenerateParameters {
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    gGeneratedParametersPool = [NSMutableArray arrayWithCapacity:kGeneratedParametersPoolSize];
+  });
+  [self scheduleGeneratedParametersRefill];
+}
+
+/*! @brief Generates a new set of request parameters on the calling thread.
+    @return The generated parameters, or nil if the random source failed.
+ */
++ (nullable OIDAuthorizationRequestGeneratedParameters *)generateParameters {
+  NSString *codeVerifier = [self generateCodeVerifier];
+  NSString *codeChallenge = [self codeChallengeS256ForVerifier:codeVerifier];
+  NSString *state = [self generateState];
+  NSString *nonce = [self generateState];
+  if (!codeChallenge || !state || !nonce) {
+    return nil;
+  }
+  return [[OIDAuthorizationRequestGeneratedParameters alloc] initWithState:state
+                                                                     nonce:nonce
+                                                              codeVerifier:codeVerifier
+                                                             codeChallenge:codeChallenge];
+}
+
+/*! @brief Returns a set of parameters for a new request, taking it from the pool when one is
+        available and generating it synchronously otherwise.
+    @discussion Subclasses which override any of the generation methods always generate
+        synchronously, so that their overrides are honored.
+ */
++ (OIDAuthorizationRequestGeneratedParameters *)dequeueGeneratedParameters {
+  OIDAuthorizationRequestGeneratedParameters *generated = nil;
+  NSMutableArray *pool = gGeneratedParametersPool;
+  if (pool && ![self overridesParameterGeneration]) {
+    @synchronized(pool) {
+      generated = [pool lastObject];
+      if (generated) {
+        [pool removeLastObject];
+      }
+    }
+    [self scheduleGeneratedParametersRefill];
+  }
+  if (generated) {
+    return generated;
+  }
+
+  // Pool empty or disabled, falls back to generating on the caller's thread. The individual values
+  // are generated directly so that a failing random source still results in nil fields, as before.
+  NSString *codeVerifier = [self generateCodeVerifier];
+  return [[OIDAuthorizationRequestGeneratedParameters alloc]
+      initWithState:[self generateState]
+              nonce:[self generateState]
+       codeVerifier:codeVerifier
+      codeChallenge:[self codeChallengeS256ForVerifier:codeVerifier]];
+}
+
+/*! @brief Whether this class replaces any of the methods used to generate request parameters.
+ */
++ (BOOL)overridesParameterGeneration {
+  Class baseClass = [OIDAuthorizationRequest class];
+  if (self == baseClass) {
+    return NO;
+  }
+  SEL selectors[] = {
+    @selector(generateState),
+    @selector(generateCodeVerifier),
+    @selector(codeChallengeS256ForVerifier:),
+  };
+  for (size_t i = 0; i < sizeof(selectors) / sizeof(selectors[0]); i++) {
+    if ([self methodForSelector:selectors[i]] != [baseClass methodForSelector:selectors[i]]) {
+      return YES;
+    }
+  }
+  return NO;
+}
+
+/*! @brief Queues a background refill of the parameter pool, unless one is already queued.
+ */
++ (void)scheduleGeneratedParametersRefill {
+  NSMutableArray *pool = gGeneratedParametersPool;
+  @synchronized(pool) {
+    if (gGeneratedParametersRefillScheduled || pool.count >= kGeneratedParametersPoolSize) {
+      return;
+    }
+    gGeneratedParametersRefillScheduled = YES;
+  }
+
+  Class baseClass = [OIDAuthorizationRequest class];
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+    while (YES) {
+      // Generation happens outside the lock so that callers drawing from the pool never wait on it.
+      OIDAuthorizationRequestGeneratedParameters *generated = [baseClass generateParameters];
+      @synchronized(pool) {
+        if (generated && pool.count < kGeneratedParametersPoolSize) {
+          [pool addObject:generated];
+        }
+        if (!generated || pool.count >= kGeneratedParametersPoolSize) {
+          gGeneratedParametersRefillScheduled = NO;
+          return;
+        }
+      }
+    }
+  });
+}
+
 #pragma mark -
 
 - (NSURL *)authorizationRequestURL {
+  NSString *URLTemplate = [self authorizationRequestURLTemplate];
+  if (!URLTemplate) {
+    // The endpoint can't be templated, so builds the whole URL.
+    OIDURLQueryComponent *query = [self staticAuthorizationRequestQuery];
+    [self addDynamicParametersToQuery:query];
+    return [query URLByReplacingQueryInURL:_configuration.authorizationEndpoint];
+  }
+
+  // Appends the parameters that are unique to this request to the already-encoded template.
+  static NSCharacterSet *allowedCharacters;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    allowedCharacters = [[OIDURLQueryComponent URLParamValueAllowedCharacters] copy];
+  });
+  NSMutableString *URLString = [URLTemplate mutableCopy];
+  void (^appendParameter)(NSString *, NSString *) = ^(NSString *name, NSString *value) {
+    NSString *encodedValue =
+        [value stringByAddingPercentEncodingWithAllowedCharacters:allowedCharacters];
+    [URLString appendFormat:@"&%@=%@", name, encodedValue];
+  };
+  if (_state) {
+    appendParameter(kStateKey, _state);
+  }
+  if (_nonce) {
+    appendParameter(kNonceKey, _nonce);
+  }
+  if (_codeChallenge) {
+    appendParameter(kCodeChallengeKey, _codeChallenge);
+  }
+  return [NSURL URLWithString:URLString];
+}
+
+/*! @brief Builds a query containing the parameters which are the same for every request made by
+        this client.
+ */
+- (OIDURLQueryComponent *)staticAuthorizationRequestQuery {
   OIDURLQueryComponent *query = [[OIDURLQueryComponent alloc] init];
 
   // Required parameters.
@@ -347,6 +546,15 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
   if (_scope) {
     [query addParameter:kScopeKey value:_scope];
   }
+  if (_codeChallengeMethod) {
+    [query addParameter:kCodeChallengeMethodKey value:_codeChallengeMethod];
+  }
+  return query;
+}
+
+/*! @brief Adds the parameters which are unique to this request to @c query.
+ */
+- (void)addDynamicParametersToQuery:(OIDURLQueryComponent *)query {
   if (_state) {
     [query addParameter:kStateKey value:_state];
   }
@@ -356,12 +564,45 @@ NSString *const OIDOAuthorizationRequestCodeChallengeMethodS256 = @"S256";
   if (_codeChallenge) {
     [query addParameter:kCodeChallengeKey value:_codeChallenge];
   }
-  if (_codeChallengeMethod) {
-    [query addParameter:kCodeChallengeMethodKey value:_codeChallengeMethod];
+}
+
+/*! @brief Returns the encoded authorization URL containing only the static parameters of this
+        request, building and caching it on first use.
+    @return The URL string, or nil if the authorization endpoint has a fragment, in which case
+        parameters can't be appended to the string.
+ */
+- (nullable NSString *)authorizationRequestURLTemplate {
+  NSURL *authorizationEndpoint = _configuration.authorizationEndpoint;
+  if (authorizationEndpoint.fragment) {
+    return nil;
   }
 
-  // Construct the URL:
-  return [query URLByReplacingQueryInURL:_configuration.authorizationEndpoint];
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    gAuthorizationRequestURLTemplates = [[NSCache alloc] init];
+    gAuthorizationRequestURLTemplates.countLimit = kAuthorizationRequestURLTemplateCacheLimit;
+  });
+
+  NSArray *key = @[
+    authorizationEndpoint,
+    _responseType,
+    _clientID,
+    _redirectURL ?: [NSNull null],
+    _scope ?: [NSNull null],
+    _codeChallengeMethod ?: [NSNull null],
+    _additionalParameters ?: [NSNull null],
+    @(gOIDURLQueryComponentForceIOS7Handling),
+  ];
+  NSString *URLTemplate = [gAuthorizationRequestURLTemplates objectForKey:key];
+  if (!URLTemplate) {
+    OIDURLQueryComponent *query = [self staticAuthorizationRequestQuery];
+    URLTemplate = [query URLByReplacingQueryInURL:authorizationEndpoint].absoluteString;
+    if (!URLTemplate) {
+      return nil;
+    }
+    [gAuthorizationRequestURLTemplates setObject:URLTemplate forKey:key];
+  }
+  return URLTemplate;
 }
 
 #pragma mark - OIDExternalUserAgentRequest
@@ -18,11 +18,14 @@
 
 #import <Foundation/Foundation.h>
 
+#import "OIDTokenRequestScheduler.h"
+
 @class OIDAuthorization;
 @class OIDAuthorizationRequest;
 @class OIDAuthorizationResponse;
 @class OIDEndSessionRequest;
 @class OIDEndSessionResponse;
+@class OIDNetworkTask;
 @class OIDRegistrationRequest;
 @class OIDRegistrationResponse;
 @class OIDServiceConfiguration;
@@ -100,21 +103,54 @@ typedef void (^OIDRegistrationCompletion)(OIDRegistrationResponse *_Nullable reg
     @param issuerURL The service provider's OpenID Connect issuer.
     @param completion A block which will be invoked when the authorization service configuration has
         been created, or when an error has occurred.
+    @return A handle with which the discovery can be cancelled.
+    @see https://openid.net/specs/openid-connect-discovery-1_0.html
+ */
++ (OIDNetworkTask *)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                               completion:(OIDDiscoveryCallback)completion;
+
+/*! @brief Convenience method for creating an authorization service configuration from an OpenID
+        Connect compliant issuer URL.
+    @param issuerURL The service provider's OpenID Connect issuer.
+    @param timeout The time in seconds the discovery has to complete in, or 0 for no deadline.
+    @param completion A block which will be invoked when the authorization service configuration has
+        been created, or when an error has occurred.
+    @return A handle with which the discovery can be cancelled.
     @see https://openid.net/specs/openid-connect-discovery-1_0.html
  */
-+ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
-                                   completion:(OIDDiscoveryCallback)completion;
++ (OIDNetworkTask *)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                                  timeout:(NSTimeInterval)timeout
+                                               completion:(OIDDiscoveryCallback)completion;
 
+/*! @brief Convenience method for creating an authorization service configuration from an OpenID
+        Connect compliant identity provider's discovery document.
+    @param discoveryURL The URL of the service provider's OpenID Connect discovery document.
+    @param completion A block which will be invoked when the authorization service configuration has
+        been created, or when an error has occurred.
+    @return A handle with which the discovery can be cancelled.
+    @discussion Calls made while the same discovery document is already being fetched share that
+        fetch, and are completed with the same configuration instance or error.
+    @see https://openid.net/specs/openid-connect-discovery-1_0.html
+ */
++ (OIDNetworkTask *)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                                     completion:(OIDDiscoveryCallback)completion;
 
 /*! @brief Convenience method for creating an authorization service configuration from an OpenID
         Connect compliant identity provider's discovery document.
     @param discoveryURL The URL of the service provider's OpenID Connect discovery document.
+    @param timeout The time in seconds the discovery has to complete in, or 0 for no deadline.
     @param completion A block which will be invoked when the authorization service configuration has
         been created, or when an error has occurred.
+    @return A handle with which the discovery can be cancelled.
+    @discussion Calls made while the same discovery document is already being fetched share that
+        fetch, and are completed with the same configuration instance or error. Cancelling one of
+        them, or missing its deadline, only completes that call. The fetch itself is cancelled once
+        no call waits for it.
     @see https://openid.net/specs/openid-connect-discovery-1_0.html
  */
-+ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
-                                         completion:(OIDDiscoveryCallback)completion;
++ (OIDNetworkTask *)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                                        timeout:(NSTimeInterval)timeout
+                                                     completion:(OIDDiscoveryCallback)completion;
 
 /*! @brief Perform an authorization flow using a generic flow shim.
     @param request The authorization request.
@@ -146,24 +182,80 @@ typedef void (^OIDRegistrationCompletion)(OIDRegistrationResponse *_Nullable reg
 /*! @brief Performs a token request.
     @param request The token request.
     @param callback The method called when the request has completed or failed.
+    @return A handle with which the request can be cancelled.
  */
-+ (void)performTokenRequest:(OIDTokenRequest *)request callback:(OIDTokenCallback)callback;
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+                               callback:(OIDTokenCallback)callback;
 
 /*! @brief Performs a token request.
     @param request The token request.
     @param authorizationResponse The original authorization response related to this token request.
     @param callback The method called when the request has completed or failed.
+    @return A handle with which the request can be cancelled.
+ */
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+          originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
+                               callback:(OIDTokenCallback)callback;
+
+/*! @brief Performs a token request.
+    @param request The token request.
+    @param authorizationResponse The original authorization response related to this token request.
+    @param timeout The time in seconds the request has to complete in, including the verification
+        of its ID Token, or 0 for no deadline.
+    @param callback The method called when the request has completed or failed.
+    @return A handle with which the request can be cancelled.
+ */
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+          originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
+                                timeout:(NSTimeInterval)timeout
+                               callback:(OIDTokenCallback)callback;
+
+/*! @brief Performs a token request.
+    @param request The token request.
+    @param authorizationResponse The original authorization response related to this token request.
+    @param priority The priority class of the request, which sets its place in the
+        @c OIDTokenRequestScheduler.sharedScheduler, if any, the @c NSURLSessionTask.priority of
+        its session task, and the quality of service its response is processed at. The other
+        methods performing token requests use @c OIDTokenRequestPriorityNormal.
+    @param timeout The time in seconds the request has to complete in, including any wait in the
+        scheduler and the verification of its ID Token, or 0 for no deadline.
+    @param callback The method called when the request has completed or failed.
+    @return A handle with which the request can be cancelled, or its priority raised.
+ */
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+          originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
+                               priority:(OIDTokenRequestPriority)priority
+                                timeout:(NSTimeInterval)timeout
+                               callback:(OIDTokenCallback)callback;
+
+/*! @brief Opens a connection to the token endpoint ahead of the first token request.
+    @param configuration The service configuration whose token endpoint should be pre-warmed.
+    @discussion Opt-in optimization for the authorization code flow. Call this right after
+        presenting an authorization request so that DNS resolution, TCP and TLS setup for the
+        token endpoint happen while the user is in the browser. A @c HEAD request is sent through
+        the @c OIDURLSessionProvider session, whose connection pool is shared with the code
+        exchange performed by @c performTokenRequest:originalAuthorizationResponse:callback:.
+        The response is ignored.
+ */
++ (void)prewarmConnectionForConfiguration:(OIDServiceConfiguration *)configuration;
+
+/*! @brief Performs a registration request.
+    @param request The registration request.
+    @param completion The method called when the request has completed or failed.
+    @return A handle with which the request can be cancelled.
  */
-+ (void)performTokenRequest:(OIDTokenRequest *)request
-    originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
-                         callback:(OIDTokenCallback)callback;
++ (OIDNetworkTask *)performRegistrationRequest:(OIDRegistrationRequest *)request
+                                    completion:(OIDRegistrationCompletion)completion;
 
 /*! @brief Performs a registration request.
     @param request The registration request.
+    @param timeout The time in seconds the request has to complete in, or 0 for no deadline.
     @param completion The method called when the request has completed or failed.
+    @return A handle with which the request can be cancelled.
  */
-+ (void)performRegistrationRequest:(OIDRegistrationRequest *)request
-                        completion:(OIDRegistrationCompletion)completion;
++ (OIDNetworkTask *)performRegistrationRequest:(OIDRegistrationRequest *)request
+                                       timeout:(NSTimeInterval)timeout
+                                    completion:(OIDRegistrationCompletion)completion;
 
 @end
 
@@ -20,6 +20,8 @@
 
 #import "OIDAuthorizationRequest.h"
 #import "OIDAuthorizationResponse.h"
+#import "OIDCircuitBreaker.h"
+#import "OIDClock.h"
 #import "OIDDefines.h"
 #import "OIDEndSessionRequest.h"
 #import "OIDEndSessionResponse.h"
@@ -27,12 +29,17 @@
 #import "OIDExternalUserAgent.h"
 #import "OIDExternalUserAgentSession.h"
 #import "OIDIDToken.h"
+#import "OIDIDTokenSignatureVerifier.h"
+#import "OIDMetrics.h"
+#import "OIDNetworkTask.h"
 #import "OIDRegistrationRequest.h"
 #import "OIDRegistrationResponse.h"
 #import "OIDServiceConfiguration.h"
 #import "OIDServiceDiscovery.h"
 #import "OIDTokenRequest.h"
+#import "OIDTokenRequestScheduler.h"
 #import "OIDTokenResponse.h"
+#import "OIDTrace.h"
 #import "OIDURLQueryComponent.h"
 #import "OIDURLSessionProvider.h"
 
@@ -41,10 +48,9 @@
  */
 static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-configuration";
 
-/*! @brief Max allowable iat (Issued At) time skew
-    @see https://openid.net/specs/openid-connect-core-1_0.html#IDTokenValidation
+/*! @brief Timeout for the request used to pre-warm the connection to the token endpoint.
  */
-static int const kOIDAuthorizationSessionIATMaxSkew = 600;
+static NSTimeInterval const kOIDPrewarmConnectionTimeout = 30;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -346,24 +352,173 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/*! @brief A fetch of a discovery document, shared by the discoveries of it made while it is in
+        progress.
+ */
+@interface OIDDiscoveryFetch : NSObject
+
+/*! @brief The completions of the discoveries waiting for the fetch. Guarded by @synchronized on
+        @c OIDAuthorizationService.pendingDiscoveryFetches.
+ */
+@property(nonatomic, readonly) NSMutableArray<OIDDiscoveryCallback> *completions;
+
+/*! @brief The handle of the fetch, cancelled once no discovery waits for it.
+ */
+@property(nonatomic, readonly) OIDNetworkTask *networkTask;
+
+@end
+
+@implementation OIDDiscoveryFetch
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _completions = [NSMutableArray array];
+    // the discoveries waiting for the fetch are completed by their own handles
+    _networkTask = [[OIDNetworkTask alloc] initWithTimeout:0
+                                       cancellationHandler:^(NSError *error) {
+    }];
+  }
+  return self;
+}
+
+@end
+
 @implementation OIDAuthorizationService
 
-+ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
-                                   completion:(OIDDiscoveryCallback)completion {
++ (OIDNetworkTask *)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                               completion:(OIDDiscoveryCallback)completion {
+  return [[self class] discoverServiceConfigurationForIssuer:issuerURL
+                                                     timeout:0
+                                                  completion:completion];
+}
+
++ (OIDNetworkTask *)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                                  timeout:(NSTimeInterval)timeout
+                                               completion:(OIDDiscoveryCallback)completion {
   NSURL *fullDiscoveryURL =
       [issuerURL URLByAppendingPathComponent:kOpenIDConfigurationWellKnownPath];
 
-  [[self class] discoverServiceConfigurationForDiscoveryURL:fullDiscoveryURL
-                                                 completion:completion];
+  return [[self class] discoverServiceConfigurationForDiscoveryURL:fullDiscoveryURL
+                                                           timeout:timeout
+                                                        completion:completion];
+}
+
+/*! @brief Returns the fetches of discovery documents in progress, keyed by discovery URL.
+        Synchronize on the returned dictionary to access it, or the completions of its fetches.
+ */
++ (NSMutableDictionary<NSURL *, OIDDiscoveryFetch *> *)pendingDiscoveryFetches {
+  static NSMutableDictionary<NSURL *, OIDDiscoveryFetch *> *fetches;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    fetches = [NSMutableDictionary dictionary];
+  });
+  return fetches;
+}
+
++ (OIDNetworkTask *)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                                     completion:(OIDDiscoveryCallback)completion {
+  return [[self class] discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                                           timeout:0
+                                                        completion:completion];
+}
+
++ (OIDNetworkTask *)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                                        timeout:(NSTimeInterval)timeout
+                                                     completion:(OIDDiscoveryCallback)completion {
+  // Concurrent discoveries of the same document share a single fetch, and its result.
+  NSMutableDictionary<NSURL *, OIDDiscoveryFetch *> *pendingFetches =
+      [self pendingDiscoveryFetches];
+  __block OIDDiscoveryFetch *fetch;
+  __block OIDDiscoveryCallback waitingCompletion;
+  OIDNetworkTask *networkTask =
+      [[OIDNetworkTask alloc] initWithTimeout:timeout cancellationHandler:^(NSError *error) {
+    // stops waiting for the fetch, and cancels it if no other discovery waits for it
+    BOOL cancelsFetch = NO;
+    @synchronized(pendingFetches) {
+      [fetch.completions removeObjectIdenticalTo:waitingCompletion];
+      if (fetch && !fetch.completions.count && pendingFetches[discoveryURL] == fetch) {
+        [pendingFetches removeObjectForKey:discoveryURL];
+        cancelsFetch = YES;
+      }
+    }
+    if (cancelsFetch) {
+      [fetch.networkTask cancel];
+    }
+    OIDTraceDispatchToMainQueue(^{
+      completion(nil, error);
+    });
+  }];
+  waitingCompletion = ^(OIDServiceConfiguration *_Nullable configuration,
+                        NSError *_Nullable error) {
+    if ([networkTask finish]) {
+      completion(configuration, error);
+    }
+  };
+
+  BOOL startsFetch = NO;
+  @synchronized(pendingFetches) {
+    fetch = pendingFetches[discoveryURL];
+    if (!fetch) {
+      fetch = [[OIDDiscoveryFetch alloc] init];
+      pendingFetches[discoveryURL] = fetch;
+      startsFetch = YES;
+    }
+    [fetch.completions addObject:waitingCompletion];
+  }
+  if (startsFetch) {
+    [self startDiscoveryFetch:fetch forDiscoveryURL:discoveryURL];
+  }
+  return networkTask;
 }
 
-+ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
-    completion:(OIDDiscoveryCallback)completion {
+/*! @brief Fetches a discovery document, then completes the discoveries waiting for it.
+    @param fetch The fetch, registered in @c pendingDiscoveryFetches.
+    @param discoveryURL The URL of the discovery document.
+ */
++ (void)startDiscoveryFetch:(OIDDiscoveryFetch *)fetch forDiscoveryURL:(NSURL *)discoveryURL {
+  NSMutableDictionary<NSURL *, OIDDiscoveryFetch *> *pendingFetches =
+      [self pendingDiscoveryFetches];
+  OIDDiscoveryCallback completion =
+      ^(OIDServiceConfiguration *_Nullable configuration, NSError *_Nullable error) {
+    NSArray<OIDDiscoveryCallback> *completions;
+    @synchronized(pendingFetches) {
+      completions = [fetch.completions copy];
+      [fetch.completions removeAllObjects];
+      if (pendingFetches[discoveryURL] == fetch) {
+        [pendingFetches removeObjectForKey:discoveryURL];
+      }
+    }
+    for (OIDDiscoveryCallback pendingCompletion in completions) {
+      pendingCompletion(configuration, error);
+    }
+  };
+
+  OIDMetricsRequest *metricsRequest =
+      [OIDMetricsRequest requestToEndpoint:OIDMetricsEndpointDiscovery
+                                URLRequest:[NSURLRequest requestWithURL:discoveryURL]];
+  if (metricsRequest) {
+    OIDDiscoveryCallback discoveryCompletion = completion;
+    completion = ^(OIDServiceConfiguration *_Nullable configuration, NSError *_Nullable error) {
+      [metricsRequest didCompleteWithError:error];
+      discoveryCompletion(configuration, error);
+    };
+  }
 
+  OIDNetworkTask *fetchTask = fetch.networkTask;
+  uint64_t fetchTrace = OIDTraceBeginPhase(OIDTracePhaseDiscoveryFetch);
   NSURLSession *session = [OIDURLSessionProvider session];
   NSURLSessionDataTask *task =
       [session dataTaskWithURL:discoveryURL
              completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+    OIDTraceEndPhase(OIDTracePhaseDiscoveryFetch, fetchTrace);
+    if (![fetchTask finish]) {
+      // cancelled, as no discovery waits for it any more
+      [metricsRequest didCompleteWithError:error];
+      return;
+    }
+    [metricsRequest didReceiveData:data];
+
     // If we got any sort of error, just report it.
     if (error || !data) {
       NSString *errorDescription =
@@ -373,7 +528,7 @@ NS_ASSUME_NONNULL_BEGIN
       error = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
                                underlyingError:error
                                    description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         completion(nil, error);
       });
       return;
@@ -394,15 +549,17 @@ NS_ASSUME_NONNULL_BEGIN
       error = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
                                underlyingError:URLResponseError
                                    description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         completion(nil, error);
       });
       return;
     }
 
     // Construct an OIDServiceDiscovery with the received JSON.
+    uint64_t parseTrace = OIDTraceBeginPhase(OIDTracePhaseJSONParse);
     OIDServiceDiscovery *discovery =
         [[OIDServiceDiscovery alloc] initWithJSONData:data error:&error];
+    OIDTraceEndPhase(OIDTracePhaseJSONParse, parseTrace);
     if (error || !discovery) {
       NSString *errorDescription =
           [NSString stringWithFormat:@"JSON error parsing document at '%@': %@",
@@ -411,7 +568,7 @@ NS_ASSUME_NONNULL_BEGIN
       error = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
                                underlyingError:error
                                    description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         completion(nil, error);
       });
       return;
@@ -420,10 +577,11 @@ NS_ASSUME_NONNULL_BEGIN
     // Create our service configuration with the discovery document and return it.
     OIDServiceConfiguration *configuration =
         [[OIDServiceConfiguration alloc] initWithDiscoveryDocument:discovery];
-    dispatch_async(dispatch_get_main_queue(), ^{
+    OIDTraceDispatchToMainQueue(^{
       completion(configuration, nil);
     });
   }];
+  [fetchTask setSessionTask:task];
   [task resume];
 }
 
@@ -452,17 +610,160 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - Token Endpoint
 
-+ (void)performTokenRequest:(OIDTokenRequest *)request callback:(OIDTokenCallback)callback {
-  [[self class] performTokenRequest:request
-      originalAuthorizationResponse:nil
-                           callback:callback];
+/*! @brief Validates the ID Token included in a token response, if any.
+    @param tokenResponse The token response.
+    @param authorizationResponse The authorization response the token request was made for, if any.
+    @return The validation error, or nil if the ID Token is valid or there is none.
+ */
++ (nullable NSError *)validateIDTokenInTokenResponse:(OIDTokenResponse *)tokenResponse
+    originalAuthorizationResponse:(nullable OIDAuthorizationResponse *)authorizationResponse {
+  // If an ID Token is included in the response, validates the ID Token following the rules
+  // in OpenID Connect Core Section 3.1.3.7 for features that AppAuth directly supports
+  // (which excludes rules #1, #4, #5, #7, #8, #12, and #13). Regarding rule #6, ID Tokens
+  // received by this class are received via direct communication between the Client and the Token
+  // Endpoint, thus by default we are exercising the option to rely only on the TLS validation.
+  // Setting OIDIDTokenSignatureVerifier.sharedVerifier additionally verifies the RS256 or ES256
+  // signature of the ID Token against the key set of the issuer, once the checks below pass.
+  if (tokenResponse.idToken) {
+    OIDIDToken *idToken = [[OIDIDToken alloc] initWithIDTokenString:tokenResponse.idToken];
+    if (!idToken) {
+      NSError *invalidIDToken =
+        [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenParsingError
+                         underlyingError:nil
+                             description:@"ID Token parsing failed"];
+      return invalidIDToken;
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rule #1
+    // Not supported: AppAuth does not support JWT encryption.
+
+    // OpenID Connect Core Section 3.1.3.7. rule #2
+    // Validates that the issuer in the ID Token matches that of the discovery document.
+    NSURL *issuer = tokenResponse.request.configuration.issuer;
+    if (issuer && ![idToken.issuer isEqual:issuer]) {
+      NSError *invalidIDToken =
+        [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:@"Issuer mismatch"];
+      return invalidIDToken;
+    }
+
+    // OpenID Connect Core Section 3.1.3.7. rule #3 & Section 2 azp Claim
+    // Validates that the aud (audience) Claim contains the client ID, or that the azp
+    // (authorized party) Claim matches the client ID.
+    NSString *clientID = tokenResponse.request.clientID;
+    if (![idToken.audience containsObject:clientID] &&
+        ![idToken.claims[@"azp"] isEqualToString:clientID]) {
+      NSError *invalidIDToken =
+        [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:@"Audience mismatch"];
+      return invalidIDToken;
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rules #4 & #5
+    // Not supported.
+
+    // OpenID Connect Core Section 3.1.3.7. rule #6
+    // As noted above, AppAuth only supports the code flow which results in direct communication
+    // of the ID Token from the Token Endpoint to the Client, so TLS server validation is relied on
+    // by default. The signature is verified by OIDIDTokenSignatureVerifier.sharedVerifier, if set,
+    // after this method returns, as fetching the key set is asynchronous.
+
+    // OpenID Connect Core Section 3.1.3.7. rules #7 & #8
+    // Not applicable. See rule #6.
+
+    // The ID Token times are compared with the server's clock, so that devices with a wrong clock
+    // don't reject valid ID Tokens.
+    OIDClock *clock = [OIDClock sharedClock];
+    NSDate *serverNow = [clock serverNow];
+
+    // OpenID Connect Core Section 3.1.3.7. rule #9
+    // Validates that the current time is before the expiry time.
+    NSTimeInterval expiresAtDifference = [idToken.expiresAt timeIntervalSinceDate:serverNow];
+    if (expiresAtDifference < -clock.expirationTolerance) {
+      NSError *invalidIDToken =
+          [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                           underlyingError:nil
+                               description:@"ID Token expired"];
+      return invalidIDToken;
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rule #10
+    // Validates that the issued at time is not more than +/- 10 minutes on the current time.
+    NSTimeInterval issuedAtDifference = [idToken.issuedAt timeIntervalSinceDate:serverNow];
+    if (fabs(issuedAtDifference) > clock.issuedAtTolerance) {
+      NSString *message =
+          [NSString stringWithFormat:@"Issued at time is more than %d seconds before or after "
+                                      "the current time",
+                                     (int)clock.issuedAtTolerance];
+      NSError *invalidIDToken =
+        [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:message];
+      return invalidIDToken;
+    }
+
+    // Only relevant for the authorization_code response type
+    if ([tokenResponse.request.grantType isEqual:OIDGrantTypeAuthorizationCode]) {
+      // OpenID Connect Core Section 3.1.3.7. rule #11
+      // Validates the nonce.
+      NSString *nonce = authorizationResponse.request.nonce;
+      if (nonce && ![idToken.nonce isEqual:nonce]) {
+        NSError *invalidIDToken =
+        [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                         underlyingError:nil
+                             description:@"Nonce mismatch"];
+        return invalidIDToken;
+      }
+    }
+    
+    // OpenID Connect Core Section 3.1.3.7. rules #12
+    // ACR is not directly supported by AppAuth.
+
+    // OpenID Connect Core Section 3.1.3.7. rules #12
+    // max_age is not directly supported by AppAuth.
+  }
+  return nil;
+}
+
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+                               callback:(OIDTokenCallback)callback {
+  return [[self class] performTokenRequest:request
+             originalAuthorizationResponse:nil
+                                   timeout:0
+                                  callback:callback];
+}
+
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+          originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
+                               callback:(OIDTokenCallback)callback {
+  return [[self class] performTokenRequest:request
+             originalAuthorizationResponse:authorizationResponse
+                                   timeout:0
+                                  callback:callback];
+}
+
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+          originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
+                                timeout:(NSTimeInterval)timeout
+                               callback:(OIDTokenCallback)callback {
+  return [[self class] performTokenRequest:request
+             originalAuthorizationResponse:authorizationResponse
+                                  priority:OIDTokenRequestPriorityNormal
+                                   timeout:timeout
+                                  callback:callback];
 }
 
-+ (void)performTokenRequest:(OIDTokenRequest *)request
-    originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
-                         callback:(OIDTokenCallback)callback {
++ (OIDNetworkTask *)performTokenRequest:(OIDTokenRequest *)request
+          originalAuthorizationResponse:(OIDAuthorizationResponse *_Nullable)authorizationResponse
+                               priority:(OIDTokenRequestPriority)priority
+                                timeout:(NSTimeInterval)timeout
+                               callback:(OIDTokenCallback)callback {
 
+  uint64_t buildTrace = OIDTraceBeginPhase(OIDTracePhaseTokenRequestBuild);
   NSURLRequest *URLRequest = [request URLRequest];
+  OIDTraceEndPhase(OIDTracePhaseTokenRequestBuild, buildTrace);
   
   AppAuthRequestTrace(@"Token Request: %@\nHeaders:%@\nHTTPBody: %@",
                       URLRequest.URL,
@@ -470,11 +771,64 @@ NS_ASSUME_NONNULL_BEGIN
                       [[NSString alloc] initWithData:URLRequest.HTTPBody
                                             encoding:NSUTF8StringEncoding]);
 
-  NSURLSession *session = [OIDURLSessionProvider session];
-  [[session dataTaskWithRequest:URLRequest
-              completionHandler:^(NSData *_Nullable data,
-                                  NSURLResponse *_Nullable response,
-                                  NSError *_Nullable error) {
+  // Fails fast while the token endpoint of the issuer is known to be failing.
+  OIDCircuitBreaker *circuitBreaker = [OIDCircuitBreaker tokenEndpointCircuitBreaker];
+  if (circuitBreaker) {
+    NSString *circuitKey = [OIDCircuitBreaker keyForConfiguration:request.configuration];
+    if (![circuitBreaker shouldAllowRequestForKey:circuitKey]) {
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Token request to '%@' not sent, as the token endpoint of "
+                                      "'%@' failed repeatedly.",
+                                     URLRequest.URL,
+                                     circuitKey];
+      NSError *returnedError =
+          [OIDErrorUtilities errorWithCode:OIDErrorCodeCircuitBreakerOpen
+                           underlyingError:nil
+                               description:errorDescription];
+      dispatch_async(dispatch_get_main_queue(), ^{
+        callback(nil, returnedError);
+      });
+      return [OIDNetworkTask finishedTask];
+    }
+    OIDTokenCallback tokenCallback = callback;
+    callback = ^(OIDTokenResponse *_Nullable tokenResponse, NSError *_Nullable error) {
+      [circuitBreaker recordRequestForKey:circuitKey completedWithError:error];
+      tokenCallback(tokenResponse, error);
+    };
+  }
+
+  OIDMetricsRequest *metricsRequest =
+      [OIDMetricsRequest requestToEndpoint:OIDMetricsEndpointToken URLRequest:URLRequest];
+  if (metricsRequest) {
+    OIDTokenCallback tokenCallback = callback;
+    callback = ^(OIDTokenResponse *_Nullable tokenResponse, NSError *_Nullable error) {
+      [metricsRequest didCompleteWithError:error];
+      tokenCallback(tokenResponse, error);
+    };
+  }
+
+  // only the first of the response, a cancellation or the deadline completes the request
+  OIDTokenCallback requestCallback = callback;
+  OIDNetworkTask *networkTask =
+      [[OIDNetworkTask alloc] initWithTimeout:timeout cancellationHandler:^(NSError *error) {
+    OIDTraceDispatchToMainQueue(^{
+      requestCallback(nil, error);
+    });
+  }];
+  callback = ^(OIDTokenResponse *_Nullable tokenResponse, NSError *_Nullable error) {
+    if ([networkTask finish]) {
+      requestCallback(tokenResponse, error);
+    }
+  };
+
+  void (^processResponse)(NSData *_Nullable, NSURLResponse *_Nullable, NSError *_Nullable) =
+      ^(NSData *_Nullable data, NSURLResponse *_Nullable response, NSError *_Nullable error) {
+    if (networkTask.isCancelled) {
+      // the callback already has its error, so the response is not worth processing
+      return;
+    }
+    [metricsRequest didReceiveData:data];
+
     if (error) {
       // A network error or server error occurred.
       NSString *errorDescription =
@@ -485,13 +839,14 @@ NS_ASSUME_NONNULL_BEGIN
           [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
                            underlyingError:error
                                description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         callback(nil, returnedError);
       });
       return;
     }
 
     NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
+    [[OIDClock sharedClock] updateServerTimeOffsetWithHTTPResponse:HTTPURLResponse];
     NSInteger statusCode = HTTPURLResponse.statusCode;
     AppAuthRequestTrace(@"Token Response: HTTP Status %d\nHTTPBody: %@",
                         (int)statusCode,
@@ -514,7 +869,7 @@ NS_ASSUME_NONNULL_BEGIN
             [OIDErrorUtilities OAuthErrorWithDomain:OIDOAuthTokenErrorDomain
                                       OAuthResponse:json
                                     underlyingError:serverError];
-          dispatch_async(dispatch_get_main_queue(), ^{
+          OIDTraceDispatchToMainQueue(^{
             callback(nil, oauthError);
           });
           return;
@@ -530,15 +885,17 @@ NS_ASSUME_NONNULL_BEGIN
           [OIDErrorUtilities errorWithCode:OIDErrorCodeServerError
                            underlyingError:serverError
                                description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         callback(nil, returnedError);
       });
       return;
     }
 
     NSError *jsonDeserializationError;
+    uint64_t parseTrace = OIDTraceBeginPhase(OIDTracePhaseJSONParse);
     NSDictionary<NSString *, NSObject<NSCopying> *> *json =
         [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonDeserializationError];
+    OIDTraceEndPhase(OIDTracePhaseJSONParse, parseTrace);
     if (jsonDeserializationError) {
       // A problem occurred deserializing the response/JSON.
       NSString *errorDescription =
@@ -548,160 +905,130 @@ NS_ASSUME_NONNULL_BEGIN
           [OIDErrorUtilities errorWithCode:OIDErrorCodeJSONDeserializationError
                            underlyingError:jsonDeserializationError
                                description:errorDescription];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         callback(nil, returnedError);
       });
       return;
     }
 
+    uint64_t mappingTrace = OIDTraceBeginPhase(OIDTracePhaseFieldMapping);
     OIDTokenResponse *tokenResponse =
         [[OIDTokenResponse alloc] initWithRequest:request parameters:json];
+    OIDTraceEndPhase(OIDTracePhaseFieldMapping, mappingTrace);
     if (!tokenResponse) {
       // A problem occurred constructing the token response from the JSON.
       NSError *returnedError =
           [OIDErrorUtilities errorWithCode:OIDErrorCodeTokenResponseConstructionError
                            underlyingError:jsonDeserializationError
                                description:@"Token response invalid."];
-      dispatch_async(dispatch_get_main_queue(), ^{
+      OIDTraceDispatchToMainQueue(^{
         callback(nil, returnedError);
       });
       return;
     }
 
-    // If an ID Token is included in the response, validates the ID Token following the rules
-    // in OpenID Connect Core Section 3.1.3.7 for features that AppAuth directly supports
-    // (which excludes rules #1, #4, #5, #7, #8, #12, and #13). Regarding rule #6, ID Tokens
-    // received by this class are received via direct communication between the Client and the Token
-    // Endpoint, thus we are exercising the option to rely only on the TLS validation. AppAuth
-    // has a zero dependencies policy, and verifying the JWT signature would add a dependency.
-    // Users of the library are welcome to perform the JWT signature verification themselves should
-    // they wish.
-    if (tokenResponse.idToken) {
-      OIDIDToken *idToken = [[OIDIDToken alloc] initWithIDTokenString:tokenResponse.idToken];
-      if (!idToken) {
-        NSError *invalidIDToken =
-          [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenParsingError
-                           underlyingError:nil
-                               description:@"ID Token parsing failed"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rule #1
-      // Not supported: AppAuth does not support JWT encryption.
-
-      // OpenID Connect Core Section 3.1.3.7. rule #2
-      // Validates that the issuer in the ID Token matches that of the discovery document.
-      NSURL *issuer = tokenResponse.request.configuration.issuer;
-      if (issuer && ![idToken.issuer isEqual:issuer]) {
-        NSError *invalidIDToken =
-          [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:@"Issuer mismatch"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
+    uint64_t validationTrace = OIDTraceBeginPhase(OIDTracePhaseIDTokenValidation);
+    NSError *invalidIDToken =
+        [self validateIDTokenInTokenResponse:tokenResponse
+               originalAuthorizationResponse:authorizationResponse];
+    OIDTraceEndPhase(OIDTracePhaseIDTokenValidation, validationTrace);
+    if (invalidIDToken) {
+      OIDTraceDispatchToMainQueue(^{
+        callback(nil, invalidIDToken);
+      });
+      return;
+    }
 
-      // OpenID Connect Core Section 3.1.3.7. rule #3 & Section 2 azp Claim
-      // Validates that the aud (audience) Claim contains the client ID, or that the azp
-      // (authorized party) Claim matches the client ID.
-      NSString *clientID = tokenResponse.request.clientID;
-      if (![idToken.audience containsObject:clientID] &&
-          ![idToken.claims[@"azp"] isEqualToString:clientID]) {
-        NSError *invalidIDToken =
-          [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:@"Audience mismatch"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rules #4 & #5
-      // Not supported.
-
-      // OpenID Connect Core Section 3.1.3.7. rule #6
-      // As noted above, AppAuth only supports the code flow which results in direct communication
-      // of the ID Token from the Token Endpoint to the Client, and we are exercising the option to
-      // use TSL server validation instead of checking the token signature. Users may additionally
-      // check the token signature should they wish.
-
-      // OpenID Connect Core Section 3.1.3.7. rules #7 & #8
-      // Not applicable. See rule #6.
-
-      // OpenID Connect Core Section 3.1.3.7. rule #9
-      // Validates that the current time is before the expiry time.
-      NSTimeInterval expiresAtDifference = [idToken.expiresAt timeIntervalSinceNow];
-      if (expiresAtDifference < 0) {
-        NSError *invalidIDToken =
-            [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
-                             underlyingError:nil
-                                 description:@"ID Token expired"];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
+    // Verifies the signature of the ID Token, if enabled and the discovery document provides the
+    // key set. Configurations built by hand have no key set, and rely on TLS only.
+    OIDIDTokenSignatureVerifier *signatureVerifier = [OIDIDTokenSignatureVerifier sharedVerifier];
+    NSURL *JWKSURL = request.configuration.discoveryDocument.jwksURL;
+    if (signatureVerifier && JWKSURL && tokenResponse.idToken) {
+      [signatureVerifier verifyIDToken:tokenResponse.idToken
+                               JWKSURL:JWKSURL
+                            completion:^(NSError *_Nullable signatureError) {
+        OIDTraceDispatchToMainQueue(^{
+          if (signatureError) {
+            callback(nil, signatureError);
+          } else {
+            callback(tokenResponse, nil);
+          }
         });
-        return;
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rule #10
-      // Validates that the issued at time is not more than +/- 10 minutes on the current time.
-      NSTimeInterval issuedAtDifference = [idToken.issuedAt timeIntervalSinceNow];
-      if (fabs(issuedAtDifference) > kOIDAuthorizationSessionIATMaxSkew) {
-        NSString *message =
-            [NSString stringWithFormat:@"Issued at time is more than %d seconds before or after "
-                                        "the current time",
-                                       kOIDAuthorizationSessionIATMaxSkew];
-        NSError *invalidIDToken =
-          [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:message];
-        dispatch_async(dispatch_get_main_queue(), ^{
-          callback(nil, invalidIDToken);
-        });
-        return;
-      }
-
-      // Only relevant for the authorization_code response type
-      if ([tokenResponse.request.grantType isEqual:OIDGrantTypeAuthorizationCode]) {
-        // OpenID Connect Core Section 3.1.3.7. rule #11
-        // Validates the nonce.
-        NSString *nonce = authorizationResponse.request.nonce;
-        if (nonce && ![idToken.nonce isEqual:nonce]) {
-          NSError *invalidIDToken =
-          [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
-                           underlyingError:nil
-                               description:@"Nonce mismatch"];
-          dispatch_async(dispatch_get_main_queue(), ^{
-            callback(nil, invalidIDToken);
-          });
-          return;
-        }
-      }
-      
-      // OpenID Connect Core Section 3.1.3.7. rules #12
-      // ACR is not directly supported by AppAuth.
-
-      // OpenID Connect Core Section 3.1.3.7. rules #12
-      // max_age is not directly supported by AppAuth.
+      }];
+      return;
     }
 
     // Success
-    dispatch_async(dispatch_get_main_queue(), ^{
+    OIDTraceDispatchToMainQueue(^{
       callback(tokenResponse, nil);
     });
-  }] resume];
+  };
+
+  OIDScheduledTokenRequest *scheduledRequest =
+      [[OIDScheduledTokenRequest alloc] initWithPriority:priority
+                                            startHandler:^(OIDScheduledTokenRequest *request) {
+    if (networkTask.isCancelled) {
+      // cancelled, or past its deadline, while waiting in the scheduler
+      [request complete];
+      return;
+    }
+    uint64_t networkTrace = OIDTraceBeginPhase(OIDTracePhaseNetworkWait);
+    NSURLSession *session = [OIDURLSessionProvider session];
+    NSURLSessionDataTask *task =
+        [session dataTaskWithRequest:URLRequest
+                   completionHandler:^(NSData *_Nullable data,
+                                       NSURLResponse *_Nullable response,
+                                       NSError *_Nullable error) {
+      OIDTraceEndPhase(OIDTracePhaseNetworkWait, networkTrace);
+      [request complete];
+      // processed at the quality of service of the request, rather than in turn on the queue of
+      // the session, where responses to background requests would delay interactive ones
+      qos_class_t QOSClass = [OIDTokenRequestScheduler QOSClassForPriority:request.priority];
+      dispatch_async(dispatch_get_global_queue(QOSClass, 0), ^{
+        processResponse(data, response, error);
+      });
+    }];
+    [request setSessionTask:task];
+    [networkTask setSessionTask:task];
+    [task resume];
+  }];
+  [networkTask setScheduledRequest:scheduledRequest];
+  [scheduledRequest startWithScheduler:[OIDTokenRequestScheduler sharedScheduler]];
+  return networkTask;
 }
 
++ (void)prewarmConnectionForConfiguration:(OIDServiceConfiguration *)configuration {
+  NSMutableURLRequest *URLRequest =
+      [NSMutableURLRequest requestWithURL:configuration.tokenEndpoint
+                              cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                          timeoutInterval:kOIDPrewarmConnectionTimeout];
+  URLRequest.HTTPMethod = @"HEAD";
+
+  AppAuthRequestTrace(@"Pre-warm Request: %@", URLRequest.URL);
+
+  NSURLSession *session = [OIDURLSessionProvider session];
+  NSURLSessionDataTask *task =
+      [session dataTaskWithRequest:URLRequest
+                 completionHandler:^(NSData *_Nullable data,
+                                     NSURLResponse *_Nullable response,
+                                     NSError *_Nullable error) {
+    // Only the established connection matters, the response itself (often a 405) is ignored.
+    AppAuthRequestTrace(@"Pre-warm Response: %@ error: %@", response, error);
+  }];
+  task.priority = NSURLSessionTaskPriorityLow;
+  [task resume];
+}
 
 #pragma mark - Registration Endpoint
 
-+ (void)performRegistrationRequest:(OIDRegistrationRequest *)request
-                          completion:(OIDRegistrationCompletion)completion {
++ (OIDNetworkTask *)performRegistrationRequest:(OIDRegistrationRequest *)request
+                                    completion:(OIDRegistrationCompletion)completion {
+  return [[self class] performRegistrationRequest:request timeout:0 completion:completion];
+}
+
++ (OIDNetworkTask *)performRegistrationRequest:(OIDRegistrationRequest *)request
+                                       timeout:(NSTimeInterval)timeout
+                                    completion:(OIDRegistrationCompletion)completion {
   NSURLRequest *URLRequest = [request URLRequest];
   if (!URLRequest) {
     // A problem occurred deserializing the response/JSON.
@@ -712,14 +1039,44 @@ NS_ASSUME_NONNULL_BEGIN
     dispatch_async(dispatch_get_main_queue(), ^{
       completion(nil, returnedError);
     });
-    return;
+    return [OIDNetworkTask finishedTask];
   }
 
+  OIDMetricsRequest *metricsRequest =
+      [OIDMetricsRequest requestToEndpoint:OIDMetricsEndpointRegistration URLRequest:URLRequest];
+  if (metricsRequest) {
+    OIDRegistrationCompletion registrationCompletion = completion;
+    completion = ^(OIDRegistrationResponse *_Nullable response, NSError *_Nullable error) {
+      [metricsRequest didCompleteWithError:error];
+      registrationCompletion(response, error);
+    };
+  }
+
+  // only the first of the response, a cancellation or the deadline completes the request
+  OIDRegistrationCompletion requestCompletion = completion;
+  OIDNetworkTask *networkTask =
+      [[OIDNetworkTask alloc] initWithTimeout:timeout cancellationHandler:^(NSError *error) {
+    dispatch_async(dispatch_get_main_queue(), ^{
+      requestCompletion(nil, error);
+    });
+  }];
+  completion = ^(OIDRegistrationResponse *_Nullable response, NSError *_Nullable error) {
+    if ([networkTask finish]) {
+      requestCompletion(response, error);
+    }
+  };
+
   NSURLSession *session = [OIDURLSessionProvider session];
-  [[session dataTaskWithRequest:URLRequest
-              completionHandler:^(NSData *_Nullable data,
-                                  NSURLResponse *_Nullable response,
-                                  NSError *_Nullable error) {
+  NSURLSessionDataTask *task =
+      [session dataTaskWithRequest:URLRequest
+                 completionHandler:^(NSData *_Nullable data,
+                                     NSURLResponse *_Nullable response,
+                                     NSError *_Nullable error) {
+    if (networkTask.isCancelled) {
+      // the completion already has its error, so the response is not worth processing
+      return;
+    }
+    [metricsRequest didReceiveData:data];
     if (error) {
       // A network error or server error occurred.
       NSString *errorDescription =
@@ -814,7 +1171,10 @@ NS_ASSUME_NONNULL_BEGIN
     dispatch_async(dispatch_get_main_queue(), ^{
       completion(registrationResponse, nil);
     });
-  }] resume];
+  }];
+  [networkTask setSessionTask:task];
+  [task resume];
+  return networkTask;
 }
 
 @end
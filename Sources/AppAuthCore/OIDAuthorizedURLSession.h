@@ -0,0 +1,109 @@
+/*! @file OIDAuthorizedURLSession.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The latency breakdown of a request performed by @c OIDAuthorizedURLSession.
+ */
+@interface OIDAuthorizedRequestMetrics : NSObject
+
+/*! @brief The time spent waiting for a fresh access token, including any token refresh, summed
+        over all attempts. Zero when the access token was fresh for every attempt.
+ */
+@property(nonatomic, readonly) NSTimeInterval tokenWaitDuration;
+
+/*! @brief The time spent waiting for responses from the resource server, summed over all attempts.
+ */
+@property(nonatomic, readonly) NSTimeInterval networkDuration;
+
+/*! @brief The time from the call to @c OIDAuthorizedURLSession.performRequest:completion: until its
+        completion was called.
+ */
+@property(nonatomic, readonly) NSTimeInterval totalDuration;
+
+/*! @brief The number of times the request was sent: 2 when it was replayed after a 401 response,
+        1 otherwise, and 0 when no access token could be obtained.
+ */
+@property(nonatomic, readonly) NSUInteger attempts;
+
+/*! @brief Whether the request had to wait for a token refresh before one of its attempts.
+ */
+@property(nonatomic, readonly) BOOL waitedForTokenRefresh;
+
+@end
+
+/*! @brief The type of block called when a request of @c OIDAuthorizedURLSession completes.
+    @param data The body of the response, if any.
+    @param response The response, if any.
+    @param metrics The latency breakdown of the request.
+    @param error The error, if the request failed or no access token could be obtained.
+ */
+typedef void (^OIDAuthorizedRequestCompletion)(NSData *_Nullable data,
+                                               NSURLResponse *_Nullable response,
+                                               OIDAuthorizedRequestMetrics *metrics,
+                                               NSError *_Nullable error);
+
+/*! @brief Performs requests to a resource server with the access token of an @c OIDAuthState.
+    @discussion When the access token is fresh it is attached as a bearer token before the request
+        is sent, without any queue hop. Otherwise the request is parked in the pending actions of
+        the @c OIDAuthState, so requests made during a refresh share that single refresh and no
+        thread is blocked while waiting for it. Requests which fail with a 401 response are
+        replayed exactly once with a refreshed token; concurrent 401 responses for the same access
+        token cause a single refresh.
+ */
+@interface OIDAuthorizedURLSession : NSObject
+
+/*! @brief The authorization state whose access token is attached to requests.
+ */
+@property(nonatomic, readonly) OIDAuthState *authState;
+
+/*! @brief The session which performs the requests.
+ */
+@property(nonatomic, readonly) NSURLSession *session;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithAuthState:session:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Creates an instance which performs requests with the @c OIDURLSessionProvider session.
+    @param authState The authorization state whose access token is attached to requests.
+ */
+- (instancetype)initWithAuthState:(OIDAuthState *)authState;
+
+/*! @brief Designated initializer.
+    @param authState The authorization state whose access token is attached to requests.
+    @param session The session which performs the requests.
+ */
+- (instancetype)initWithAuthState:(OIDAuthState *)authState
+                          session:(NSURLSession *)session NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Performs a request with a fresh access token attached as a bearer token.
+    @param request The request. Any @c Authorization header it has is replaced.
+    @param completion Called once the request completes, on an unspecified queue.
+ */
+- (void)performRequest:(NSURLRequest *)request
+            completion:(OIDAuthorizedRequestCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,168 @@
+/*! @file OIDAuthorizedURLSession.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDAuthorizedURLSession.h"
+
+#import "OIDAuthState.h"
+#import "OIDDefines.h"
+#import "OIDURLSessionProvider.h"
+
+/*! @brief The header which carries the access token.
+ */
+static NSString *const kHTTPAuthorizationHeaderKey = @"Authorization";
+
+/*! @brief The format of the value of the @c Authorization header.
+ */
+static NSString *const kBearerAuthorizationFormat = @"Bearer %@";
+
+/*! @brief The status code of responses to requests whose access token was rejected.
+ */
+static NSInteger const kHTTPStatusCodeUnauthorized = 401;
+
+/*! @brief The number of times a request is sent at most.
+ */
+static NSUInteger const kMaximumAttempts = 2;
+
+@interface OIDAuthorizedRequestMetrics ()
+
+@property(nonatomic, readwrite) NSTimeInterval tokenWaitDuration;
+@property(nonatomic, readwrite) NSTimeInterval networkDuration;
+@property(nonatomic, readwrite) NSTimeInterval totalDuration;
+@property(nonatomic, readwrite) NSUInteger attempts;
+@property(nonatomic, readwrite) BOOL waitedForTokenRefresh;
+
+@end
+
+@implementation OIDAuthorizedRequestMetrics
+@end
+
+@implementation OIDAuthorizedURLSession
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithAuthState:session:))
+
+- (instancetype)initWithAuthState:(OIDAuthState *)authState {
+  return [self initWithAuthState:authState session:[OIDURLSessionProvider session]];
+}
+
+- (instancetype)initWithAuthState:(OIDAuthState *)authState session:(NSURLSession *)session {
+  self = [super init];
+  if (self) {
+    _authState = authState;
+    _session = session;
+  }
+  return self;
+}
+
+- (void)performRequest:(NSURLRequest *)request
+            completion:(OIDAuthorizedRequestCompletion)completion {
+  OIDAuthorizedRequestMetrics *metrics = [[OIDAuthorizedRequestMetrics alloc] init];
+  CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+  [self performAttempt:1
+             ofRequest:request
+               metrics:metrics
+            completion:^(NSData *_Nullable data,
+                         NSURLResponse *_Nullable response,
+                         OIDAuthorizedRequestMetrics *requestMetrics,
+                         NSError *_Nullable error) {
+    requestMetrics.totalDuration = CFAbsoluteTimeGetCurrent() - start;
+    completion(data, response, requestMetrics, error);
+  }];
+}
+
+/*! @brief Sends the request once a fresh access token is available.
+    @discussion A fresh access token is attached on the calling thread. Otherwise the attempt is
+        parked in the pending actions of the @c OIDAuthState until the refresh completes, and
+        resumes on a global queue rather than the main queue.
+ */
+- (void)performAttempt:(NSUInteger)attempt
+             ofRequest:(NSURLRequest *)request
+               metrics:(OIDAuthorizedRequestMetrics *)metrics
+            completion:(OIDAuthorizedRequestCompletion)completion {
+  NSString *accessToken = [_authState freshAccessToken];
+  if (accessToken) {
+    [self sendAttempt:attempt
+            ofRequest:request
+      withAccessToken:accessToken
+              metrics:metrics
+           completion:completion];
+    return;
+  }
+
+  metrics.waitedForTokenRefresh = YES;
+  CFAbsoluteTime waitStart = CFAbsoluteTimeGetCurrent();
+  [_authState performActionWithFreshTokens:^(NSString *_Nullable freshAccessToken,
+                                             NSString *_Nullable idToken,
+                                             NSError *_Nullable error) {
+    metrics.tokenWaitDuration += CFAbsoluteTimeGetCurrent() - waitStart;
+    if (!freshAccessToken) {
+      completion(nil, nil, metrics, error);
+      return;
+    }
+    [self sendAttempt:attempt
+            ofRequest:request
+      withAccessToken:freshAccessToken
+              metrics:metrics
+           completion:completion];
+  }
+                       additionalRefreshParameters:nil
+                                     dispatchQueue:dispatch_get_global_queue(
+                                         DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
+}
+
+/*! @brief Sends the request with the access token attached, and replays it once if the access
+        token is rejected.
+ */
+- (void)sendAttempt:(NSUInteger)attempt
+          ofRequest:(NSURLRequest *)request
+    withAccessToken:(NSString *)accessToken
+            metrics:(OIDAuthorizedRequestMetrics *)metrics
+         completion:(OIDAuthorizedRequestCompletion)completion {
+  NSMutableURLRequest *authorizedRequest = [request mutableCopy];
+  [authorizedRequest setValue:[NSString stringWithFormat:kBearerAuthorizationFormat, accessToken]
+           forHTTPHeaderField:kHTTPAuthorizationHeaderKey];
+  metrics.attempts = attempt;
+  CFAbsoluteTime sendStart = CFAbsoluteTimeGetCurrent();
+  NSURLSessionDataTask *task =
+      [_session dataTaskWithRequest:authorizedRequest
+                  completionHandler:^(NSData *_Nullable data,
+                                      NSURLResponse *_Nullable response,
+                                      NSError *_Nullable error) {
+    metrics.networkDuration += CFAbsoluteTimeGetCurrent() - sendStart;
+    NSHTTPURLResponse *HTTPResponse =
+        [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+    if (HTTPResponse.statusCode != kHTTPStatusCodeUnauthorized || attempt >= kMaximumAttempts) {
+      completion(data, response, metrics, error);
+      return;
+    }
+
+    // Only a 401 for the current access token forces a refresh. Requests which were sent with the
+    // same token and are rejected after it was replaced are replayed with the new token. Refreshes
+    // update the state on the main queue, so comparing the token there cannot race with them.
+    dispatch_async(dispatch_get_main_queue(), ^{
+      OIDAuthState *authState = self->_authState;
+      if ([accessToken isEqualToString:authState.accessToken]) {
+        [authState setNeedsTokenRefresh];
+      }
+      [self performAttempt:attempt + 1 ofRequest:request metrics:metrics completion:completion];
+    });
+  }];
+  [task resume];
+}
+
+@end
@@ -0,0 +1,122 @@
+/*! @file OIDCircuitBreaker.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDServiceConfiguration;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The states of the circuit of an issuer.
+ */
+typedef NS_ENUM(NSInteger, OIDCircuitBreakerState) {
+  /*! @brief Requests are sent normally.
+   */
+  OIDCircuitBreakerStateClosed = 0,
+
+  /*! @brief Requests fail immediately, without being sent.
+   */
+  OIDCircuitBreakerStateOpen = 1,
+
+  /*! @brief A single probe request is allowed, which closes the circuit if it succeeds and opens
+          it again if it fails. Other requests fail immediately.
+   */
+  OIDCircuitBreakerStateHalfOpen = 2,
+};
+
+/*! @brief Stops sending requests to an issuer whose endpoint keeps failing, to avoid amplifying
+        outages and wasting battery.
+    @discussion After @c failureThreshold consecutive network errors or HTTP 5xx responses from an
+        issuer, its circuit opens and requests fail immediately with
+        @c ::OIDErrorCodeCircuitBreakerOpen. Once @c openInterval has passed, the next request is
+        sent as a probe: if it succeeds the circuit closes, otherwise it opens again. Any response
+        from the server other than a 5xx, including OAuth errors, counts as a success.
+
+        Set @c tokenEndpointCircuitBreaker to protect token requests made through
+        @c OIDAuthorizationService, including the token refreshes of every @c OIDAuthState. Each
+        issuer has its own circuit, shared by all requests to it.
+ */
+@interface OIDCircuitBreaker : NSObject
+
+/*! @brief The number of consecutive failures which open a circuit.
+ */
+@property(nonatomic, readonly) NSUInteger failureThreshold;
+
+/*! @brief How long a circuit stays open before a probe request is allowed, in seconds.
+ */
+@property(nonatomic, readonly) NSTimeInterval openInterval;
+
+/*! @brief Returns the current date. Defaults to returning @c OIDClock.sharedClock.now. Tests can
+        substitute a virtual clock.
+ */
+@property(nonatomic, copy, null_resettable) NSDate *(^currentDate)(void);
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithFailureThreshold:openInterval:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param failureThreshold The number of consecutive failures which open a circuit.
+    @param openInterval How long a circuit stays open before a probe request is allowed.
+ */
+- (instancetype)initWithFailureThreshold:(NSUInteger)failureThreshold
+                            openInterval:(NSTimeInterval)openInterval NS_DESIGNATED_INITIALIZER;
+
+/*! @brief The circuit breaker used for requests to token endpoints, if any. Defaults to nil.
+ */
++ (nullable OIDCircuitBreaker *)tokenEndpointCircuitBreaker;
+
+/*! @brief Sets the circuit breaker used for requests to token endpoints.
+    @param circuitBreaker The circuit breaker, or nil to send every request.
+ */
++ (void)setTokenEndpointCircuitBreaker:(nullable OIDCircuitBreaker *)circuitBreaker;
+
+/*! @brief Returns the key of the circuit for requests made with a service configuration: its
+        issuer, or its token endpoint if the issuer is unknown.
+    @param configuration The service configuration.
+ */
++ (NSString *)keyForConfiguration:(OIDServiceConfiguration *)configuration;
+
+/*! @brief Determines whether a request may be sent. Every request allowed must be followed by a
+        call to @c recordRequestForKey:completedWithError:.
+    @param key The key of the circuit.
+    @return YES if the circuit is closed, or if the request is the probe of a half-open circuit.
+ */
+- (BOOL)shouldAllowRequestForKey:(NSString *)key;
+
+/*! @brief Records the outcome of a request which was allowed.
+    @param key The key of the circuit.
+    @param error The error the request failed with, if any.
+    @discussion A request cancelled by its caller leaves the circuit as it was. If it was the probe
+        of a half-open circuit, the circuit stays open and the next request is allowed as a probe.
+ */
+- (void)recordRequestForKey:(NSString *)key completedWithError:(nullable NSError *)error;
+
+/*! @brief Returns the state of a circuit.
+    @param key The key of the circuit.
+ */
+- (OIDCircuitBreakerState)stateForKey:(NSString *)key;
+
+/*! @brief Closes every circuit.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
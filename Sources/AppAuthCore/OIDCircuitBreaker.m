@@ -0,0 +1,196 @@
+/*! @file OIDCircuitBreaker.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDCircuitBreaker.h"
+
+#import "OIDClock.h"
+#import "OIDDefines.h"
+#import "OIDError.h"
+#import "OIDServiceConfiguration.h"
+
+/*! @brief The circuit breaker used for requests to token endpoints. Guarded by @synchronized on
+        @c OIDCircuitBreaker.
+ */
+static OIDCircuitBreaker *gTokenEndpointCircuitBreaker;
+
+/*! @brief The state of the circuit of one issuer.
+ */
+@interface OIDCircuit : NSObject
+
+/*! @brief The number of consecutive failures.
+ */
+@property(nonatomic) NSUInteger consecutiveFailures;
+
+/*! @brief When the circuit last opened, if it is open.
+ */
+@property(nonatomic, nullable) NSDate *openedDate;
+
+/*! @brief Whether a probe request of the half-open circuit is in flight.
+ */
+@property(nonatomic) BOOL probeInFlight;
+
+@end
+
+@implementation OIDCircuit
+@end
+
+@implementation OIDCircuitBreaker {
+  /*! @brief The circuits by key. Guarded by @synchronized on self.
+   */
+  NSMutableDictionary<NSString *, OIDCircuit *> *_circuits;
+}
+
+@synthesize currentDate = _currentDate;
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithFailureThreshold:openInterval:))
+
+- (instancetype)initWithFailureThreshold:(NSUInteger)failureThreshold
+                            openInterval:(NSTimeInterval)openInterval {
+  self = [super init];
+  if (self) {
+    _failureThreshold = MAX(failureThreshold, 1);
+    _openInterval = openInterval;
+    _circuits = [NSMutableDictionary dictionary];
+  }
+  return self;
+}
+
++ (nullable OIDCircuitBreaker *)tokenEndpointCircuitBreaker {
+  @synchronized([OIDCircuitBreaker class]) {
+    return gTokenEndpointCircuitBreaker;
+  }
+}
+
++ (void)setTokenEndpointCircuitBreaker:(nullable OIDCircuitBreaker *)circuitBreaker {
+  @synchronized([OIDCircuitBreaker class]) {
+    gTokenEndpointCircuitBreaker = circuitBreaker;
+  }
+}
+
++ (NSString *)keyForConfiguration:(OIDServiceConfiguration *)configuration {
+  return configuration.issuer.absoluteString ?: configuration.tokenEndpoint.absoluteString;
+}
+
+- (NSDate *(^)(void))currentDate {
+  if (_currentDate) {
+    return _currentDate;
+  }
+  return ^{
+    return [[OIDClock sharedClock] now];
+  };
+}
+
+/*! @brief Returns whether an error reports a request cancelled by its caller, which tells nothing
+        about the server.
+ */
++ (BOOL)isCancellation:(nullable NSError *)error {
+  if (![error.domain isEqualToString:OIDGeneralErrorDomain] ||
+      error.code != OIDErrorCodeNetworkError) {
+    return NO;
+  }
+  NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+  return [underlyingError.domain isEqualToString:NSURLErrorDomain] &&
+      underlyingError.code == NSURLErrorCancelled;
+}
+
+/*! @brief Returns whether an error counts as a failure of the server. Cancellations are neither
+        failures nor successes.
+ */
++ (BOOL)isFailure:(nullable NSError *)error {
+  if (![error.domain isEqualToString:OIDGeneralErrorDomain]) {
+    return NO;
+  }
+  NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+  if (error.code == OIDErrorCodeNetworkError) {
+    return ![self isCancellation:error];
+  }
+  if (error.code == OIDErrorCodeServerError) {
+    return [underlyingError.domain isEqualToString:OIDHTTPErrorDomain] &&
+        underlyingError.code >= 500 && underlyingError.code < 600;
+  }
+  return NO;
+}
+
+/*! @brief Returns whether an open circuit has been open for @c openInterval. Must be called while
+        synchronized on self.
+ */
+- (BOOL)hasOpenIntervalElapsedForCircuit:(OIDCircuit *)circuit {
+  return [self.currentDate() timeIntervalSinceDate:circuit.openedDate] >= _openInterval;
+}
+
+- (BOOL)shouldAllowRequestForKey:(NSString *)key {
+  @synchronized(self) {
+    OIDCircuit *circuit = _circuits[key];
+    if (!circuit.openedDate) {
+      return YES;
+    }
+    if (circuit.probeInFlight || ![self hasOpenIntervalElapsedForCircuit:circuit]) {
+      return NO;
+    }
+    circuit.probeInFlight = YES;
+    return YES;
+  }
+}
+
+- (void)recordRequestForKey:(NSString *)key completedWithError:(nullable NSError *)error {
+  BOOL cancellation = [[self class] isCancellation:error];
+  BOOL failure = [[self class] isFailure:error];
+  @synchronized(self) {
+    OIDCircuit *circuit = _circuits[key];
+    if (cancellation) {
+      // the server never answered, so the circuit stays as it was, letting another probe through
+      circuit.probeInFlight = NO;
+      return;
+    }
+    if (!failure) {
+      [_circuits removeObjectForKey:key];
+      return;
+    }
+    if (!circuit) {
+      circuit = [[OIDCircuit alloc] init];
+      _circuits[key] = circuit;
+    }
+    circuit.consecutiveFailures++;
+    if (circuit.probeInFlight || circuit.consecutiveFailures >= _failureThreshold) {
+      circuit.openedDate = self.currentDate();
+      circuit.probeInFlight = NO;
+    }
+  }
+}
+
+- (OIDCircuitBreakerState)stateForKey:(NSString *)key {
+  @synchronized(self) {
+    OIDCircuit *circuit = _circuits[key];
+    if (!circuit.openedDate) {
+      return OIDCircuitBreakerStateClosed;
+    }
+    if (circuit.probeInFlight || [self hasOpenIntervalElapsedForCircuit:circuit]) {
+      return OIDCircuitBreakerStateHalfOpen;
+    }
+    return OIDCircuitBreakerStateOpen;
+  }
+}
+
+- (void)reset {
+  @synchronized(self) {
+    [_circuits removeAllObjects];
+  }
+}
+
+@end
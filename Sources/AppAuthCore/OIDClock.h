@@ -0,0 +1,97 @@
+/*! @file OIDClock.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The time source and clock skew policy used to interpret token lifetimes.
+    @discussion Durations received from the server, such as @c expires_in, are converted to dates
+        with @c now, and @c OIDAuthState compares them with @c now. Absolute times issued by the
+        server, such as the @c iat and @c exp claims of ID Tokens, are instead compared with
+        @c serverNow: @c now corrected by the offset of the server's clock, which is learned from
+        the @c Date header of token endpoint responses. This way devices whose clock is wrong don't
+        reject valid ID Tokens and start the authorization flow again.
+
+        Configure the shared clock before making requests; apart from @c serverTimeOffset, its
+        properties are not meant to change while requests are in flight.
+ */
+@interface OIDClock : NSObject
+
+/*! @brief Returns the current local date. Defaults to returning @c NSDate.date. Tests can
+        substitute a virtual clock.
+ */
+@property(nonatomic, copy, null_resettable) NSDate *(^currentDate)(void);
+
+/*! @brief The difference between the server's clock and the local clock, in seconds. Defaults to
+        0, and is updated by @c updateServerTimeOffsetWithHTTPResponse:.
+ */
+@property(atomic) NSTimeInterval serverTimeOffset;
+
+/*! @brief Whether @c serverTimeOffset is learned from the @c Date header of token endpoint
+        responses. Defaults to YES.
+ */
+@property(nonatomic) BOOL learnsServerTimeOffset;
+
+/*! @brief How far the @c iat claim of an ID Token may be from @c serverNow, in seconds. Defaults
+        to 600.
+ */
+@property(nonatomic) NSTimeInterval issuedAtTolerance;
+
+/*! @brief How long after its @c exp claim an ID Token is still accepted, in seconds. Defaults to
+        0.
+ */
+@property(nonatomic) NSTimeInterval expirationTolerance;
+
+/*! @brief How long before its expiration an access token is refreshed, in seconds. Defaults to 60.
+ */
+@property(nonatomic) NSTimeInterval accessTokenRefreshTolerance;
+
+/*! @brief The clock used by AppAuth.
+ */
++ (OIDClock *)sharedClock;
+
+/*! @brief Sets the clock used by AppAuth.
+    @param clock The clock, or nil to restore a clock with the default configuration.
+ */
++ (void)setSharedClock:(nullable OIDClock *)clock;
+
+/*! @brief Returns the current local date.
+ */
+- (NSDate *)now;
+
+/*! @brief Returns the current date according to the server's clock.
+ */
+- (NSDate *)serverNow;
+
+/*! @brief Learns @c serverTimeOffset from the @c Date header of a response, if
+        @c learnsServerTimeOffset is YES and the response has a valid @c Date header.
+    @param HTTPURLResponse The response, which must have just been received.
+ */
+- (void)updateServerTimeOffsetWithHTTPResponse:(NSHTTPURLResponse *)HTTPURLResponse;
+
+/*! @brief Parses an HTTP date.
+    @param HTTPDate The date, in the IMF-fixdate format.
+    @return The date, or nil if it isn't a valid HTTP date.
+    @see https://tools.ietf.org/html/rfc7231#section-7.1.1.1
+ */
++ (nullable NSDate *)dateFromHTTPDate:(NSString *)HTTPDate;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,132 @@
+/*! @file OIDClock.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDClock.h"
+
+/*! @brief The default value of @c issuedAtTolerance.
+ */
+static NSTimeInterval const kDefaultIssuedAtTolerance = 600;
+
+/*! @brief The default value of @c accessTokenRefreshTolerance.
+ */
+static NSTimeInterval const kDefaultAccessTokenRefreshTolerance = 60;
+
+/*! @brief The clock used by AppAuth, if set. Guarded by @synchronized on @c OIDClock.
+ */
+static OIDClock *gSharedClock;
+
+@implementation OIDClock
+
+@synthesize currentDate = _currentDate;
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _learnsServerTimeOffset = YES;
+    _issuedAtTolerance = kDefaultIssuedAtTolerance;
+    _accessTokenRefreshTolerance = kDefaultAccessTokenRefreshTolerance;
+  }
+  return self;
+}
+
++ (OIDClock *)sharedClock {
+  @synchronized([OIDClock class]) {
+    if (!gSharedClock) {
+      gSharedClock = [[OIDClock alloc] init];
+    }
+    return gSharedClock;
+  }
+}
+
++ (void)setSharedClock:(nullable OIDClock *)clock {
+  @synchronized([OIDClock class]) {
+    gSharedClock = clock;
+  }
+}
+
+- (NSDate *(^)(void))currentDate {
+  if (_currentDate) {
+    return _currentDate;
+  }
+  return ^{
+    return [NSDate date];
+  };
+}
+
+- (NSDate *)now {
+  return self.currentDate();
+}
+
+- (NSDate *)serverNow {
+  return [self.currentDate() dateByAddingTimeInterval:self.serverTimeOffset];
+}
+
+/*! @brief Returns the value of the Date header of a response, if any.
+    @discussion Header names are case insensitive, but @c NSHTTPURLResponse.allHeaderFields is only
+        looked up case insensitively on recent OS versions.
+ */
++ (nullable NSString *)dateHeaderOfHTTPResponse:(NSHTTPURLResponse *)HTTPURLResponse {
+  NSDictionary *headers = HTTPURLResponse.allHeaderFields;
+  NSString *date = headers[@"Date"];
+  if (date) {
+    return date;
+  }
+  for (NSString *name in headers) {
+    if ([name caseInsensitiveCompare:@"Date"] == NSOrderedSame) {
+      return headers[name];
+    }
+  }
+  return nil;
+}
+
+- (void)updateServerTimeOffsetWithHTTPResponse:(NSHTTPURLResponse *)HTTPURLResponse {
+  if (!_learnsServerTimeOffset) {
+    return;
+  }
+  NSString *dateHeader = [[self class] dateHeaderOfHTTPResponse:HTTPURLResponse];
+  if (![dateHeader isKindOfClass:[NSString class]]) {
+    return;
+  }
+  NSDate *serverDate = [[self class] dateFromHTTPDate:dateHeader];
+  if (!serverDate) {
+    return;
+  }
+  self.serverTimeOffset = [serverDate timeIntervalSinceDate:self.currentDate()];
+}
+
+/*! @brief Returns the formatter for HTTP dates.
+ */
++ (NSDateFormatter *)HTTPDateFormatter {
+  static NSDateFormatter *formatter;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    formatter = [[NSDateFormatter alloc] init];
+    formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    formatter.dateFormat = @"EEE',' dd MMM yyyy HH':'mm':'ss 'GMT'";
+  });
+  return formatter;
+}
+
++ (nullable NSDate *)dateFromHTTPDate:(NSString *)HTTPDate {
+  NSString *trimmedDate =
+      [HTTPDate stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+  return [[self HTTPDateFormatter] dateFromString:trimmedDate];
+}
+
+@end
@@ -19,6 +19,7 @@
 #import "OIDEndSessionRequest.h"
 
 #import "OIDDefines.h"
+#import "OIDFieldMapping.h"
 #import "OIDTokenUtilities.h"
 #import "OIDServiceConfiguration.h"
 #import "OIDServiceDiscovery.h"
@@ -114,12 +115,9 @@ static NSString *const OIDMissingEndSessionEndpointMessage =
   NSString *idTokenHint = [aDecoder decodeObjectOfClass:[NSString class] forKey:kIdTokenHintKey];
   NSURL *postLogoutRedirectURL = [aDecoder decodeObjectOfClass:[NSURL class] forKey:kPostLogoutRedirectURLKey];
   NSString *state = [aDecoder decodeObjectOfClass:[NSString class] forKey:kStateKey];
-  NSSet *additionalParameterCodingClasses = [NSSet setWithArray:@[
-                                                                  [NSDictionary class],
-                                                                  [NSString class]
-                                                                  ]];
-  NSDictionary *additionalParameters = [aDecoder decodeObjectOfClasses:additionalParameterCodingClasses
-                           forKey:kAdditionalParametersKey];
+  NSDictionary *additionalParameters =
+      [aDecoder decodeObjectOfClasses:[OIDFieldMapping stringDictionaryTypes]
+                               forKey:kAdditionalParametersKey];
 
   self = [self initWithConfiguration:configuration
                          idTokenHint:idTokenHint
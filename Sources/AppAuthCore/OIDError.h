@@ -73,6 +73,12 @@ extern NSString *const OIDHTTPErrorDomain;
  */
 extern NSString *const OIDOAuthErrorResponseErrorKey;
 
+/*! @brief An error key for the value of the @c Retry-After header of an HTTP error response (if
+        any), in errors of the @c ::OIDHTTPErrorDomain.
+    @see https://tools.ietf.org/html/rfc7231#section-7.1.3
+ */
+extern NSString *const OIDHTTPRetryAfterErrorKey;
+
 /*! @brief The key of the 'error' response field in a RFC6749 Section 5.2 response.
     @remark error
     @see https://tools.ietf.org/html/rfc6749#section-5.2
@@ -160,6 +166,15 @@ typedef NS_ENUM(NSInteger, OIDErrorCode) {
              to (the callback was already invoked or the session was cancelled).
    */
   OIDErrorCodeInvalidAuthorizationFlow = -17,
+
+  /*! @brief The token request was not sent, as the token endpoint of the issuer failed repeatedly
+             and its @c OIDCircuitBreaker is open.
+   */
+  OIDErrorCodeCircuitBreakerOpen = -18,
+
+  /*! @brief An archived @c OIDAuthState could not be decoded.
+   */
+  OIDErrorCodeAuthStateDecodingError = -19,
 };
 
 /*! @brief Enum of all possible OAuth error codes as defined by RFC6749
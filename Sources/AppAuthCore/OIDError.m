@@ -38,6 +38,8 @@ NSString *const OIDOAuthExceptionInvalidTokenRequestNullRedirectURL = @"A OIDTok
 
 NSString *const OIDOAuthErrorResponseErrorKey = @"OIDOAuthErrorResponseErrorKey";
 
+NSString *const OIDHTTPRetryAfterErrorKey = @"OIDHTTPRetryAfterErrorKey";
+
 NSString *const OIDOAuthErrorFieldError = @"error";
 
 NSString *const OIDOAuthErrorFieldErrorDescription = @"error_description";
@@ -69,6 +69,7 @@ NS_ASSUME_NONNULL_BEGIN
     @param data The response data associated with the response which should be converted to an
         @c NSString assuming a UTF-8 encoding, if available.
     @return An \NSError representing the error.
+    @discussion Only the first 4096 bytes of @c data are decoded into the localized description.
  */
 + (NSError *)HTTPErrorWithHTTPResponse:(NSHTTPURLResponse *)HTTPURLResponse
                                   data:(nullable NSData *)data;
@@ -18,6 +18,13 @@
 
 #import "OIDErrorUtilities.h"
 
+/*! @brief The maximum number of bytes of an HTTP error response body kept in the error created by
+        @c OIDErrorUtilities.HTTPErrorWithHTTPResponse:data:.
+    @discussion Error pages served by proxies and load balancers can be large, and only the start of
+        the body is useful as an error description.
+ */
+static NSUInteger const kHTTPErrorResponseBodyMaxLength = 4096;
+
 @implementation OIDErrorUtilities
 
 + (NSError *)errorWithCode:(OIDErrorCode)code
@@ -126,12 +133,17 @@
 + (NSError *)HTTPErrorWithHTTPResponse:(NSHTTPURLResponse *)HTTPURLResponse
                                   data:(nullable NSData *)data {
   NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
-  if (data) {
-    NSString *serverResponse =
-        [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
-    if (serverResponse) {
-      userInfo[NSLocalizedDescriptionKey] = serverResponse;
-    }
+  if (data.length > kHTTPErrorResponseBodyMaxLength) {
+    // copies only the start of the body, rather than decoding all of it
+    data = [data subdataWithRange:NSMakeRange(0, kHTTPErrorResponseBodyMaxLength)];
+  }
+  NSString *serverResponse = [self stringFromResponseBody:data];
+  if (serverResponse) {
+    userInfo[NSLocalizedDescriptionKey] = serverResponse;
+  }
+  NSString *retryAfter = [self retryAfterHeaderOfHTTPResponse:HTTPURLResponse];
+  if (retryAfter) {
+    userInfo[OIDHTTPRetryAfterErrorKey] = retryAfter;
   }
   NSError *serverError =
       [NSError errorWithDomain:OIDHTTPErrorDomain
@@ -140,20 +152,60 @@
   return serverError;
 }
 
+/*! @brief Returns the value of the Retry-After header of a response, if any.
+    @discussion Header names are case insensitive, but @c NSHTTPURLResponse.allHeaderFields is only
+        looked up case insensitively on recent OS versions.
+ */
++ (nullable NSString *)retryAfterHeaderOfHTTPResponse:(NSHTTPURLResponse *)HTTPURLResponse {
+  NSDictionary *headers = HTTPURLResponse.allHeaderFields;
+  NSString *retryAfter = headers[@"Retry-After"];
+  if (retryAfter) {
+    return retryAfter;
+  }
+  for (NSString *name in headers) {
+    if ([name caseInsensitiveCompare:@"Retry-After"] == NSOrderedSame) {
+      return headers[name];
+    }
+  }
+  return nil;
+}
+
+/*! @brief Decodes a captured HTTP error response body assuming a UTF-8 encoding.
+    @param data The captured response body, which may have been cut in the middle of a multi-byte
+        character.
+    @return The decoded body, or nil if it isn't valid UTF-8.
+ */
++ (nullable NSString *)stringFromResponseBody:(nullable NSData *)data {
+  if (![data isKindOfClass:[NSData class]]) {
+    return nil;
+  }
+  NSString *serverResponse = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+  // A UTF-8 character is at most 4 bytes, so drops up to 3 bytes of a truncated trailing one.
+  for (NSUInteger dropped = 1; !serverResponse && dropped < 4 && dropped < data.length; dropped++) {
+    NSData *prefix = [data subdataWithRange:NSMakeRange(0, data.length - dropped)];
+    serverResponse = [[NSString alloc] initWithData:prefix encoding:NSUTF8StringEncoding];
+  }
+  return serverResponse;
+}
+
 + (OIDErrorCodeOAuth)OAuthErrorCodeFromString:(NSString *)errorCode {
-  NSDictionary *errorCodes = @{
-      @"invalid_request": @(OIDErrorCodeOAuthInvalidRequest),
-      @"unauthorized_client": @(OIDErrorCodeOAuthUnauthorizedClient),
-      @"access_denied": @(OIDErrorCodeOAuthAccessDenied),
-      @"unsupported_response_type": @(OIDErrorCodeOAuthUnsupportedResponseType),
-      @"invalid_scope": @(OIDErrorCodeOAuthInvalidScope),
-      @"server_error": @(OIDErrorCodeOAuthServerError),
-      @"temporarily_unavailable": @(OIDErrorCodeOAuthTemporarilyUnavailable),
-      @"invalid_client": @(OIDErrorCodeOAuthInvalidClient),
-      @"invalid_grant": @(OIDErrorCodeOAuthInvalidGrant),
-      @"unsupported_grant_type": @(OIDErrorCodeOAuthUnsupportedGrantType),
-      };
-  NSNumber *code = errorCodes[errorCode];
+  static NSDictionary<NSString *, NSNumber *> *errorCodes;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    errorCodes = @{
+        @"invalid_request": @(OIDErrorCodeOAuthInvalidRequest),
+        @"unauthorized_client": @(OIDErrorCodeOAuthUnauthorizedClient),
+        @"access_denied": @(OIDErrorCodeOAuthAccessDenied),
+        @"unsupported_response_type": @(OIDErrorCodeOAuthUnsupportedResponseType),
+        @"invalid_scope": @(OIDErrorCodeOAuthInvalidScope),
+        @"server_error": @(OIDErrorCodeOAuthServerError),
+        @"temporarily_unavailable": @(OIDErrorCodeOAuthTemporarilyUnavailable),
+        @"invalid_client": @(OIDErrorCodeOAuthInvalidClient),
+        @"invalid_grant": @(OIDErrorCodeOAuthInvalidGrant),
+        @"unsupported_grant_type": @(OIDErrorCodeOAuthUnsupportedGrantType),
+        };
+  });
+  NSNumber *code = errorCode ? errorCodes[errorCode] : nil;
   if (code) {
     return [code integerValue];
   } else {
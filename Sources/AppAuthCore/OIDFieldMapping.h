@@ -94,6 +94,8 @@ typedef _Nullable id(^OIDFieldMappingConversionFunction)(NSObject *_Nullable val
 
 /*! @brief This helper method for @c NSCoding implementations performs a deserialization of
         fields defined in a field mapping.
+    @discussion Instance variables holding objects are assigned directly rather than through
+        key-value coding, which is safe to do from several threads at once.
     @param aCoder An @c NSCoder instance from which to deserialize instance variable values from.
     @param map A mapping of keys to instance variables.
     @param instance The instance whose variables should be deserialized based on the mapping.
@@ -104,15 +106,28 @@ typedef _Nullable id(^OIDFieldMappingConversionFunction)(NSObject *_Nullable val
 
 /*! @brief Returns an @c NSSet of classes suitable for deserializing JSON content in an
         @c NSSecureCoding context.
+    @discussion The set is created once and shared by all callers.
  */
 + (NSSet *)JSONTypes;
 
+/*! @brief Returns @c JSONTypes together with @c NSNull, for deserializing JSON content which may
+        contain null values in an @c NSSecureCoding context.
+    @discussion The set is created once and shared by all callers.
+ */
++ (NSSet *)JSONTypesIncludingNull;
+
+/*! @brief Returns an @c NSSet of classes suitable for deserializing dictionaries of strings, such
+        as additional parameters and headers, in an @c NSSecureCoding context.
+    @discussion The set is created once and shared by all callers.
+ */
++ (NSSet *)stringDictionaryTypes;
+
 /*! @brief Returns a function for converting an @c NSString to an @c NSURL.
  */
 + (OIDFieldMappingConversionFunction)URLConversion;
 
 /*! @brief Returns a function for converting an @c NSNumber number of seconds from now to an
-        @c NSDate.
+        @c NSDate, where now is @c OIDClock.sharedClock.now.
  */
 + (OIDFieldMappingConversionFunction)dateSinceNowConversion;
 
@@ -18,9 +18,17 @@
 
 #import "OIDFieldMapping.h"
 
+#import <objc/runtime.h>
+#import <stdatomic.h>
+
+#import "OIDClock.h"
 #import "OIDDefines.h"
 
-@implementation OIDFieldMapping
+@implementation OIDFieldMapping {
+  /*! @brief The object instance variable named by @c name, looked up on first use.
+   */
+  _Atomic(Ivar) _ivar;
+}
 
 - (nonnull instancetype)init
     OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithName:type:conversion:))
@@ -67,7 +75,7 @@
       continue;
     }
     // Assign the instance variable.
-    [instance setValue:value forKey:mapping.name];
+    [mapping setValue:value ofInstance:instance];
   }
   return additionalParameters;
 }
@@ -76,7 +84,7 @@
                     map:(NSDictionary<NSString *, OIDFieldMapping *> *)map
                instance:(id)instance {
   for (NSString *key in map) {
-    id value = [instance valueForKey:map[key].name];
+    id value = [map[key] valueOfInstance:instance];
     [aCoder encodeObject:value forKey:key];
   }
 }
@@ -87,17 +95,82 @@
   for (NSString *key in map) {
     OIDFieldMapping *mapping = map[key];
     id value = [aCoder decodeObjectOfClass:mapping.expectedType forKey:key];
-    [instance setValue:value forKey:mapping.name];
+    [mapping setValue:value ofInstance:instance];
+  }
+}
+
+/*! @brief Returns the object instance variable named by @c name, or NULL if there is none, in which
+        case key-value coding is used instead.
+    @param instance An instance of the class the mapping belongs to.
+ */
+- (nullable Ivar)ivarOfInstance:(id)instance {
+  Ivar ivar = atomic_load_explicit(&_ivar, memory_order_acquire);
+  if (ivar) {
+    return ivar;
+  }
+  ivar = class_getInstanceVariable(object_getClass(instance), _name.UTF8String);
+  const char *typeEncoding = ivar ? ivar_getTypeEncoding(ivar) : NULL;
+  if (!typeEncoding || typeEncoding[0] != '@') {
+    return NULL;
   }
+  atomic_store_explicit(&_ivar, ivar, memory_order_release);
+  return ivar;
+}
+
+/*! @brief Assigns the instance variable directly, avoiding the accessor search of
+        @c setValue:forKey: when decoding many objects.
+ */
+- (void)setValue:(nullable id)value ofInstance:(id)instance {
+  if (@available(iOS 10.0, macOS 10.12, tvOS 10.0, watchOS 3.0, *)) {
+    Ivar ivar = [self ivarOfInstance:instance];
+    if (ivar) {
+      object_setIvarWithStrongDefault(instance, ivar, value);
+      return;
+    }
+  }
+  [instance setValue:value forKey:_name];
+}
+
+/*! @brief Returns the value of the instance variable, read directly when it holds an object.
+ */
+- (nullable id)valueOfInstance:(id)instance {
+  Ivar ivar = [self ivarOfInstance:instance];
+  return ivar ? object_getIvar(instance, ivar) : [instance valueForKey:_name];
 }
 
 + (NSSet *)JSONTypes {
-  return [NSSet setWithArray:@[
-    [NSDictionary class],
-    [NSArray class],
-    [NSString class],
-    [NSNumber class]
-  ]];
+  static NSSet *types;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    types = [NSSet setWithArray:@[
+      [NSDictionary class],
+      [NSArray class],
+      [NSString class],
+      [NSNumber class]
+    ]];
+  });
+  return types;
+}
+
++ (NSSet *)JSONTypesIncludingNull {
+  static NSSet *types;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    types = [[self JSONTypes] setByAddingObject:[NSNull class]];
+  });
+  return types;
+}
+
++ (NSSet *)stringDictionaryTypes {
+  static NSSet *types;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    types = [NSSet setWithArray:@[
+      [NSDictionary class],
+      [NSString class]
+    ]];
+  });
+  return types;
 }
 
 + (OIDFieldMappingConversionFunction)URLConversion {
@@ -115,7 +188,7 @@
       return value;
     }
     NSNumber *valueAsNumber = (NSNumber *)value;
-    return [NSDate dateWithTimeIntervalSinceNow:[valueAsNumber longLongValue]];
+    return [[[OIDClock sharedClock] now] dateByAddingTimeInterval:[valueAsNumber longLongValue]];
   };
 }
 
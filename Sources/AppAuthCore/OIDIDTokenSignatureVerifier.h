@@ -0,0 +1,104 @@
+/*! @file OIDIDTokenSignatureVerifier.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDJWKSCache;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Represents the type of block used as a callback when verifying the signature of an ID
+        Token.
+    @param error The error if the signature could not be verified, or nil if it is valid.
+ */
+typedef void (^OIDIDTokenSignatureCallback)(NSError *_Nullable error);
+
+/*! @brief Verifies the signature of ID Tokens against the keys published at the @c jwks_uri of
+        their issuer.
+    @discussion Only the RS256 and ES256 algorithms are supported, any other algorithm fails
+        verification. Keys are looked up by the @c kid of the ID Token through an @c OIDJWKSCache
+        per key set URL, and signatures are checked with the Security framework. Successful
+        verifications are cached by the SHA-256 hash of the ID Token for @c keySetTimeToLive, so
+        verifying the same ID Token again doesn't repeat the cryptography.
+
+        AppAuth relies on TLS for ID Tokens received from the token endpoint, as permitted by
+        OpenID Connect Core Section 3.1.3.7 rule #6. Set @c sharedVerifier to also verify their
+        signature: the token requests of @c OIDAuthorizationService then fail with
+        @c ::OIDErrorCodeIDTokenFailedValidationError if the signature is invalid. Service
+        configurations without a discovery document, or whose discovery document has no
+        @c jwks_uri, provide no key set URL: their ID Tokens are not verified, and TLS is relied
+        on as without a verifier.
+    @see https://tools.ietf.org/html/rfc7515
+ */
+@interface OIDIDTokenSignatureVerifier : NSObject
+
+/*! @brief How long fetched key sets and successful verifications are cached, in seconds.
+ */
+@property(nonatomic, readonly) NSTimeInterval keySetTimeToLive;
+
+/*! @brief Returns the current date. Defaults to returning @c OIDClock.sharedClock.now. Tests can
+        substitute a virtual clock. Also used by the key set caches created afterwards.
+ */
+@property(nonatomic, copy, null_resettable) NSDate *(^currentDate)(void);
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithKeySetTimeToLive:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param keySetTimeToLive How long fetched key sets and successful verifications are cached.
+ */
+- (instancetype)initWithKeySetTimeToLive:(NSTimeInterval)keySetTimeToLive
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief The verifier of the ID Tokens received by @c OIDAuthorizationService, if any. Defaults
+        to nil.
+ */
++ (nullable OIDIDTokenSignatureVerifier *)sharedVerifier;
+
+/*! @brief Sets the verifier of the ID Tokens received by @c OIDAuthorizationService.
+    @param verifier The verifier, or nil to rely on TLS only.
+ */
++ (void)setSharedVerifier:(nullable OIDIDTokenSignatureVerifier *)verifier;
+
+/*! @brief Returns the key set cache used for a key set URL, creating it if needed.
+    @param JWKSURL The URL of the JSON Web Key Set.
+ */
+- (OIDJWKSCache *)keySetCacheForURL:(NSURL *)JWKSURL;
+
+/*! @brief Verifies the signature of an ID Token.
+    @param IDToken The ID Token.
+    @param JWKSURL The URL of the JSON Web Key Set of the issuer of the ID Token.
+    @param completion Called with the outcome, on an arbitrary queue.
+ */
+- (void)verifyIDToken:(NSString *)IDToken
+              JWKSURL:(NSURL *)JWKSURL
+           completion:(OIDIDTokenSignatureCallback)completion;
+
+/*! @brief Verifies the signature of a JSON Web Token with a key.
+    @param token The compact serialization of the JSON Web Token.
+    @param key The JSON Web Key.
+    @return nil if the signature is valid, otherwise an error.
+ */
++ (nullable NSError *)verifySignatureOfToken:(NSString *)token
+                                     withKey:(NSDictionary<NSString *, id> *)key;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,360 @@
+/*! @file OIDIDTokenSignatureVerifier.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDIDTokenSignatureVerifier.h"
+
+#import <Security/Security.h>
+
+#import "OIDClock.h"
+#import "OIDDefines.h"
+#import "OIDErrorUtilities.h"
+#import "OIDJWKSCache.h"
+#import "OIDTokenUtilities.h"
+
+/*! Field keys associated with a JSON Web Key and the header of a JSON Web Signature. */
+static NSString *const kAlgorithmKey = @"alg";
+static NSString *const kKeyIDKey = @"kid";
+static NSString *const kKeyTypeKey = @"kty";
+static NSString *const kKeyUseKey = @"use";
+static NSString *const kRSAModulusKey = @"n";
+static NSString *const kRSAExponentKey = @"e";
+static NSString *const kECCurveKey = @"crv";
+static NSString *const kECXCoordinateKey = @"x";
+static NSString *const kECYCoordinateKey = @"y";
+
+/*! Supported values of the fields of a JSON Web Key and the header of a JSON Web Signature. */
+static NSString *const kAlgorithmRS256 = @"RS256";
+static NSString *const kAlgorithmES256 = @"ES256";
+static NSString *const kKeyTypeRSA = @"RSA";
+static NSString *const kKeyTypeEC = @"EC";
+static NSString *const kKeyUseSignature = @"sig";
+static NSString *const kECCurveP256 = @"P-256";
+
+/*! @brief The size of a coordinate of a P-256 point, and of each half of an ES256 signature.
+ */
+static NSUInteger const kP256FieldSize = 32;
+
+/*! @brief The verifier of the ID Tokens received by @c OIDAuthorizationService. Guarded by
+        @synchronized on @c OIDIDTokenSignatureVerifier.
+ */
+static OIDIDTokenSignatureVerifier *gSharedVerifier;
+
+/*! @brief Appends a DER element to @c data.
+    @param data The data to append the element to.
+    @param tag The tag of the element.
+    @param contents The contents of the element.
+ */
+static void OIDAppendDERElement(NSMutableData *data, uint8_t tag, NSData *contents) {
+  [data appendBytes:&tag length:1];
+  NSUInteger length = contents.length;
+  if (length < 0x80) {
+    uint8_t shortLength = (uint8_t)length;
+    [data appendBytes:&shortLength length:1];
+  } else {
+    uint8_t lengthBytes[sizeof(NSUInteger)];
+    uint8_t count = 0;
+    for (NSUInteger remaining = length; remaining; remaining >>= 8) {
+      lengthBytes[sizeof(lengthBytes) - ++count] = remaining & 0xff;
+    }
+    uint8_t longLengthPrefix = 0x80 | count;
+    [data appendBytes:&longLengthPrefix length:1];
+    [data appendBytes:lengthBytes + sizeof(lengthBytes) - count length:count];
+  }
+  [data appendData:contents];
+}
+
+/*! @brief Appends a DER INTEGER holding a big-endian unsigned integer to @c data.
+ */
+static void OIDAppendDERUnsignedInteger(NSMutableData *data, NSData *bigEndianInteger) {
+  const uint8_t *bytes = bigEndianInteger.bytes;
+  NSUInteger length = bigEndianInteger.length;
+  while (length > 1 && bytes[0] == 0) {
+    bytes++;
+    length--;
+  }
+  NSMutableData *contents = [NSMutableData data];
+  if (length == 0 || bytes[0] & 0x80) {
+    uint8_t zero = 0;
+    [contents appendBytes:&zero length:1];
+  }
+  [contents appendBytes:bytes length:length];
+  OIDAppendDERElement(data, 0x02, contents);
+}
+
+/*! @brief Returns the DER SEQUENCE of two big-endian unsigned integers, as used by both PKCS #1
+        RSA public keys and ECDSA signatures.
+ */
+static NSData *OIDDERSequenceOfUnsignedIntegers(NSData *first, NSData *second) {
+  NSMutableData *contents = [NSMutableData data];
+  OIDAppendDERUnsignedInteger(contents, first);
+  OIDAppendDERUnsignedInteger(contents, second);
+  NSMutableData *sequence = [NSMutableData data];
+  OIDAppendDERElement(sequence, 0x30, contents);
+  return sequence;
+}
+
+/*! @brief Returns the base64url decoded value of a field of a JSON Web Key, if it's a string.
+ */
+static NSData *_Nullable OIDKeyData(NSDictionary<NSString *, id> *key, NSString *field) {
+  id value = key[field];
+  if (![value isKindOfClass:[NSString class]]) {
+    return nil;
+  }
+  return [OIDTokenUtilities decodeBase64urlNoPadding:value];
+}
+
+/*! @brief Creates the public key of an RSA JSON Web Key.
+    @return The public key, to be released by the caller, or NULL if the JSON Web Key isn't valid.
+ */
+static SecKeyRef _Nullable OIDCreateRSAPublicKey(NSDictionary<NSString *, id> *key)
+    API_AVAILABLE(ios(10.0), macos(10.12), tvos(10.0), watchos(3.0)) {
+  NSData *modulus = OIDKeyData(key, kRSAModulusKey);
+  NSData *exponent = OIDKeyData(key, kRSAExponentKey);
+  if (![key[kKeyTypeKey] isEqual:kKeyTypeRSA] || !modulus.length || !exponent.length) {
+    return NULL;
+  }
+  NSData *keyData = OIDDERSequenceOfUnsignedIntegers(modulus, exponent);
+  NSDictionary *attributes = @{
+    (__bridge NSString *)kSecAttrKeyType : (__bridge NSString *)kSecAttrKeyTypeRSA,
+    (__bridge NSString *)kSecAttrKeyClass : (__bridge NSString *)kSecAttrKeyClassPublic,
+  };
+  return SecKeyCreateWithData((__bridge CFDataRef)keyData,
+                              (__bridge CFDictionaryRef)attributes,
+                              NULL);
+}
+
+/*! @brief Creates the public key of a P-256 EC JSON Web Key.
+    @return The public key, to be released by the caller, or NULL if the JSON Web Key isn't valid.
+ */
+static SecKeyRef _Nullable OIDCreateECPublicKey(NSDictionary<NSString *, id> *key)
+    API_AVAILABLE(ios(10.0), macos(10.12), tvos(10.0), watchos(3.0)) {
+  NSData *x = OIDKeyData(key, kECXCoordinateKey);
+  NSData *y = OIDKeyData(key, kECYCoordinateKey);
+  if (![key[kKeyTypeKey] isEqual:kKeyTypeEC] || ![key[kECCurveKey] isEqual:kECCurveP256] ||
+      x.length != kP256FieldSize || y.length != kP256FieldSize) {
+    return NULL;
+  }
+  // ANSI X9.63 uncompressed point.
+  uint8_t uncompressedPointPrefix = 0x04;
+  NSMutableData *keyData = [NSMutableData dataWithBytes:&uncompressedPointPrefix length:1];
+  [keyData appendData:x];
+  [keyData appendData:y];
+  NSDictionary *attributes = @{
+    (__bridge NSString *)kSecAttrKeyType : (__bridge NSString *)kSecAttrKeyTypeECSECPrimeRandom,
+    (__bridge NSString *)kSecAttrKeyClass : (__bridge NSString *)kSecAttrKeyClassPublic,
+    (__bridge NSString *)kSecAttrKeySizeInBits : @256,
+  };
+  return SecKeyCreateWithData((__bridge CFDataRef)keyData,
+                              (__bridge CFDictionaryRef)attributes,
+                              NULL);
+}
+
+/*! @brief Returns an error with @c ::OIDErrorCodeIDTokenFailedValidationError.
+ */
+static NSError *OIDSignatureVerificationError(NSString *description) {
+  return [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                          underlyingError:nil
+                              description:description];
+}
+
+@implementation OIDIDTokenSignatureVerifier {
+  /*! @brief The key set caches by key set URL. Guarded by @synchronized on self.
+   */
+  NSMutableDictionary<NSURL *, OIDJWKSCache *> *_keySetCaches;
+
+  /*! @brief The expiry dates of successful verifications, by the SHA-256 hash of the key set URL
+          and ID Token.
+   */
+  NSCache<NSData *, NSDate *> *_verifications;
+}
+
+@synthesize currentDate = _currentDate;
+
+- (instancetype)init OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithKeySetTimeToLive:))
+
+- (instancetype)initWithKeySetTimeToLive:(NSTimeInterval)keySetTimeToLive {
+  self = [super init];
+  if (self) {
+    _keySetTimeToLive = keySetTimeToLive;
+    _keySetCaches = [NSMutableDictionary dictionary];
+    _verifications = [[NSCache alloc] init];
+  }
+  return self;
+}
+
++ (nullable OIDIDTokenSignatureVerifier *)sharedVerifier {
+  @synchronized([OIDIDTokenSignatureVerifier class]) {
+    return gSharedVerifier;
+  }
+}
+
++ (void)setSharedVerifier:(nullable OIDIDTokenSignatureVerifier *)verifier {
+  @synchronized([OIDIDTokenSignatureVerifier class]) {
+    gSharedVerifier = verifier;
+  }
+}
+
+- (NSDate *(^)(void))currentDate {
+  if (_currentDate) {
+    return _currentDate;
+  }
+  return ^{
+    return [[OIDClock sharedClock] now];
+  };
+}
+
+- (OIDJWKSCache *)keySetCacheForURL:(NSURL *)JWKSURL {
+  @synchronized(self) {
+    OIDJWKSCache *keySetCache = _keySetCaches[JWKSURL];
+    if (!keySetCache) {
+      keySetCache = [[OIDJWKSCache alloc] initWithJWKSURL:JWKSURL timeToLive:_keySetTimeToLive];
+      keySetCache.currentDate = _currentDate;
+      _keySetCaches[JWKSURL] = keySetCache;
+    }
+    return keySetCache;
+  }
+}
+
+/*! @brief Returns the header of a JSON Web Signature, or nil if it can't be parsed.
+    @param token The compact serialization of the JSON Web Signature.
+    @param sections Set to the sections of the compact serialization.
+ */
++ (nullable NSDictionary<NSString *, id> *)headerOfToken:(NSString *)token
+                                                sections:(NSArray<NSString *> **)sections {
+  *sections = [token componentsSeparatedByString:@"."];
+  if ((*sections).count != 3) {
+    return nil;
+  }
+  NSData *headerData = [OIDTokenUtilities decodeBase64urlNoPadding:(*sections)[0]];
+  if (!headerData) {
+    return nil;
+  }
+  id header = [NSJSONSerialization JSONObjectWithData:headerData options:0 error:NULL];
+  return [header isKindOfClass:[NSDictionary class]] ? header : nil;
+}
+
+- (void)verifyIDToken:(NSString *)IDToken
+              JWKSURL:(NSURL *)JWKSURL
+           completion:(OIDIDTokenSignatureCallback)completion {
+  NSDate *now = self.currentDate();
+  NSString *verificationString =
+      [NSString stringWithFormat:@"%@ %@", JWKSURL.absoluteString, IDToken];
+  NSData *verificationKey = [OIDTokenUtilities sha256:verificationString];
+  NSDate *verificationExpiry = [_verifications objectForKey:verificationKey];
+  if (verificationExpiry && [now compare:verificationExpiry] == NSOrderedAscending) {
+    completion(nil);
+    return;
+  }
+
+  NSArray<NSString *> *sections;
+  NSDictionary<NSString *, id> *header = [[self class] headerOfToken:IDToken sections:&sections];
+  if (!header) {
+    completion([OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenParsingError
+                                underlyingError:nil
+                                    description:@"ID Token parsing failed"]);
+    return;
+  }
+  id keyID = header[kKeyIDKey];
+  if (![keyID isKindOfClass:[NSString class]]) {
+    keyID = nil;
+  }
+
+  NSCache<NSData *, NSDate *> *verifications = _verifications;
+  NSTimeInterval keySetTimeToLive = _keySetTimeToLive;
+  [[self keySetCacheForURL:JWKSURL] keyWithID:keyID
+                                   completion:^(NSDictionary<NSString *, id> *_Nullable key,
+                                                NSError *_Nullable error) {
+    if (!key) {
+      if (error.code != OIDErrorCodeIDTokenFailedValidationError) {
+        error = [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                                 underlyingError:error
+                                     description:@"Unable to get the JSON Web Key Set"];
+      }
+      completion(error);
+      return;
+    }
+    NSError *verificationError = [[self class] verifySignatureOfToken:IDToken withKey:key];
+    if (!verificationError) {
+      [verifications setObject:[now dateByAddingTimeInterval:keySetTimeToLive]
+                        forKey:verificationKey];
+    }
+    completion(verificationError);
+  }];
+}
+
++ (nullable NSError *)verifySignatureOfToken:(NSString *)token
+                                     withKey:(NSDictionary<NSString *, id> *)key {
+  NSArray<NSString *> *sections;
+  NSDictionary<NSString *, id> *header = [self headerOfToken:token sections:&sections];
+  NSData *signature =
+      header ? [OIDTokenUtilities decodeBase64urlNoPadding:sections[2]] : nil;
+  if (!signature) {
+    return [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenParsingError
+                            underlyingError:nil
+                                description:@"ID Token parsing failed"];
+  }
+
+  id algorithm = header[kAlgorithmKey];
+  if (![algorithm isEqual:kAlgorithmRS256] && ![algorithm isEqual:kAlgorithmES256]) {
+    NSString *description =
+        [NSString stringWithFormat:@"Unsupported signature algorithm: %@", algorithm];
+    return OIDSignatureVerificationError(description);
+  }
+  if ((key[kAlgorithmKey] && ![key[kAlgorithmKey] isEqual:algorithm]) ||
+      (key[kKeyUseKey] && ![key[kKeyUseKey] isEqual:kKeyUseSignature])) {
+    return OIDSignatureVerificationError(@"Key not usable for the signature algorithm");
+  }
+
+  if (@available(iOS 10.0, macOS 10.12, tvOS 10.0, watchOS 3.0, *)) {
+    SecKeyRef publicKey;
+    SecKeyAlgorithm keyAlgorithm;
+    if ([algorithm isEqual:kAlgorithmRS256]) {
+      publicKey = OIDCreateRSAPublicKey(key);
+      keyAlgorithm = kSecKeyAlgorithmRSASignatureMessagePKCS1v15SHA256;
+    } else {
+      publicKey = OIDCreateECPublicKey(key);
+      keyAlgorithm = kSecKeyAlgorithmECDSASignatureMessageX962SHA256;
+      // JSON Web Signatures hold the raw R and S values, the Security framework expects DER.
+      if (signature.length != 2 * kP256FieldSize) {
+        if (publicKey) {
+          CFRelease(publicKey);
+        }
+        return OIDSignatureVerificationError(@"Invalid signature");
+      }
+      NSData *r = [signature subdataWithRange:NSMakeRange(0, kP256FieldSize)];
+      NSData *s = [signature subdataWithRange:NSMakeRange(kP256FieldSize, kP256FieldSize)];
+      signature = OIDDERSequenceOfUnsignedIntegers(r, s);
+    }
+    if (!publicKey) {
+      return OIDSignatureVerificationError(@"Invalid key");
+    }
+
+    NSString *signingInput = [NSString stringWithFormat:@"%@.%@", sections[0], sections[1]];
+    NSData *signingInputData = [signingInput dataUsingEncoding:NSUTF8StringEncoding];
+    BOOL valid = SecKeyVerifySignature(publicKey,
+                                       keyAlgorithm,
+                                       (__bridge CFDataRef)signingInputData,
+                                       (__bridge CFDataRef)signature,
+                                       NULL);
+    CFRelease(publicKey);
+    return valid ? nil : OIDSignatureVerificationError(@"Invalid signature");
+  }
+  return OIDSignatureVerificationError(@"Signature verification requires a newer OS version");
+}
+
+@end
@@ -0,0 +1,93 @@
+/*! @file OIDJWKSCache.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Represents the type of block used as a callback when looking up a key of a JSON Web Key
+        Set.
+    @param key The JSON Web Key, if found.
+    @param error The error if the key could not be found or the key set could not be fetched.
+ */
+typedef void (^OIDJWKSKeyCallback)(NSDictionary<NSString *, id> *_Nullable key,
+                                   NSError *_Nullable error);
+
+/*! @brief Caches the keys of a JSON Web Key Set, such as the one at the @c jwks_uri of a discovery
+        document, by key ID.
+    @discussion The key set is fetched on first use and kept for @c timeToLive. Once three quarters
+        of @c timeToLive have passed, lookups are still answered from the cache while the key set
+        is refreshed in the background. A lookup for an unknown key ID refetches the key set, to
+        pick up rotated keys, at most once per @c minimumRefreshInterval. Concurrent lookups share
+        a single fetch. If a fetch fails, expired keys keep being used, so tokens can still be
+        verified while offline; the key set can also be seeded with
+        @c updateWithJWKSData:error:, for example from a copy bundled with the app.
+    @see https://tools.ietf.org/html/rfc7517#section-5
+ */
+@interface OIDJWKSCache : NSObject
+
+/*! @brief The URL of the JSON Web Key Set.
+ */
+@property(nonatomic, readonly) NSURL *JWKSURL;
+
+/*! @brief How long a fetched key set is used for, in seconds.
+ */
+@property(nonatomic, readonly) NSTimeInterval timeToLive;
+
+/*! @brief The minimum time between two fetches caused by an unknown key ID, in seconds. Defaults
+        to 60.
+ */
+@property(atomic) NSTimeInterval minimumRefreshInterval;
+
+/*! @brief Returns the current date. Defaults to returning @c OIDClock.sharedClock.now. Tests can
+        substitute a virtual clock.
+ */
+@property(nonatomic, copy, null_resettable) NSDate *(^currentDate)(void);
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithJWKSURL:timeToLive:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param JWKSURL The URL of the JSON Web Key Set.
+    @param timeToLive How long a fetched key set is used for, in seconds.
+ */
+- (instancetype)initWithJWKSURL:(NSURL *)JWKSURL
+                     timeToLive:(NSTimeInterval)timeToLive NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Looks up a key by its key ID, fetching the key set if needed.
+    @param keyID The @c kid of the key. If nil, the key set must contain a single key.
+    @param completion Called with the key or an error, on an arbitrary queue.
+ */
+- (void)keyWithID:(nullable NSString *)keyID completion:(OIDJWKSKeyCallback)completion;
+
+/*! @brief Replaces the cached key set, as if it had just been fetched.
+    @param JWKSData The JSON of the key set.
+    @param error The error if the JSON is not a key set.
+    @return YES if the cached key set was replaced.
+ */
+- (BOOL)updateWithJWKSData:(NSData *)JWKSData error:(NSError **_Nullable)error;
+
+/*! @brief Fetches the key set in the background, unless a fetch is already in flight.
+ */
+- (void)refresh;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,272 @@
+/*! @file OIDJWKSCache.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDJWKSCache.h"
+
+#import "OIDClock.h"
+#import "OIDDefines.h"
+#import "OIDErrorUtilities.h"
+#import "OIDURLSessionProvider.h"
+
+/*! @brief The fraction of @c timeToLive after which a lookup refreshes the key set in the
+        background.
+ */
+static double const kBackgroundRefreshFraction = 0.75;
+
+/*! @brief The default value of @c minimumRefreshInterval.
+ */
+static NSTimeInterval const kDefaultMinimumRefreshInterval = 60;
+
+/*! @brief Field of a JSON Web Key Set holding its keys.
+ */
+static NSString *const kKeysKey = @"keys";
+
+/*! @brief Field of a JSON Web Key holding its key ID.
+ */
+static NSString *const kKeyIDKey = @"kid";
+
+/*! @brief Represents a lookup waiting for a fetch of the key set to complete.
+    @param fetchError The error the fetch failed with, if any.
+ */
+typedef void (^OIDJWKSPendingLookup)(NSError *_Nullable fetchError);
+
+@implementation OIDJWKSCache {
+  /*! @brief The keys of the key set. Guarded by @synchronized on self.
+   */
+  NSArray<NSDictionary<NSString *, id> *> *_keys;
+
+  /*! @brief The keys of the key set which have a key ID, by key ID. Guarded by @synchronized on
+          self.
+   */
+  NSDictionary<NSString *, NSDictionary<NSString *, id> *> *_keysByID;
+
+  /*! @brief When the key set was last fetched or updated, or nil if it never was. Guarded by
+          @synchronized on self.
+   */
+  NSDate *_updatedDate;
+
+  /*! @brief When the last fetch started. Guarded by @synchronized on self.
+   */
+  NSDate *_lastFetchDate;
+
+  /*! @brief The lookups waiting for the fetch in flight, or nil if there is none. Guarded by
+          @synchronized on self.
+   */
+  NSMutableArray<OIDJWKSPendingLookup> *_pendingLookups;
+}
+
+@synthesize currentDate = _currentDate;
+
+- (instancetype)init OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithJWKSURL:timeToLive:))
+
+- (instancetype)initWithJWKSURL:(NSURL *)JWKSURL timeToLive:(NSTimeInterval)timeToLive {
+  self = [super init];
+  if (self) {
+    _JWKSURL = [JWKSURL copy];
+    _timeToLive = timeToLive;
+    _minimumRefreshInterval = kDefaultMinimumRefreshInterval;
+  }
+  return self;
+}
+
+- (NSDate *(^)(void))currentDate {
+  if (_currentDate) {
+    return _currentDate;
+  }
+  return ^{
+    return [[OIDClock sharedClock] now];
+  };
+}
+
+/*! @brief Returns the cached key with a key ID, or the only cached key if @c keyID is nil. Must be
+        called while synchronized on self.
+ */
+- (nullable NSDictionary<NSString *, id> *)cachedKeyWithID:(nullable NSString *)keyID {
+  if (keyID) {
+    return _keysByID[keyID];
+  }
+  return _keys.count == 1 ? _keys.firstObject : nil;
+}
+
+- (void)keyWithID:(nullable NSString *)keyID completion:(OIDJWKSKeyCallback)completion {
+  NSDate *now = self.currentDate();
+  NSDictionary<NSString *, id> *key;
+  BOOL backgroundRefresh = NO;
+  BOOL waitForFetch = NO;
+  BOOL startFetch = NO;
+  @synchronized(self) {
+    key = [self cachedKeyWithID:keyID];
+    NSTimeInterval age = _updatedDate ? [now timeIntervalSinceDate:_updatedDate] : INFINITY;
+    BOOL recentlyFetched =
+        _lastFetchDate && [now timeIntervalSinceDate:_lastFetchDate] < _minimumRefreshInterval;
+    if (key && age < _timeToLive) {
+      backgroundRefresh = age >= _timeToLive * kBackgroundRefreshFraction;
+    } else if (_pendingLookups || !recentlyFetched) {
+      // Waits for a fresh key set. Right after a fetch, the expired key or the lack of a key is
+      // used as is instead, so unknown key IDs and fetches failing while offline don't cause a
+      // fetch each.
+      OIDJWKSPendingLookup lookup = ^(NSError *_Nullable fetchError) {
+        [self resolveKeyWithID:keyID fetchError:fetchError completion:completion];
+      };
+      startFetch = !_pendingLookups;
+      if (startFetch) {
+        _pendingLookups = [NSMutableArray array];
+        _lastFetchDate = now;
+      }
+      [_pendingLookups addObject:lookup];
+      waitForFetch = YES;
+    }
+  }
+
+  if (waitForFetch) {
+    if (startFetch) {
+      [self fetchKeySet];
+    }
+    return;
+  }
+  if (backgroundRefresh) {
+    [self refresh];
+  }
+  [self resolveKeyWithID:keyID fetchError:nil completion:completion];
+}
+
+/*! @brief Completes a lookup with the cached key, or with an error if there is no such key.
+ */
+- (void)resolveKeyWithID:(nullable NSString *)keyID
+              fetchError:(nullable NSError *)fetchError
+              completion:(OIDJWKSKeyCallback)completion {
+  NSDictionary<NSString *, id> *key;
+  @synchronized(self) {
+    key = [self cachedKeyWithID:keyID];
+  }
+  if (key) {
+    completion(key, nil);
+    return;
+  }
+  if (fetchError) {
+    completion(nil, fetchError);
+    return;
+  }
+  NSString *errorDescription =
+      keyID ? [NSString stringWithFormat:@"No key with ID '%@' in the JSON Web Key Set at '%@'.",
+                                         keyID,
+                                         _JWKSURL]
+            : [NSString stringWithFormat:@"No key ID, and the JSON Web Key Set at '%@' doesn't "
+                                          "contain exactly one key.",
+                                         _JWKSURL];
+  completion(nil, [OIDErrorUtilities errorWithCode:OIDErrorCodeIDTokenFailedValidationError
+                                   underlyingError:nil
+                                       description:errorDescription]);
+}
+
+- (BOOL)updateWithJWKSData:(NSData *)JWKSData error:(NSError **_Nullable)error {
+  NSError *jsonError;
+  id json = [NSJSONSerialization JSONObjectWithData:JWKSData options:0 error:&jsonError];
+  NSArray *keys = [json isKindOfClass:[NSDictionary class]] ? json[kKeysKey] : nil;
+  if (![keys isKindOfClass:[NSArray class]]) {
+    if (error) {
+      *error = [OIDErrorUtilities errorWithCode:OIDErrorCodeJSONDeserializationError
+                                underlyingError:jsonError
+                                    description:@"Invalid JSON Web Key Set."];
+    }
+    return NO;
+  }
+
+  NSMutableArray<NSDictionary<NSString *, id> *> *validKeys = [NSMutableArray array];
+  NSMutableDictionary<NSString *, NSDictionary<NSString *, id> *> *keysByID =
+      [NSMutableDictionary dictionary];
+  for (id key in keys) {
+    if (![key isKindOfClass:[NSDictionary class]]) {
+      continue;
+    }
+    [validKeys addObject:key];
+    id keyID = key[kKeyIDKey];
+    if ([keyID isKindOfClass:[NSString class]]) {
+      keysByID[keyID] = key;
+    }
+  }
+
+  NSDate *now = self.currentDate();
+  @synchronized(self) {
+    _keys = [validKeys copy];
+    _keysByID = [keysByID copy];
+    _updatedDate = now;
+  }
+  return YES;
+}
+
+- (void)refresh {
+  @synchronized(self) {
+    if (_pendingLookups) {
+      return;
+    }
+    _pendingLookups = [NSMutableArray array];
+    _lastFetchDate = self.currentDate();
+  }
+  [self fetchKeySet];
+}
+
+/*! @brief Fetches the key set, then completes the pending lookups.
+ */
+- (void)fetchKeySet {
+  NSURLRequest *URLRequest = [NSURLRequest requestWithURL:_JWKSURL];
+  AppAuthRequestTrace(@"JWKS Request: %@", URLRequest.URL);
+
+  NSURLSession *session = [OIDURLSessionProvider session];
+  [[session dataTaskWithRequest:URLRequest
+              completionHandler:^(NSData *_Nullable data,
+                                  NSURLResponse *_Nullable response,
+                                  NSError *_Nullable error) {
+    NSError *fetchError;
+    NSHTTPURLResponse *HTTPURLResponse = (NSHTTPURLResponse *)response;
+    if (error) {
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Connection error fetching JSON Web Key Set from '%@': %@.",
+                                     URLRequest.URL,
+                                     error.localizedDescription];
+      fetchError = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
+                                    underlyingError:error
+                                        description:errorDescription];
+    } else if (HTTPURLResponse.statusCode != 200) {
+      NSError *URLResponseError = [OIDErrorUtilities HTTPErrorWithHTTPResponse:HTTPURLResponse
+                                                                          data:data];
+      NSString *errorDescription =
+          [NSString stringWithFormat:@"Non-200 HTTP response (%d) fetching JSON Web Key Set "
+                                      "from '%@'.",
+                                     (int)HTTPURLResponse.statusCode,
+                                     URLRequest.URL];
+      fetchError = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
+                                    underlyingError:URLResponseError
+                                        description:errorDescription];
+    } else {
+      [self updateWithJWKSData:data ?: [NSData data] error:&fetchError];
+    }
+    AppAuthRequestTrace(@"JWKS Response: %@ error: %@", response, fetchError);
+
+    NSArray<OIDJWKSPendingLookup> *pendingLookups;
+    @synchronized(self) {
+      pendingLookups = _pendingLookups;
+      _pendingLookups = nil;
+    }
+    for (OIDJWKSPendingLookup lookup in pendingLookups) {
+      lookup(fetchError);
+    }
+  }] resume];
+}
+
+@end
@@ -0,0 +1,136 @@
+/*! @file OIDMetrics.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The endpoints for which request metrics are reported.
+ */
+typedef NS_ENUM(NSInteger, OIDMetricsEndpoint) {
+  /*! @brief The OpenID Connect discovery document.
+   */
+  OIDMetricsEndpointDiscovery = 0,
+
+  /*! @brief The dynamic client registration endpoint.
+   */
+  OIDMetricsEndpointRegistration = 1,
+
+  /*! @brief The token endpoint, including token refreshes and device flow polling.
+   */
+  OIDMetricsEndpointToken = 2,
+
+  /*! @brief The device authorization endpoint.
+   */
+  OIDMetricsEndpointDeviceAuthorization = 3,
+};
+
+/*! @protocol OIDMetricsObserver
+    @brief Receives metrics about requests, token refreshes and the actions pending on them.
+    @discussion Observers are called on arbitrary threads, so implementations must be thread safe
+        and return quickly. @c OIDMetricsAggregator is a ready-made observer which aggregates the
+        metrics into histograms and counters.
+ */
+@protocol OIDMetricsObserver <NSObject>
+
+@optional
+
+/*! @brief Called when a request to an endpoint completes, just before its callback is called.
+    @param endpoint The endpoint the request was made to.
+    @param latency The time from sending the request to receiving the response, in seconds.
+    @param bytesSent The size of the request body.
+    @param bytesReceived The size of the response body.
+    @param error The error the request failed with, if any.
+ */
+- (void)requestToEndpoint:(OIDMetricsEndpoint)endpoint
+    didCompleteWithLatency:(NSTimeInterval)latency
+                 bytesSent:(NSUInteger)bytesSent
+             bytesReceived:(NSUInteger)bytesReceived
+                     error:(nullable NSError *)error;
+
+/*! @brief Called when an @c OIDAuthState token refresh completes.
+    @param error The error the refresh failed with, if any. Errors in the
+        @c ::OIDOAuthTokenErrorDomain invalidate the authorization, others are transient.
+ */
+- (void)tokenRefreshDidCompleteWithError:(nullable NSError *)error;
+
+/*! @brief Called when a failed @c OIDAuthState token refresh attempt will be retried, according to
+        its @c OIDAuthState.refreshRetryPolicy.
+    @param error The error the attempt failed with.
+ */
+- (void)tokenRefreshWillRetryAfterError:(NSError *)error;
+
+/*! @brief Called when an action is queued on an @c OIDAuthState while its tokens are refreshed.
+    @param depth The number of actions pending, including the queued action.
+ */
+- (void)pendingActionQueuedWithDepth:(NSUInteger)depth;
+
+/*! @brief Called when an action queued on an @c OIDAuthState is dispatched after the refresh.
+    @param duration The time the action spent queued, in seconds.
+ */
+- (void)pendingActionDispatchedAfterWaiting:(NSTimeInterval)duration;
+
+@end
+
+/*! @brief Configures the observer of request and token refresh metrics.
+    @discussion Metrics are not collected until an observer is set.
+ */
+@interface OIDMetrics : NSObject
+
+/*! @brief The observer which receives metrics, if any.
+ */
++ (nullable id<OIDMetricsObserver>)observer;
+
+/*! @brief Sets the observer which receives metrics.
+    @param observer The observer, or nil to stop collecting metrics. It is retained.
+ */
++ (void)setObserver:(nullable id<OIDMetricsObserver>)observer;
+
+@end
+
+/*! @brief Measures a single request and reports it to the metrics observer when it completes.
+    @discussion Used by @c OIDAuthorizationService and @c OIDTVAuthorizationService.
+ */
+@interface OIDMetricsRequest : NSObject
+
+/*! @internal
+    @brief Unavailable. Please use @c requestToEndpoint:URLRequest:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Begins measuring a request which is about to be sent.
+    @param endpoint The endpoint the request is made to.
+    @param URLRequest The request.
+    @return The measurement, or nil if there is no metrics observer.
+ */
++ (nullable instancetype)requestToEndpoint:(OIDMetricsEndpoint)endpoint
+                                URLRequest:(NSURLRequest *)URLRequest;
+
+/*! @brief Records that the response was received.
+    @param data The response body, if any.
+ */
+- (void)didReceiveData:(nullable NSData *)data;
+
+/*! @brief Reports the request to the metrics observer.
+    @param error The error the request failed with, if any.
+ */
+- (void)didCompleteWithError:(nullable NSError *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
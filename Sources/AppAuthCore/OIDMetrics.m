@@ -0,0 +1,111 @@
+/*! @file OIDMetrics.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDMetrics.h"
+
+#import "OIDDefines.h"
+
+/*! @brief The observer of metrics. Guarded by @synchronized on @c OIDMetrics.
+ */
+static id<OIDMetricsObserver> gMetricsObserver;
+
+@implementation OIDMetrics
+
++ (nullable id<OIDMetricsObserver>)observer {
+  @synchronized([OIDMetrics class]) {
+    return gMetricsObserver;
+  }
+}
+
++ (void)setObserver:(nullable id<OIDMetricsObserver>)observer {
+  @synchronized([OIDMetrics class]) {
+    gMetricsObserver = observer;
+  }
+}
+
+@end
+
+@implementation OIDMetricsRequest {
+  /*! @brief The observer to report the request to.
+   */
+  id<OIDMetricsObserver> _observer;
+
+  /*! @brief The endpoint the request is made to.
+   */
+  OIDMetricsEndpoint _endpoint;
+
+  /*! @brief The size of the request body.
+   */
+  NSUInteger _bytesSent;
+
+  /*! @brief The size of the response body.
+   */
+  NSUInteger _bytesReceived;
+
+  /*! @brief When the request was sent.
+   */
+  CFAbsoluteTime _startTime;
+
+  /*! @brief The time from sending the request to receiving the response.
+   */
+  NSTimeInterval _latency;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(requestToEndpoint:URLRequest:))
+
++ (nullable instancetype)requestToEndpoint:(OIDMetricsEndpoint)endpoint
+                                URLRequest:(NSURLRequest *)URLRequest {
+  id<OIDMetricsObserver> observer = [OIDMetrics observer];
+  if (![observer respondsToSelector:@selector(requestToEndpoint:
+                                         didCompleteWithLatency:
+                                                      bytesSent:
+                                                  bytesReceived:
+                                                          error:)]) {
+    return nil;
+  }
+  return [[self alloc] initWithObserver:observer endpoint:endpoint URLRequest:URLRequest];
+}
+
+- (instancetype)initWithObserver:(id<OIDMetricsObserver>)observer
+                        endpoint:(OIDMetricsEndpoint)endpoint
+                      URLRequest:(NSURLRequest *)URLRequest {
+  self = [super init];
+  if (self) {
+    _observer = observer;
+    _endpoint = endpoint;
+    _bytesSent = URLRequest.HTTPBody.length;
+    _startTime = CFAbsoluteTimeGetCurrent();
+  }
+  return self;
+}
+
+- (void)didReceiveData:(nullable NSData *)data {
+  _latency = CFAbsoluteTimeGetCurrent() - _startTime;
+  _bytesReceived = data.length;
+}
+
+- (void)didCompleteWithError:(nullable NSError *)error {
+  [_observer requestToEndpoint:_endpoint
+        didCompleteWithLatency:_latency
+                     bytesSent:_bytesSent
+                 bytesReceived:_bytesReceived
+                         error:error];
+}
+
+@end
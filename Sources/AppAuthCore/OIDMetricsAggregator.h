@@ -0,0 +1,174 @@
+/*! @file OIDMetricsAggregator.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "OIDMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief A histogram of non-negative integer values, with 32 power of two buckets.
+    @discussion Bucket 0 counts values of 0, and bucket @c i counts values from @c 2^(i-1) up to
+        but excluding @c 2^i. The last bucket also counts all larger values.
+ */
+@interface OIDMetricsHistogram : NSObject
+
+/*! @brief The number of values in each bucket.
+ */
+@property(nonatomic, readonly) NSArray<NSNumber *> *bucketCounts;
+
+/*! @brief The number of values recorded.
+ */
+@property(nonatomic, readonly) uint64_t count;
+
+/*! @brief The sum of the values recorded.
+ */
+@property(nonatomic, readonly) uint64_t sum;
+
+/*! @brief The mean of the values recorded, or 0 if there are none.
+ */
+@property(nonatomic, readonly) double mean;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithBucketCounts:sum:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param bucketCounts The number of values in each of the 32 buckets.
+    @param sum The sum of the values.
+ */
+- (instancetype)initWithBucketCounts:(NSArray<NSNumber *> *)bucketCounts
+                                 sum:(uint64_t)sum NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Returns the exclusive upper bound of the values counted by a bucket.
+    @param bucket The index of the bucket.
+ */
++ (uint64_t)upperBoundOfBucket:(NSUInteger)bucket;
+
+/*! @brief Estimates a percentile, as the upper bound of the bucket it falls in.
+    @param percentile The percentile, between 0 and 100.
+    @return The estimate, or 0 if there are no values.
+ */
+- (uint64_t)valueAtPercentile:(double)percentile;
+
+@end
+
+/*! @brief Counts requests or token refreshes by outcome.
+ */
+@interface OIDMetricsOutcomeCounts : NSObject
+
+/*! @brief The number which succeeded.
+ */
+@property(nonatomic, readonly) uint64_t successes;
+
+/*! @brief The number which failed with an OAuth error returned by the authorization server, such
+        as an error in the @c ::OIDOAuthTokenErrorDomain.
+ */
+@property(nonatomic, readonly) uint64_t OAuthErrors;
+
+/*! @brief The number which failed with any other error, such as a network or server error.
+ */
+@property(nonatomic, readonly) uint64_t otherErrors;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithSuccesses:OAuthErrors:otherErrors:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param successes The number which succeeded.
+    @param OAuthErrors The number which failed with an OAuth error.
+    @param otherErrors The number which failed with any other error.
+ */
+- (instancetype)initWithSuccesses:(uint64_t)successes
+                      OAuthErrors:(uint64_t)OAuthErrors
+                      otherErrors:(uint64_t)otherErrors NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/*! @brief The metrics aggregated by an @c OIDMetricsAggregator at a point in time.
+ */
+@interface OIDMetricsSnapshot : NSObject
+
+/*! @brief Refresh outcomes of @c OIDAuthState.
+ */
+@property(nonatomic, readonly) OIDMetricsOutcomeCounts *tokenRefreshes;
+
+/*! @brief The number of failed @c OIDAuthState token refresh attempts which were retried.
+ */
+@property(nonatomic, readonly) uint64_t tokenRefreshRetries;
+
+/*! @brief The number of actions pending on an @c OIDAuthState each time one was queued.
+ */
+@property(nonatomic, readonly) OIDMetricsHistogram *pendingActionDepth;
+
+/*! @brief The time actions spent pending on an @c OIDAuthState, in microseconds.
+ */
+@property(nonatomic, readonly) OIDMetricsHistogram *pendingActionWait;
+
+/*! @internal
+    @brief Unavailable. Snapshots are created by @c OIDMetricsAggregator.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Returns the latency of requests to an endpoint, in microseconds.
+    @param endpoint The endpoint.
+ */
+- (OIDMetricsHistogram *)latencyForEndpoint:(OIDMetricsEndpoint)endpoint;
+
+/*! @brief Returns the size of the request bodies sent to an endpoint, in bytes.
+    @param endpoint The endpoint.
+ */
+- (OIDMetricsHistogram *)bytesSentForEndpoint:(OIDMetricsEndpoint)endpoint;
+
+/*! @brief Returns the size of the response bodies received from an endpoint, in bytes.
+    @param endpoint The endpoint.
+ */
+- (OIDMetricsHistogram *)bytesReceivedForEndpoint:(OIDMetricsEndpoint)endpoint;
+
+/*! @brief Returns the outcomes of requests to an endpoint.
+    @param endpoint The endpoint.
+ */
+- (OIDMetricsOutcomeCounts *)outcomesForEndpoint:(OIDMetricsEndpoint)endpoint;
+
+@end
+
+/*! @brief A metrics observer which aggregates metrics into histograms and counters in memory.
+    @discussion Recording a metric only increments atomic counters, so it never blocks. Snapshots
+        read each counter atomically, but metrics recorded while a snapshot is taken may be
+        reflected in some of its values and not others.
+
+        To collect metrics, create an aggregator, pass it to @c OIDMetrics.setObserver:, and take
+        snapshots periodically.
+ */
+@interface OIDMetricsAggregator : NSObject <OIDMetricsObserver>
+
+/*! @brief Returns the metrics aggregated so far.
+ */
+- (OIDMetricsSnapshot *)snapshot;
+
+/*! @brief Returns the metrics aggregated so far, and restarts aggregation from zero.
+    @discussion Suited to periodic export, as each metric recorded is included in exactly one
+        snapshot.
+ */
+- (OIDMetricsSnapshot *)snapshotAndReset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,357 @@
+/*! @file OIDMetricsAggregator.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDMetricsAggregator.h"
+
+#import <stdatomic.h>
+
+#import "OIDDefines.h"
+#import "OIDErrorUtilities.h"
+
+enum {
+  /*! @brief The number of buckets of each histogram.
+   */
+  kHistogramBucketCount = 32,
+
+  /*! @brief The number of values of @c OIDMetricsEndpoint.
+   */
+  kEndpointCount = OIDMetricsEndpointDeviceAuthorization + 1,
+};
+
+/*! @brief Microseconds per second, the unit durations are aggregated in.
+ */
+static double const kMicrosecondsPerSecond = 1000000.0;
+
+/*! @brief The counters of a histogram, updated atomically.
+ */
+typedef struct {
+  _Atomic uint64_t buckets[kHistogramBucketCount];
+  _Atomic uint64_t sum;
+} OIDMetricsAtomicHistogram;
+
+/*! @brief The counters of outcomes, updated atomically.
+ */
+typedef struct {
+  _Atomic uint64_t successes;
+  _Atomic uint64_t OAuthErrors;
+  _Atomic uint64_t otherErrors;
+} OIDMetricsAtomicOutcomes;
+
+/*! @brief Returns the index of the bucket counting a value.
+ */
+static NSUInteger OIDMetricsBucketForValue(uint64_t value) {
+  if (value == 0) {
+    return 0;
+  }
+  NSUInteger bucket = 64 - __builtin_clzll(value);
+  return MIN(bucket, kHistogramBucketCount - 1);
+}
+
+/*! @brief Records a value in a histogram.
+ */
+static void OIDMetricsRecordValue(OIDMetricsAtomicHistogram *histogram, uint64_t value) {
+  atomic_fetch_add_explicit(&histogram->buckets[OIDMetricsBucketForValue(value)], 1,
+                            memory_order_relaxed);
+  atomic_fetch_add_explicit(&histogram->sum, value, memory_order_relaxed);
+}
+
+/*! @brief Records a duration in a histogram, in microseconds.
+ */
+static void OIDMetricsRecordDuration(OIDMetricsAtomicHistogram *histogram,
+                                     NSTimeInterval duration) {
+  OIDMetricsRecordValue(histogram, (uint64_t)MAX(duration * kMicrosecondsPerSecond, 0));
+}
+
+/*! @brief Records the outcome of a request or refresh which completed with the given error.
+ */
+static void OIDMetricsRecordOutcome(OIDMetricsAtomicOutcomes *outcomes, NSError *error) {
+  _Atomic uint64_t *counter;
+  if (!error) {
+    counter = &outcomes->successes;
+  } else if ([OIDErrorUtilities isOAuthErrorDomain:error.domain]) {
+    counter = &outcomes->OAuthErrors;
+  } else {
+    counter = &outcomes->otherErrors;
+  }
+  atomic_fetch_add_explicit(counter, 1, memory_order_relaxed);
+}
+
+/*! @brief Reads a counter, resetting it to zero if requested.
+ */
+static uint64_t OIDMetricsReadCounter(_Atomic uint64_t *counter, BOOL reset) {
+  return reset ? atomic_exchange_explicit(counter, 0, memory_order_relaxed)
+               : atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+/*! @brief Reads a histogram, resetting it to zero if requested.
+ */
+static OIDMetricsHistogram *OIDMetricsReadHistogram(OIDMetricsAtomicHistogram *histogram,
+                                                    BOOL reset) {
+  NSMutableArray<NSNumber *> *bucketCounts =
+      [NSMutableArray arrayWithCapacity:kHistogramBucketCount];
+  for (NSUInteger i = 0; i < kHistogramBucketCount; i++) {
+    [bucketCounts addObject:@(OIDMetricsReadCounter(&histogram->buckets[i], reset))];
+  }
+  uint64_t sum = OIDMetricsReadCounter(&histogram->sum, reset);
+  return [[OIDMetricsHistogram alloc] initWithBucketCounts:bucketCounts sum:sum];
+}
+
+/*! @brief Reads outcome counters, resetting them to zero if requested.
+ */
+static OIDMetricsOutcomeCounts *OIDMetricsReadOutcomes(OIDMetricsAtomicOutcomes *outcomes,
+                                                       BOOL reset) {
+  return [[OIDMetricsOutcomeCounts alloc]
+      initWithSuccesses:OIDMetricsReadCounter(&outcomes->successes, reset)
+            OAuthErrors:OIDMetricsReadCounter(&outcomes->OAuthErrors, reset)
+            otherErrors:OIDMetricsReadCounter(&outcomes->otherErrors, reset)];
+}
+
+@implementation OIDMetricsHistogram
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithBucketCounts:sum:))
+
+- (instancetype)initWithBucketCounts:(NSArray<NSNumber *> *)bucketCounts sum:(uint64_t)sum {
+  self = [super init];
+  if (self) {
+    _bucketCounts = [bucketCounts copy];
+    _sum = sum;
+    uint64_t count = 0;
+    for (NSNumber *bucketCount in _bucketCounts) {
+      count += bucketCount.unsignedLongLongValue;
+    }
+    _count = count;
+  }
+  return self;
+}
+
++ (uint64_t)upperBoundOfBucket:(NSUInteger)bucket {
+  if (bucket >= kHistogramBucketCount - 1) {
+    return UINT64_MAX;
+  }
+  return 1ULL << bucket;
+}
+
+- (double)mean {
+  return _count ? (double)_sum / _count : 0;
+}
+
+- (uint64_t)valueAtPercentile:(double)percentile {
+  if (!_count) {
+    return 0;
+  }
+  uint64_t rank = (uint64_t)ceil(_count * MIN(MAX(percentile, 0), 100) / 100.0);
+  uint64_t seen = 0;
+  for (NSUInteger i = 0; i < _bucketCounts.count; i++) {
+    seen += _bucketCounts[i].unsignedLongLongValue;
+    if (seen >= MAX(rank, 1)) {
+      return [[self class] upperBoundOfBucket:i];
+    }
+  }
+  return UINT64_MAX;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, count: %llu, mean: %.1f, p50: %llu, p99: %llu>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _count,
+                                    self.mean,
+                                    [self valueAtPercentile:50],
+                                    [self valueAtPercentile:99]];
+}
+
+@end
+
+@implementation OIDMetricsOutcomeCounts
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithSuccesses:OAuthErrors:otherErrors:))
+
+- (instancetype)initWithSuccesses:(uint64_t)successes
+                      OAuthErrors:(uint64_t)OAuthErrors
+                      otherErrors:(uint64_t)otherErrors {
+  self = [super init];
+  if (self) {
+    _successes = successes;
+    _OAuthErrors = OAuthErrors;
+    _otherErrors = otherErrors;
+  }
+  return self;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, successes: %llu, OAuthErrors: %llu, "
+                                     "otherErrors: %llu>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    _successes,
+                                    _OAuthErrors,
+                                    _otherErrors];
+}
+
+@end
+
+@interface OIDMetricsSnapshot ()
+
+/*! @brief Creates a snapshot from per-endpoint metrics, each array indexed by endpoint.
+ */
+- (instancetype)initWithLatency:(NSArray<OIDMetricsHistogram *> *)latency
+                      bytesSent:(NSArray<OIDMetricsHistogram *> *)bytesSent
+                  bytesReceived:(NSArray<OIDMetricsHistogram *> *)bytesReceived
+                       outcomes:(NSArray<OIDMetricsOutcomeCounts *> *)outcomes
+                 tokenRefreshes:(OIDMetricsOutcomeCounts *)tokenRefreshes
+            tokenRefreshRetries:(uint64_t)tokenRefreshRetries
+             pendingActionDepth:(OIDMetricsHistogram *)pendingActionDepth
+              pendingActionWait:(OIDMetricsHistogram *)pendingActionWait
+    NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation OIDMetricsSnapshot {
+  NSArray<OIDMetricsHistogram *> *_latency;
+  NSArray<OIDMetricsHistogram *> *_bytesSent;
+  NSArray<OIDMetricsHistogram *> *_bytesReceived;
+  NSArray<OIDMetricsOutcomeCounts *> *_outcomes;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithLatency:
+                        bytesSent:
+                    bytesReceived:
+                         outcomes:
+                   tokenRefreshes:
+              tokenRefreshRetries:
+               pendingActionDepth:
+                pendingActionWait:))
+
+- (instancetype)initWithLatency:(NSArray<OIDMetricsHistogram *> *)latency
+                      bytesSent:(NSArray<OIDMetricsHistogram *> *)bytesSent
+                  bytesReceived:(NSArray<OIDMetricsHistogram *> *)bytesReceived
+                       outcomes:(NSArray<OIDMetricsOutcomeCounts *> *)outcomes
+                 tokenRefreshes:(OIDMetricsOutcomeCounts *)tokenRefreshes
+            tokenRefreshRetries:(uint64_t)tokenRefreshRetries
+             pendingActionDepth:(OIDMetricsHistogram *)pendingActionDepth
+              pendingActionWait:(OIDMetricsHistogram *)pendingActionWait {
+  self = [super init];
+  if (self) {
+    _latency = [latency copy];
+    _bytesSent = [bytesSent copy];
+    _bytesReceived = [bytesReceived copy];
+    _outcomes = [outcomes copy];
+    _tokenRefreshes = tokenRefreshes;
+    _tokenRefreshRetries = tokenRefreshRetries;
+    _pendingActionDepth = pendingActionDepth;
+    _pendingActionWait = pendingActionWait;
+  }
+  return self;
+}
+
+- (OIDMetricsHistogram *)latencyForEndpoint:(OIDMetricsEndpoint)endpoint {
+  return _latency[endpoint];
+}
+
+- (OIDMetricsHistogram *)bytesSentForEndpoint:(OIDMetricsEndpoint)endpoint {
+  return _bytesSent[endpoint];
+}
+
+- (OIDMetricsHistogram *)bytesReceivedForEndpoint:(OIDMetricsEndpoint)endpoint {
+  return _bytesReceived[endpoint];
+}
+
+- (OIDMetricsOutcomeCounts *)outcomesForEndpoint:(OIDMetricsEndpoint)endpoint {
+  return _outcomes[endpoint];
+}
+
+@end
+
+@implementation OIDMetricsAggregator {
+  OIDMetricsAtomicHistogram _latency[kEndpointCount];
+  OIDMetricsAtomicHistogram _bytesSent[kEndpointCount];
+  OIDMetricsAtomicHistogram _bytesReceived[kEndpointCount];
+  OIDMetricsAtomicOutcomes _outcomes[kEndpointCount];
+  OIDMetricsAtomicOutcomes _tokenRefreshes;
+  _Atomic uint64_t _tokenRefreshRetries;
+  OIDMetricsAtomicHistogram _pendingActionDepth;
+  OIDMetricsAtomicHistogram _pendingActionWait;
+}
+
+- (OIDMetricsSnapshot *)snapshot {
+  return [self snapshotResetting:NO];
+}
+
+- (OIDMetricsSnapshot *)snapshotAndReset {
+  return [self snapshotResetting:YES];
+}
+
+- (OIDMetricsSnapshot *)snapshotResetting:(BOOL)reset {
+  NSMutableArray<OIDMetricsHistogram *> *latency = [NSMutableArray array];
+  NSMutableArray<OIDMetricsHistogram *> *bytesSent = [NSMutableArray array];
+  NSMutableArray<OIDMetricsHistogram *> *bytesReceived = [NSMutableArray array];
+  NSMutableArray<OIDMetricsOutcomeCounts *> *outcomes = [NSMutableArray array];
+  for (NSUInteger endpoint = 0; endpoint < kEndpointCount; endpoint++) {
+    [latency addObject:OIDMetricsReadHistogram(&_latency[endpoint], reset)];
+    [bytesSent addObject:OIDMetricsReadHistogram(&_bytesSent[endpoint], reset)];
+    [bytesReceived addObject:OIDMetricsReadHistogram(&_bytesReceived[endpoint], reset)];
+    [outcomes addObject:OIDMetricsReadOutcomes(&_outcomes[endpoint], reset)];
+  }
+  return [[OIDMetricsSnapshot alloc]
+         initWithLatency:latency
+               bytesSent:bytesSent
+           bytesReceived:bytesReceived
+                outcomes:outcomes
+          tokenRefreshes:OIDMetricsReadOutcomes(&_tokenRefreshes, reset)
+     tokenRefreshRetries:OIDMetricsReadCounter(&_tokenRefreshRetries, reset)
+      pendingActionDepth:OIDMetricsReadHistogram(&_pendingActionDepth, reset)
+       pendingActionWait:OIDMetricsReadHistogram(&_pendingActionWait, reset)];
+}
+
+#pragma mark - OIDMetricsObserver
+
+- (void)requestToEndpoint:(OIDMetricsEndpoint)endpoint
+    didCompleteWithLatency:(NSTimeInterval)latency
+                 bytesSent:(NSUInteger)bytesSent
+             bytesReceived:(NSUInteger)bytesReceived
+                     error:(nullable NSError *)error {
+  if (endpoint < 0 || endpoint >= kEndpointCount) {
+    return;
+  }
+  OIDMetricsRecordDuration(&_latency[endpoint], latency);
+  OIDMetricsRecordValue(&_bytesSent[endpoint], bytesSent);
+  OIDMetricsRecordValue(&_bytesReceived[endpoint], bytesReceived);
+  OIDMetricsRecordOutcome(&_outcomes[endpoint], error);
+}
+
+- (void)tokenRefreshDidCompleteWithError:(nullable NSError *)error {
+  OIDMetricsRecordOutcome(&_tokenRefreshes, error);
+}
+
+- (void)tokenRefreshWillRetryAfterError:(NSError *)error {
+  atomic_fetch_add_explicit(&_tokenRefreshRetries, 1, memory_order_relaxed);
+}
+
+- (void)pendingActionQueuedWithDepth:(NSUInteger)depth {
+  OIDMetricsRecordValue(&_pendingActionDepth, depth);
+}
+
+- (void)pendingActionDispatchedAfterWaiting:(NSTimeInterval)duration {
+  OIDMetricsRecordDuration(&_pendingActionWait, duration);
+}
+
+@end
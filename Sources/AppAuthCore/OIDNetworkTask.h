@@ -0,0 +1,113 @@
+/*! @file OIDNetworkTask.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "OIDTokenRequestScheduler.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Called once when an @c OIDNetworkTask is cancelled or misses its deadline before it
+        finished.
+    @param error An @c OIDErrorCodeNetworkError whose underlying error is @c NSURLErrorCancelled
+        or @c NSURLErrorTimedOut.
+ */
+typedef void (^OIDNetworkTaskCancellationHandler)(NSError *error);
+
+/*! @brief A handle to a network operation, such as a token request, which can be cancelled.
+    @discussion When cancelled, or when its deadline passes first, the operation stops: its
+        @c NSURLSessionTask is cancelled, no more work is done on its response, and its callback is
+        called with an @c OIDErrorCodeNetworkError whose underlying error is
+        @c NSURLErrorCancelled, or @c NSURLErrorTimedOut for a missed deadline. Either way the
+        callback is called exactly once. Cancelling a finished operation has no effect.
+ */
+@interface OIDNetworkTask : NSObject
+
+/*! @brief Whether the operation was cancelled, or missed its deadline.
+ */
+@property(nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/*! @brief Whether the operation finished, was cancelled or missed its deadline.
+ */
+@property(nonatomic, readonly, getter=isFinished) BOOL finished;
+
+/*! @internal
+    @brief Unavailable. Use @c initWithTimeout:cancellationHandler:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @internal
+    @brief Creates the handle of an operation.
+    @param timeout The time in seconds the operation has to finish in, or 0 for no deadline.
+        Unlike @c NSURLRequest.timeoutInterval, which limits the time between packets, this bounds
+        the whole operation.
+    @param cancellationHandler Called on an arbitrary queue if the operation is cancelled or misses
+        its deadline before finishing.
+ */
+- (instancetype)initWithTimeout:(NSTimeInterval)timeout
+            cancellationHandler:(OIDNetworkTaskCancellationHandler)cancellationHandler
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @internal
+    @brief Returns the handle of an operation which finished without starting, such as a request
+        failing before being sent.
+ */
++ (instancetype)finishedTask;
+
+/*! @internal
+    @brief Sets the session task performing the operation, which is cancelled along with it. If
+        the operation was already cancelled, the session task is cancelled right away.
+    @param sessionTask The session task.
+ */
+- (void)setSessionTask:(NSURLSessionTask *)sessionTask;
+
+/*! @internal
+    @brief Sets the token request performing the operation, whose priority can be raised.
+    @param scheduledRequest The token request.
+ */
+- (void)setScheduledRequest:(OIDScheduledTokenRequest *)scheduledRequest;
+
+/*! @internal
+    @brief Marks the operation as finished, unless it was cancelled first.
+    @return YES if the operation finished, in which case its result should be delivered, NO if it
+        was cancelled, in which case the cancellation handler has delivered the error instead.
+ */
+- (BOOL)finish;
+
+/*! @brief Cancels the operation, unless it has finished.
+ */
+- (void)cancel;
+
+/*! @internal
+    @brief Cancels a token request only while it waits in the @c OIDTokenRequestScheduler, before
+        it is sent. A request the server may have received is left to complete, as its response
+        may carry a rotated refresh token.
+    @return YES if the operation is cancelled, NO if it is running or finished.
+ */
+- (BOOL)cancelUnlessSent;
+
+/*! @brief Raises the priority of a token request which has not finished, as when a user starts
+        waiting for it. A request waiting in the @c OIDTokenRequestScheduler.sharedScheduler moves
+        to the queue of its new priority class. Has no effect on other operations.
+    @param priority The new priority, ignored unless higher than the current one.
+ */
+- (void)raisePriority:(OIDTokenRequestPriority)priority;
+
+@end
+
+NS_ASSUME_NONNULL_END
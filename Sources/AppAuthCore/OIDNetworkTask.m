@@ -0,0 +1,188 @@
+/*! @file OIDNetworkTask.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDNetworkTask.h"
+
+#import "OIDDefines.h"
+#import "OIDError.h"
+#import "OIDErrorUtilities.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@implementation OIDNetworkTask {
+  /*! @brief Called if the operation is cancelled. Cleared once the operation has finished or was
+          cancelled. Guarded by @synchronized(self).
+   */
+  OIDNetworkTaskCancellationHandler _Nullable _cancellationHandler;
+
+  /*! @brief The session task performing the operation, if any. Guarded by @synchronized(self).
+   */
+  NSURLSessionTask *_Nullable _sessionTask;
+
+  /*! @brief The token request performing the operation, if any. Guarded by @synchronized(self).
+   */
+  OIDScheduledTokenRequest *_Nullable _scheduledRequest;
+}
+
+@synthesize cancelled = _cancelled;
+@synthesize finished = _finished;
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithTimeout:cancellationHandler:))
+
+- (instancetype)initWithTimeout:(NSTimeInterval)timeout
+            cancellationHandler:(OIDNetworkTaskCancellationHandler)cancellationHandler {
+  self = [super init];
+  if (self) {
+    _cancellationHandler = [cancellationHandler copy];
+    if (timeout > 0) {
+      // the operation retains its handle until it completes, so a released handle has finished
+      __weak OIDNetworkTask *weakSelf = self;
+      dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)),
+                     dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        NSString *description = [NSString stringWithFormat:@"The request did not complete within "
+                                                            "its deadline of %g seconds.",
+                                                           timeout];
+        [weakSelf cancelWithUnderlyingErrorCode:NSURLErrorTimedOut
+                                    description:description
+                                     unlessSent:NO];
+      });
+    }
+  }
+  return self;
+}
+
++ (instancetype)finishedTask {
+  OIDNetworkTask *task = [[self alloc] initWithTimeout:0 cancellationHandler:^(NSError *error) {
+  }];
+  [task finish];
+  return task;
+}
+
+- (BOOL)isCancelled {
+  @synchronized(self) {
+    return _cancelled;
+  }
+}
+
+- (BOOL)isFinished {
+  @synchronized(self) {
+    return _finished;
+  }
+}
+
+- (void)setSessionTask:(NSURLSessionTask *)sessionTask {
+  @synchronized(self) {
+    if (!_finished) {
+      _sessionTask = sessionTask;
+      return;
+    }
+    if (!_cancelled) {
+      return;
+    }
+  }
+  [sessionTask cancel];
+}
+
+- (void)setScheduledRequest:(OIDScheduledTokenRequest *)scheduledRequest {
+  @synchronized(self) {
+    if (!_finished) {
+      _scheduledRequest = scheduledRequest;
+    }
+  }
+}
+
+- (BOOL)finish {
+  @synchronized(self) {
+    if (_finished) {
+      return NO;
+    }
+    _finished = YES;
+    _cancellationHandler = nil;
+    _sessionTask = nil;
+    _scheduledRequest = nil;
+    return YES;
+  }
+}
+
+- (void)raisePriority:(OIDTokenRequestPriority)priority {
+  OIDScheduledTokenRequest *scheduledRequest;
+  @synchronized(self) {
+    scheduledRequest = _scheduledRequest;
+  }
+  [scheduledRequest raisePriority:priority];
+}
+
+- (void)cancel {
+  [self cancelWithUnderlyingErrorCode:NSURLErrorCancelled
+                          description:@"The request was cancelled."
+                           unlessSent:NO];
+}
+
+- (BOOL)cancelUnlessSent {
+  return [self cancelWithUnderlyingErrorCode:NSURLErrorCancelled
+                                 description:@"The request was cancelled."
+                                  unlessSent:YES];
+}
+
+/*! @brief Cancels the operation, unless it has finished.
+    @param code The code of the @c NSURLErrorDomain error underlying the error delivered.
+    @param description The description of the error delivered.
+    @param unlessSent Whether to leave the operation running if its token request is not waiting
+        in the scheduler any more.
+    @return Whether the operation is cancelled.
+ */
+- (BOOL)cancelWithUnderlyingErrorCode:(NSInteger)code
+                          description:(NSString *)description
+                           unlessSent:(BOOL)unlessSent {
+  OIDNetworkTaskCancellationHandler cancellationHandler;
+  NSURLSessionTask *sessionTask;
+  OIDScheduledTokenRequest *scheduledRequest;
+  @synchronized(self) {
+    if (_finished) {
+      return _cancelled;
+    }
+    // the session task is set before it is resumed, so without one the request was not sent
+    if (unlessSent && (_sessionTask || !_scheduledRequest)) {
+      return NO;
+    }
+    _finished = YES;
+    _cancelled = YES;
+    cancellationHandler = _cancellationHandler;
+    sessionTask = _sessionTask;
+    scheduledRequest = _scheduledRequest;
+    _cancellationHandler = nil;
+    _sessionTask = nil;
+    _scheduledRequest = nil;
+  }
+  [sessionTask cancel];
+  // gives up the place of the request in the scheduler, if still waiting
+  [scheduledRequest complete];
+  NSError *underlyingError =
+      [NSError errorWithDomain:NSURLErrorDomain
+                          code:code
+                      userInfo:@{ NSLocalizedDescriptionKey : description }];
+  cancellationHandler([OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
+                                       underlyingError:underlyingError
+                                           description:description]);
+  return YES;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -20,6 +20,7 @@
 
 #import "OIDClientMetadataParameters.h"
 #import "OIDDefines.h"
+#import "OIDFieldMapping.h"
 #import "OIDServiceConfiguration.h"
 
 /*! @brief The key for the @c configuration property for @c NSSecureCoding
@@ -130,24 +131,26 @@ static NSString *const kAdditionalParametersKey = @"additionalParameters";
                          forKey:kConfigurationKey];
   NSString *initialAccessToken = [aDecoder decodeObjectOfClass:[NSString class]
                                                         forKey:kInitialAccessToken];
+  static NSSet *URLArrayClasses;
+  static NSSet *stringArrayClasses;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    URLArrayClasses = [NSSet setWithArray:@[[NSArray class], [NSURL class]]];
+    stringArrayClasses = [NSSet setWithArray:@[[NSArray class], [NSString class]]];
+  });
   NSArray<NSURL *> *redirectURIs =
-      [aDecoder decodeObjectOfClasses:[NSSet setWithArray:@[[NSArray class], [NSURL class]]]
-                               forKey:kRedirectURIsKey];
+      [aDecoder decodeObjectOfClasses:URLArrayClasses forKey:kRedirectURIsKey];
   NSArray<NSString *> *responseTypes =
-      [aDecoder decodeObjectOfClasses:[NSSet setWithArray:@[[NSArray class], [NSString class]]]
-                               forKey:kResponseTypesKey];
+      [aDecoder decodeObjectOfClasses:stringArrayClasses forKey:kResponseTypesKey];
   NSArray<NSString *> *grantTypes =
-      [aDecoder decodeObjectOfClasses:[NSSet setWithArray:@[[NSArray class], [NSString class]]]
-                               forKey:kGrantTypesKey];
+      [aDecoder decodeObjectOfClasses:stringArrayClasses forKey:kGrantTypesKey];
   NSString *subjectType = [aDecoder decodeObjectOfClass:[NSString class]
                                                  forKey:kSubjectTypeKey];
   NSString *tokenEndpointAuthenticationMethod =
       [aDecoder decodeObjectOfClass:[NSString class]
                              forKey:OIDTokenEndpointAuthenticationMethodParam];
-  NSSet *additionalParameterCodingClasses = [NSSet setWithArray:@[ [NSDictionary class],
-                                                                   [NSString class] ]];
   NSDictionary *additionalParameters =
-      [aDecoder decodeObjectOfClasses:additionalParameterCodingClasses
+      [aDecoder decodeObjectOfClasses:[OIDFieldMapping stringDictionaryTypes]
                                forKey:kAdditionalParametersKey];
   self = [self initWithConfiguration:configuration
                         redirectURIs:redirectURIs
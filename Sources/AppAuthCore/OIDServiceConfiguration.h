@@ -31,6 +31,9 @@ typedef void (^OIDServiceConfigurationCreated)
      NSError *_Nullable error);
 
 /*! @brief Represents the information needed to construct a @c OIDAuthorizationService.
+    @discussion Configurations are immutable and interned: creating or decoding a configuration
+        identical to one which is still alive returns that instance, so the many
+        @c OIDAuthState objects of the same issuer share a single configuration.
  */
 @interface OIDServiceConfiguration : NSObject <NSCopying, NSSecureCoding>
 
@@ -20,6 +20,7 @@
 
 #import "OIDDefines.h"
 #import "OIDErrorUtilities.h"
+#import "OIDFieldMapping.h"
 #import "OIDServiceDiscovery.h"
 
 /*! @brief The key for the @c authorizationEndpoint property.
@@ -46,8 +47,29 @@ static NSString *const kEndSessionEndpointKey = @"endSessionEndpoint";
  */
 static NSString *const kDiscoveryDocumentKey = @"discoveryDocument";
 
+/*! @brief The live configurations by @c OIDServiceConfigurationInternKey, held weakly so that
+        identical configurations share one instance. Guarded by @synchronized on
+        @c OIDServiceConfiguration.
+ */
+static NSMapTable<NSString *, OIDServiceConfiguration *> *gInternedConfigurations;
+
 NS_ASSUME_NONNULL_BEGIN
 
+/*! @brief Returns the key under which a configuration with these endpoints is interned.
+ */
+static NSString *OIDServiceConfigurationInternKey(NSURL *authorizationEndpoint,
+                                                  NSURL *tokenEndpoint,
+                                                  NSURL *_Nullable issuer,
+                                                  NSURL *_Nullable registrationEndpoint,
+                                                  NSURL *_Nullable endSessionEndpoint) {
+  return [NSString stringWithFormat:@"%@ %@ %@ %@ %@",
+                                    authorizationEndpoint.absoluteString,
+                                    tokenEndpoint.absoluteString,
+                                    issuer.absoluteString ?: @"",
+                                    registrationEndpoint.absoluteString ?: @"",
+                                    endSessionEndpoint.absoluteString ?: @""];
+}
+
 @interface OIDServiceConfiguration ()
 
 - (instancetype)initWithAuthorizationEndpoint:(NSURL *)authorizationEndpoint
@@ -74,6 +96,25 @@ NS_ASSUME_NONNULL_BEGIN
  registrationEndpoint:(nullable NSURL *)registrationEndpoint
    endSessionEndpoint:(nullable NSURL *)endSessionEndpoint
     discoveryDocument:(nullable OIDServiceDiscovery *)discoveryDocument {
+  // Configurations are immutable, so an identical live configuration is returned instead of
+  // creating another one. Subclasses are never interned.
+  NSString *internKey;
+  if ([self class] == [OIDServiceConfiguration class]) {
+    internKey = OIDServiceConfigurationInternKey(authorizationEndpoint,
+                                                 tokenEndpoint,
+                                                 issuer,
+                                                 registrationEndpoint,
+                                                 endSessionEndpoint);
+    @synchronized([OIDServiceConfiguration class]) {
+      OIDServiceConfiguration *interned = [gInternedConfigurations objectForKey:internKey];
+      OIDServiceDiscovery *internedDocument = interned.discoveryDocument;
+      if (interned && (internedDocument == discoveryDocument ||
+                       [internedDocument.discoveryDictionary
+                           isEqualToDictionary:discoveryDocument.discoveryDictionary])) {
+        return interned;
+      }
+    }
+  }
 
   self = [super init];
   if (self) {
@@ -83,6 +124,15 @@ NS_ASSUME_NONNULL_BEGIN
     _registrationEndpoint = [registrationEndpoint copy];
     _endSessionEndpoint = [endSessionEndpoint copy];
     _discoveryDocument = [discoveryDocument copy];
+
+    if (internKey) {
+      @synchronized([OIDServiceConfiguration class]) {
+        if (!gInternedConfigurations) {
+          gInternedConfigurations = [NSMapTable strongToWeakObjectsMapTable];
+        }
+        [gInternedConfigurations setObject:self forKey:internKey];
+      }
+    }
   }
   return self;
 }
@@ -185,15 +235,14 @@ NS_ASSUME_NONNULL_BEGIN
     return nil;
   }
 
-  NSSet<Class> *allowedClasses = [NSSet setWithArray:@[[OIDServiceDiscovery class],
-                                                       // The following classes are required in
-                                                       // order to support secure decoding of the
-                                                       // old OIDServiceDiscovery encoding.
-                                                       [NSDictionary class],
-                                                       [NSArray class],
-                                                       [NSString class],
-                                                       [NSNumber class],
-                                                       [NSNull class]]];
+  static NSSet<Class> *allowedClasses;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    // The JSON classes are required in order to support secure decoding of the old
+    // OIDServiceDiscovery encoding.
+    allowedClasses = [[OIDFieldMapping JSONTypesIncludingNull]
+        setByAddingObject:[OIDServiceDiscovery class]];
+  });
   OIDServiceDiscovery *discoveryDocument = [aDecoder decodeObjectOfClasses:allowedClasses
                                                                     forKey:kDiscoveryDocumentKey];
 
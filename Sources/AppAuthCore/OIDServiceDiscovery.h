@@ -21,6 +21,8 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /*! @brief Represents an OpenID Connect 1.0 Discovery Document
+    @discussion Documents are immutable and interned by issuer: creating or decoding a document
+        identical to one which is still alive returns that instance.
     @see https://openid.net/specs/openid-connect-discovery-1_0.html#ProviderMetadata
  */
 @interface OIDServiceDiscovery : NSObject <NSCopying, NSSecureCoding>
@@ -20,6 +20,7 @@
 
 #import "OIDDefines.h"
 #import "OIDErrorUtilities.h"
+#import "OIDFieldMapping.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -77,8 +78,39 @@ static NSString *const kRequireRequestURIRegistrationKey = @"require_request_uri
 static NSString *const kOPPolicyURIKey = @"op_policy_uri";
 static NSString *const kOPTosURIKey = @"op_tos_uri";
 
+/*! @brief The live discovery documents by issuer, held weakly so that identical documents share
+        one instance. Guarded by @synchronized on @c OIDServiceDiscovery.
+ */
+static NSMapTable<NSString *, OIDServiceDiscovery *> *gInternedDocuments;
+
+/*! @brief Returns the URL for a field of a discovery document, or nil if the field is missing or
+        isn't a valid URL string.
+    @param dictionary The discovery document.
+    @param field The field key.
+ */
+static NSURL *_Nullable OIDURLForField(NSDictionary *dictionary, NSString *field) {
+  id value = dictionary[field];
+  if (![value isKindOfClass:[NSString class]]) {
+    return nil;
+  }
+  return [NSURL URLWithString:value];
+}
+
 @implementation OIDServiceDiscovery {
   NSDictionary *_discoveryDictionary;
+
+  // URL fields, parsed once when the document is validated rather than on every access.
+  NSURL *_issuer;
+  NSURL *_authorizationEndpoint;
+  NSURL *_Nullable _deviceAuthorizationEndpoint;
+  NSURL *_tokenEndpoint;
+  NSURL *_Nullable _userinfoEndpoint;
+  NSURL *_jwksURL;
+  NSURL *_Nullable _registrationEndpoint;
+  NSURL *_Nullable _endSessionEndpoint;
+  NSURL *_Nullable _serviceDocumentation;
+  NSURL *_Nullable _OPPolicyURI;
+  NSURL *_Nullable _OPTosURI;
 }
 
 - (nonnull instancetype)init OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithDictionary:error:))
@@ -114,9 +146,62 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
   if (![[self class] dictionaryHasRequiredFields:serviceDiscoveryDictionary error:error]) {
     return nil;
   }
+
+  // Documents are immutable, so an identical live document of the same issuer is returned instead
+  // of parsing another one. Subclasses are never interned.
+  NSString *internKey;
+  if ([self class] == [OIDServiceDiscovery class] &&
+      [serviceDiscoveryDictionary[kIssuerKey] isKindOfClass:[NSString class]]) {
+    internKey = serviceDiscoveryDictionary[kIssuerKey];
+    @synchronized([OIDServiceDiscovery class]) {
+      OIDServiceDiscovery *interned = [gInternedDocuments objectForKey:internKey];
+      if (interned &&
+          [interned->_discoveryDictionary isEqualToDictionary:serviceDiscoveryDictionary]) {
+        return interned;
+      }
+    }
+  }
+
   self = [super init];
   if (self) {
     _discoveryDictionary = [serviceDiscoveryDictionary copy];
+
+    _issuer = OIDURLForField(_discoveryDictionary, kIssuerKey);
+    _authorizationEndpoint = OIDURLForField(_discoveryDictionary, kAuthorizationEndpointKey);
+    _deviceAuthorizationEndpoint =
+        OIDURLForField(_discoveryDictionary, kDeviceAuthorizationEndpointKey);
+    _tokenEndpoint = OIDURLForField(_discoveryDictionary, kTokenEndpointKey);
+    _userinfoEndpoint = OIDURLForField(_discoveryDictionary, kUserinfoEndpointKey);
+    _jwksURL = OIDURLForField(_discoveryDictionary, kJWKSURLKey);
+    _registrationEndpoint = OIDURLForField(_discoveryDictionary, kRegistrationEndpointKey);
+    _endSessionEndpoint = OIDURLForField(_discoveryDictionary, kEndSessionEndpointKey);
+    _serviceDocumentation = OIDURLForField(_discoveryDictionary, kServiceDocumentationKey);
+    _OPPolicyURI = OIDURLForField(_discoveryDictionary, kOPPolicyURIKey);
+    _OPTosURI = OIDURLForField(_discoveryDictionary, kOPTosURIKey);
+
+    // Check required URL fields are valid URLs.
+    NSString *invalidURLField = !_issuer ? kIssuerKey
+        : !_tokenEndpoint ? kTokenEndpointKey
+        : !_jwksURL ? kJWKSURLKey
+        : nil;
+    if (invalidURLField) {
+      if (error) {
+        NSString *errorText = [NSString stringWithFormat:@"Invalid URL: %@", invalidURLField];
+        *error = [OIDErrorUtilities errorWithCode:OIDErrorCodeInvalidDiscoveryDocument
+                                  underlyingError:nil
+                                      description:errorText];
+      }
+      return nil;
+    }
+
+    if (internKey) {
+      @synchronized([OIDServiceDiscovery class]) {
+        if (!gInternedDocuments) {
+          gInternedDocuments = [NSMapTable strongToWeakObjectsMapTable];
+        }
+        [gInternedDocuments setObject:self forKey:internKey];
+      }
+    }
   }
   return self;
 }
@@ -127,22 +212,26 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
     @discussion This test is not meant to provide semantic analysis of the document (eg. fields
         where the value @c none is not an allowed option would not cause this method to fail if
         their value was @c none.) We are just testing to make sure we can meet the nullability
-        contract we promised in the header.
+        contract we promised in the header. Required URL fields are validated by
+        @c initWithDictionary:error: as they are parsed.
  */
 + (BOOL)dictionaryHasRequiredFields:(NSDictionary<NSString *, id> *)dictionary
                               error:(NSError **_Nullable)error {
   static NSString *const kMissingFieldErrorText = @"Missing field: %@";
-  static NSString *const kInvalidURLFieldErrorText = @"Invalid URL: %@";
-
-  NSArray *requiredFields = @[
-    kIssuerKey,
-    kAuthorizationEndpointKey,
-    kTokenEndpointKey,
-    kJWKSURLKey,
-    kResponseTypesSupportedKey,
-    kSubjectTypesSupportedKey,
-    kIDTokenSigningAlgorithmValuesSupportedKey
-  ];
+
+  static NSArray<NSString *> *requiredFields;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    requiredFields = @[
+      kIssuerKey,
+      kAuthorizationEndpointKey,
+      kTokenEndpointKey,
+      kJWKSURLKey,
+      kResponseTypesSupportedKey,
+      kSubjectTypesSupportedKey,
+      kIDTokenSigningAlgorithmValuesSupportedKey
+    ];
+  });
 
   for (NSString *field in requiredFields) {
     if (!dictionary[field]) {
@@ -156,25 +245,6 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
     }
   }
 
-  // Check required URL fields are valid URLs.
-  NSArray *requiredURLFields = @[
-    kIssuerKey,
-    kTokenEndpointKey,
-    kJWKSURLKey
-  ];
-
-  for (NSString *field in requiredURLFields) {
-    if (![NSURL URLWithString:dictionary[field]]) {
-      if (error) {
-        NSString *errorText = [NSString stringWithFormat:kInvalidURLFieldErrorText, field];
-        *error = [OIDErrorUtilities errorWithCode:OIDErrorCodeInvalidDiscoveryDocument
-                                  underlyingError:nil
-                                      description:errorText];
-      }
-      return NO;
-    }
-  }
-
   return YES;
 }
 
@@ -201,12 +271,7 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
     // We're decoding a collection type (NSDictionary) from NSJSONSerialization's
     // +JSONObjectWithData, so we need to include all classes that could potentially be contained
     // within.
-    NSSet<Class> *allowedClasses = [NSSet setWithArray:@[[NSDictionary class],
-                                                         [NSArray class],
-                                                         [NSString class],
-                                                         [NSNumber class],
-                                                         [NSNull class]]];
-    dictionary = [aDecoder decodeObjectOfClasses:allowedClasses
+    dictionary = [aDecoder decodeObjectOfClasses:[OIDFieldMapping JSONTypesIncludingNull]
                                           forKey:kDiscoveryDictionaryKey];
   } else {
     // Decode using the old encoding which delegated to NSDictionary's encodeWithCoder:
@@ -237,35 +302,35 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
 }
 
 - (NSURL *)issuer {
-  return [NSURL URLWithString:_discoveryDictionary[kIssuerKey]];
+  return _issuer;
 }
 
 - (NSURL *)authorizationEndpoint {
-  return [NSURL URLWithString:_discoveryDictionary[kAuthorizationEndpointKey]];
+  return _authorizationEndpoint;
 }
 
 - (nullable NSURL *)deviceAuthorizationEndpoint {
-  return [NSURL URLWithString:_discoveryDictionary[kDeviceAuthorizationEndpointKey]];
+  return _deviceAuthorizationEndpoint;
 }
 
 - (NSURL *)tokenEndpoint {
-  return [NSURL URLWithString:_discoveryDictionary[kTokenEndpointKey]];
+  return _tokenEndpoint;
 }
 
 - (nullable NSURL *)userinfoEndpoint {
-  return [NSURL URLWithString:_discoveryDictionary[kUserinfoEndpointKey]];
+  return _userinfoEndpoint;
 }
 
 - (NSURL *)jwksURL {
-  return [NSURL URLWithString:_discoveryDictionary[kJWKSURLKey]];
+  return _jwksURL;
 }
 
 - (nullable NSURL *)registrationEndpoint {
-  return [NSURL URLWithString:_discoveryDictionary[kRegistrationEndpointKey]];
+  return _registrationEndpoint;
 }
 
 - (nullable NSURL *)endSessionEndpoint {
-    return [NSURL URLWithString:_discoveryDictionary[kEndSessionEndpointKey]];
+  return _endSessionEndpoint;
 }
 
 - (nullable NSArray<NSString *> *)scopesSupported {
@@ -349,7 +414,7 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
 }
 
 - (nullable NSURL *)serviceDocumentation {
-  return [NSURL URLWithString:_discoveryDictionary[kServiceDocumentationKey]];
+  return _serviceDocumentation;
 }
 
 - (nullable NSArray<NSString *> *)claimsLocalesSupported {
@@ -381,11 +446,11 @@ static NSString *const kOPTosURIKey = @"op_tos_uri";
 }
 
 - (nullable NSURL *)OPPolicyURI {
-  return [NSURL URLWithString:_discoveryDictionary[kOPPolicyURIKey]];
+  return _OPPolicyURI;
 }
 
 - (nullable NSURL *)OPTosURI {
-  return [NSURL URLWithString:_discoveryDictionary[kOPTosURIKey]];
+  return _OPTosURI;
 }
 
 @end
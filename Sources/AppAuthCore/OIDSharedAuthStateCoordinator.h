@@ -0,0 +1,103 @@
+/*! @file OIDSharedAuthStateCoordinator.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "OIDAuthState.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Coordinates the token refreshes of an authorization shared by several processes, such as
+        an app and its extensions.
+    @discussion Each process creates a coordinator for its own copy of the @c OIDAuthState, with
+        the same directory, typically an app group container, and the same identifier. When the
+        access token needs refreshing, the coordinator adopts the tokens of the state file in that
+        directory if another process has refreshed them since. Only if those tokens are not fresh
+        either does it refresh, after taking a lease on the refresh for
+        @c refreshLeaseDuration, and it writes the refreshed state to the state file once done.
+        While another process holds an unexpired lease, the coordinator waits for its tokens
+        instead of refreshing. So only one process refreshes at a time, refresh token rotation is
+        not raced, and the other processes pick up the new tokens without a network round trip.
+
+        The lease and the state file are read and written under an exclusive @c flock on a lock
+        file, which is never held during the refresh itself. This matters in app group
+        containers, where iOS terminates a suspended process holding a file lock, and it keeps a
+        stalled token endpoint from blocking the other processes beyond the lease.
+
+        A refresh outlasting its lease is not interrupted, but another process may then refresh
+        too. Its result is only written to the state file if no other process wrote it since the
+        lease was taken, and with refresh token rotation one of the two refresh tokens may be
+        invalidated by the server.
+
+        Coordination is opt-in: it applies to refreshes performed through
+        @c performActionWithFreshTokens:. If the lock file cannot be opened, the refresh is
+        performed without coordination.
+ */
+@interface OIDSharedAuthStateCoordinator : NSObject
+
+/*! @brief This process's copy of the authorization state.
+ */
+@property(nonatomic, readonly) OIDAuthState *authState;
+
+/*! @brief The file locked for a moment while a process reads or writes the lease and the state
+        file. It is never held during the refresh itself: a process finding the lease taken
+        releases it, and polls the state file until the refreshed tokens appear or the lease
+        expires.
+ */
+@property(nonatomic, readonly) NSURL *lockFileURL;
+
+/*! @brief The file holding the archived authorization state last refreshed by any process.
+ */
+@property(nonatomic, readonly) NSURL *stateFileURL;
+
+/*! @brief The file recording which process is refreshing the tokens, and until when.
+ */
+@property(nonatomic, readonly) NSURL *leaseFileURL;
+
+/*! @brief How long another process waits for this one to refresh the tokens before it may refresh
+        them itself, in seconds. Defaults to 30. Should exceed the time the token endpoint takes
+        to answer.
+ */
+@property(atomic) NSTimeInterval refreshLeaseDuration;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithAuthState:directoryURL:identifier:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param authState This process's copy of the authorization state.
+    @param directoryURL A directory shared by the processes, such as an app group container.
+    @param identifier Identifies the authorization among others shared in the same directory.
+ */
+- (instancetype)initWithAuthState:(OIDAuthState *)authState
+                     directoryURL:(NSURL *)directoryURL
+                       identifier:(NSString *)identifier NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Calls the block with fresh tokens, refreshing them in coordination with the other
+        processes if needed.
+    @param action The block to call on the main queue with the fresh tokens, or the error if they
+        could not be refreshed.
+    @discussion Calls made while a coordinated refresh is in progress are completed with its
+        result.
+ */
+- (void)performActionWithFreshTokens:(OIDAuthStateAction)action;
+
+@end
+
+NS_ASSUME_NONNULL_END
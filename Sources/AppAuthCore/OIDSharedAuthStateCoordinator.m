@@ -0,0 +1,290 @@
+/*! @file OIDSharedAuthStateCoordinator.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDSharedAuthStateCoordinator.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <sys/file.h>
+#import <unistd.h>
+
+#import "OIDAuthStateSnapshot.h"
+#import "OIDDefines.h"
+
+/*! @brief Key of the lease file holding the identifier of the coordinator holding the lease.
+ */
+static NSString *const kLeaseOwnerKey = @"owner";
+
+/*! @brief Key of the lease file holding the expiry of the lease, in seconds since 1970.
+ */
+static NSString *const kLeaseExpiryKey = @"expires";
+
+/*! @brief How often a coordinator waiting for the lease of another process checks the state file.
+ */
+static NSTimeInterval const kLeasePollInterval = 0.25;
+
+@implementation OIDSharedAuthStateCoordinator {
+  /*! @brief Serial queue on which the lock file is locked, unlocked and the shared files accessed,
+          as locking blocks until the other processes have released the lock.
+   */
+  dispatch_queue_t _lockQueue;
+
+  /*! @brief Identifies the leases taken by this coordinator.
+   */
+  NSString *_leaseOwner;
+
+  /*! @brief The actions waiting for the coordinated refresh in progress. Guarded by
+          @synchronized(self).
+   */
+  NSMutableArray<OIDAuthStateAction> *_pendingActions;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithAuthState:directoryURL:identifier:))
+
+- (instancetype)initWithAuthState:(OIDAuthState *)authState
+                     directoryURL:(NSURL *)directoryURL
+                       identifier:(NSString *)identifier {
+  self = [super init];
+  if (self) {
+    _authState = authState;
+    _lockFileURL = [directoryURL
+        URLByAppendingPathComponent:[identifier stringByAppendingPathExtension:@"lock"]];
+    _stateFileURL = [directoryURL
+        URLByAppendingPathComponent:[identifier stringByAppendingPathExtension:@"authstate"]];
+    _leaseFileURL = [directoryURL
+        URLByAppendingPathComponent:[identifier stringByAppendingPathExtension:@"lease"]];
+    _refreshLeaseDuration = 30;
+    _leaseOwner = [NSUUID UUID].UUIDString;
+    _lockQueue = dispatch_queue_create("org.openid.appauth.sharedauthstate",
+                                       DISPATCH_QUEUE_SERIAL);
+    _pendingActions = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)performActionWithFreshTokens:(OIDAuthStateAction)action {
+  NSString *freshAccessToken = [_authState freshAccessToken];
+  if (freshAccessToken) {
+    NSString *freshIDToken = _authState.snapshot.idToken;
+    dispatch_async(dispatch_get_main_queue(), ^{
+      action(freshAccessToken, freshIDToken, nil);
+    });
+    return;
+  }
+
+  @synchronized(self) {
+    [_pendingActions addObject:action];
+    if (_pendingActions.count > 1) {
+      // a coordinated refresh is already in progress
+      return;
+    }
+  }
+
+  [self coordinateRefresh];
+}
+
+/*! @brief Adopts the tokens of the state file if newer, then refreshes if they are not fresh
+        either and no other process holds the lease, or checks back later if one does. Completes
+        the pending actions once the tokens are fresh or the refresh failed.
+ */
+- (void)coordinateRefresh {
+  dispatch_async(_lockQueue, ^{
+    OIDAuthStateSnapshot *sharedSnapshot;
+    BOOL leased = [self takeRefreshLeaseReadingSnapshot:&sharedSnapshot];
+    dispatch_async(dispatch_get_main_queue(), ^{
+      [self adoptSharedSnapshotIfNewer:sharedSnapshot];
+      if (!leased && ![self.authState freshAccessToken]) {
+        // another process is refreshing, so waits for its tokens or for its lease to expire
+        dispatch_time_t pollTime =
+            dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kLeasePollInterval * NSEC_PER_SEC));
+        dispatch_after(pollTime, dispatch_get_main_queue(), ^{
+          [self coordinateRefresh];
+        });
+        return;
+      }
+      // Refreshes only if the tokens of the state file were not fresh either.
+      [self.authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                                     NSString *_Nullable idToken,
+                                                     NSError *_Nullable error) {
+        if (leased) {
+          BOOL refreshed = accessToken && ![accessToken isEqual:sharedSnapshot.accessToken];
+          dispatch_async(self->_lockQueue, ^{
+            [self releaseRefreshLeaseStoringState:refreshed ifSharedSnapshotIs:sharedSnapshot];
+          });
+        }
+
+        NSArray<OIDAuthStateAction> *actions;
+        @synchronized(self) {
+          actions = [self->_pendingActions copy];
+          [self->_pendingActions removeAllObjects];
+        }
+        for (OIDAuthStateAction pendingAction in actions) {
+          pendingAction(accessToken, idToken, error);
+        }
+      }];
+    });
+  });
+}
+
+#pragma mark - Shared state
+
+/*! @brief Opens the lock file and takes an exclusive lock on it, waiting for other processes to
+        release it. The lock is only held while the shared files are read or written.
+    @return The file descriptor of the lock file, or -1 if it could not be locked.
+ */
+- (int)lockSharedState {
+  int fd = open(_lockFileURL.fileSystemRepresentation, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    return -1;
+  }
+  while (flock(fd, LOCK_EX) != 0) {
+    if (errno != EINTR) {
+      close(fd);
+      return -1;
+    }
+  }
+  return fd;
+}
+
+/*! @brief Releases the lock taken by @c lockSharedState and closes the lock file.
+    @param fd The file descriptor returned by @c lockSharedState.
+ */
+- (void)unlockSharedState:(int)fd {
+  if (fd < 0) {
+    return;
+  }
+  flock(fd, LOCK_UN);
+  close(fd);
+}
+
+/*! @brief Reads the state file, and takes the refresh lease unless another process holds an
+        unexpired one. Must be called on @c _lockQueue.
+    @param sharedSnapshot Set to the snapshot of the state file, if any.
+    @return YES if the lease was taken, or if the lock file could not be opened, in which case the
+        refresh is not coordinated.
+ */
+- (BOOL)takeRefreshLeaseReadingSnapshot:
+    (OIDAuthStateSnapshot *_Nullable __autoreleasing *_Nonnull)sharedSnapshot {
+  int fd = [self lockSharedState];
+  *sharedSnapshot = [self readSharedSnapshot];
+  if (fd < 0) {
+    return YES;
+  }
+  NSTimeInterval now = [NSDate date].timeIntervalSince1970;
+  NSDictionary *lease = [NSDictionary dictionaryWithContentsOfURL:_leaseFileURL];
+  NSString *owner = lease[kLeaseOwnerKey];
+  NSNumber *expiry = lease[kLeaseExpiryKey];
+  BOOL heldByOther = [owner isKindOfClass:[NSString class]] && ![owner isEqual:_leaseOwner] &&
+      [expiry isKindOfClass:[NSNumber class]] && expiry.doubleValue > now;
+  if (!heldByOther) {
+    NSDictionary *newLease = @{
+      kLeaseOwnerKey : _leaseOwner,
+      kLeaseExpiryKey : @(now + self.refreshLeaseDuration),
+    };
+    [newLease writeToURL:_leaseFileURL atomically:YES];
+  }
+  [self unlockSharedState:fd];
+  return !heldByOther;
+}
+
+/*! @brief Releases the refresh lease taken by this coordinator, first writing this process's
+        authorization state to the state file if it refreshed the tokens and no other process
+        wrote the state file since the lease was taken. Must be called on @c _lockQueue.
+    @param refreshed Whether this process refreshed the tokens.
+    @param leasedSnapshot The snapshot of the state file when the lease was taken.
+ */
+- (void)releaseRefreshLeaseStoringState:(BOOL)refreshed
+                     ifSharedSnapshotIs:(nullable OIDAuthStateSnapshot *)leasedSnapshot {
+  int fd = [self lockSharedState];
+  if (fd < 0) {
+    if (refreshed) {
+      [self writeSharedState];
+    }
+    return;
+  }
+  if (refreshed) {
+    NSString *sharedAccessToken = [self readSharedSnapshot].accessToken;
+    NSString *leasedAccessToken = leasedSnapshot.accessToken;
+    if (sharedAccessToken == leasedAccessToken ||
+        [sharedAccessToken isEqual:leasedAccessToken]) {
+      [self writeSharedState];
+    }
+  }
+  NSDictionary *lease = [NSDictionary dictionaryWithContentsOfURL:_leaseFileURL];
+  if ([lease[kLeaseOwnerKey] isEqual:_leaseOwner]) {
+    [[NSFileManager defaultManager] removeItemAtURL:_leaseFileURL error:NULL];
+  }
+  [self unlockSharedState:fd];
+}
+
+/*! @brief Returns the snapshot of the state file, or nil if there is none or it can't be decoded.
+ */
+- (nullable OIDAuthStateSnapshot *)readSharedSnapshot {
+  NSData *data = [NSData dataWithContentsOfURL:_stateFileURL];
+  return data ? [OIDAuthState authStateFromArchivedData:data error:NULL].snapshot : nil;
+}
+
+/*! @brief Adopts the snapshot of the state file if another process has refreshed the tokens since
+        this process last did.
+    @param sharedSnapshot The snapshot of the state file.
+ */
+- (void)adoptSharedSnapshotIfNewer:(nullable OIDAuthStateSnapshot *)sharedSnapshot {
+  OIDAuthStateSnapshot *snapshot = _authState.snapshot;
+  if (!sharedSnapshot.accessToken || [sharedSnapshot.accessToken isEqual:snapshot.accessToken]) {
+    return;
+  }
+  NSDate *expirationDate = snapshot.accessTokenExpirationDate;
+  NSDate *sharedExpirationDate = sharedSnapshot.accessTokenExpirationDate;
+  if (expirationDate && sharedExpirationDate &&
+      [sharedExpirationDate compare:expirationDate] != NSOrderedDescending) {
+    return;
+  }
+  [_authState updateWithSnapshot:sharedSnapshot];
+}
+
+/*! @brief Writes this process's authorization state to the state file. The file is replaced
+        atomically, so it is never read partially written, and as it holds the refresh token it is
+        encrypted while the device is locked, until its first unlock after a restart.
+ */
+- (void)writeSharedState {
+  NSData *data;
+  NSError *error;
+  if (@available(iOS 11.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    data = [NSKeyedArchiver archivedDataWithRootObject:_authState
+                                 requiringSecureCoding:YES
+                                                 error:&error];
+  } else {
+#if !TARGET_OS_IOS
+    data = [NSKeyedArchiver archivedDataWithRootObject:_authState];
+#endif
+  }
+  if (!data) {
+    NSLog(@"OIDSharedAuthStateCoordinator: archiving the authorization state failed: %@", error);
+    return;
+  }
+  NSDataWritingOptions options = NSDataWritingAtomic;
+#if !TARGET_OS_OSX
+  options |= NSDataWritingFileProtectionCompleteUntilFirstUserAuthentication;
+#endif
+  if (![data writeToURL:_stateFileURL options:options error:&error]) {
+    NSLog(@"OIDSharedAuthStateCoordinator: writing the state file failed: %@", error);
+  }
+}
+
+@end
@@ -0,0 +1,122 @@
+/*! @file OIDSharedTokenCache.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "OIDAuthStateChangeDelegate.h"
+
+@class OIDAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The access token held by an @c OIDSharedTokenCache when it was read.
+ */
+@interface OIDSharedTokenCacheEntry : NSObject
+
+/*! @brief The access token.
+ */
+@property(nonatomic, readonly) NSString *accessToken;
+
+/*! @brief The type of the access token, if known.
+ */
+@property(nonatomic, readonly, nullable) NSString *tokenType;
+
+/*! @brief When the access token expires, if known.
+ */
+@property(nonatomic, readonly, nullable) NSDate *accessTokenExpirationDate;
+
+/*! @brief The number of times the cache had been written when the entry was read.
+ */
+@property(nonatomic, readonly) uint64_t generation;
+
+/*! @brief Whether the access token can be used without refreshing it first, by the same rule as
+        @c OIDAuthState, using @c OIDClock.sharedClock.
+ */
+@property(nonatomic, readonly) BOOL isFresh;
+
+/*! @internal
+    @brief Unavailable. Entries are created by @c OIDSharedTokenCache.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+/*! @brief A small memory-mapped file holding the current access token of an authorization, which
+        other processes can read without decoding the archived @c OIDAuthState, touching the
+        keychain, or taking a lock.
+    @discussion The file has a fixed layout: an access token, its type, its expiration date and a
+        generation counter. The owning process opens the cache for writing and writes it whenever
+        its @c OIDAuthState changes, either from its own
+        @c OIDAuthStateChangeDelegate.didChangeState: or by making the cache the state change
+        delegate. Other processes, such as extensions and helpers, open it for reading.
+
+        Reads are lock-free: the generation counter doubles as a sequence lock, so a reader copies
+        the fields and retries if a write happened meanwhile. A read costs well under a microsecond
+        and never waits for the writer. Writers take an exclusive @c flock on the file for the
+        duration of a write. A file left mid-write by a writer which terminated is repaired when
+        the cache is next opened for writing, and reads as empty until the next write.
+ */
+@interface OIDSharedTokenCache : NSObject <OIDAuthStateChangeDelegate>
+
+/*! @brief The memory-mapped file.
+ */
+@property(nonatomic, readonly) NSURL *fileURL;
+
+/*! @brief Whether the cache was opened for writing.
+ */
+@property(nonatomic, readonly, getter=isWritable) BOOL writable;
+
+/*! @brief The largest access token, in UTF-8 bytes, the cache can hold.
+ */
++ (NSUInteger)maximumAccessTokenLength;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithFileURL:writable:error:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer. Maps the cache file into memory.
+    @param fileURL The cache file, typically in an app group container.
+    @param writable Whether the cache is opened for writing, creating the file if needed. Only the
+        process owning the authorization should open it for writing.
+    @param error The error, in @c NSPOSIXErrorDomain, if the file could not be mapped.
+ */
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL
+                                writable:(BOOL)writable
+                                   error:(NSError **_Nullable)error NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Reads the current access token, or returns nil if there is none.
+    @discussion Lock-free and safe to call from any thread.
+ */
+- (nullable OIDSharedTokenCacheEntry *)currentEntry;
+
+/*! @brief Returns the current access token if it is fresh, or nil.
+ */
+- (nullable NSString *)freshAccessToken;
+
+/*! @brief Writes the current access token of an authorization state.
+    @param authState The authorization state.
+    @return NO if the cache was not opened for writing, or the access token was too long, in which
+        case the cache is cleared so that readers don't use an outdated token.
+    @discussion If the access token of @c authState needs refreshing, the cache is cleared.
+ */
+- (BOOL)writeAuthState:(OIDAuthState *)authState;
+
+@end
+
+NS_ASSUME_NONNULL_END
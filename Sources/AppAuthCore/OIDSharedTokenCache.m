@@ -0,0 +1,359 @@
+/*! @file OIDSharedTokenCache.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDSharedTokenCache.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <stdatomic.h>
+#import <stddef.h>
+#import <sys/file.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <unistd.h>
+
+#import "OIDAuthState.h"
+#import "OIDAuthStateSnapshot.h"
+#import "OIDClock.h"
+#import "OIDDefines.h"
+#import "OIDTokenUtilities.h"
+
+/*! @brief Identifies a token cache file.
+ */
+static const uint32_t kSharedTokenCacheMagic = 0x4f494454;  // "OIDT"
+
+/*! @brief The version of the layout of token cache files.
+ */
+static const uint32_t kSharedTokenCacheVersion = 1;
+
+/*! @brief The size of token cache files.
+ */
+#define OID_SHARED_TOKEN_CACHE_SIZE 16384
+
+/*! @brief The capacity of the token type field, in bytes.
+ */
+#define OID_SHARED_TOKEN_CACHE_TOKEN_TYPE_CAPACITY 64
+
+/*! @brief The number of times a reader retries while the writer keeps updating the cache, before
+        giving up, e.g. because the writer terminated mid-write.
+ */
+static const NSUInteger kSharedTokenCacheMaximumReadAttempts = 1000;
+
+/*! @brief The layout of token cache files.
+    @discussion @c sequence is odd while a write is in progress, and incremented by two for every
+        write, so it is both the sequence lock and twice the generation.
+ */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  _Atomic uint64_t sequence;
+  double expirationTime;  // seconds since 1970, or 0 if unknown
+  uint32_t accessTokenLength;
+  uint32_t tokenTypeLength;
+  char tokenType[OID_SHARED_TOKEN_CACHE_TOKEN_TYPE_CAPACITY];
+  char accessToken[];
+} OIDSharedTokenCacheLayout;
+
+/*! @brief The capacity of the access token field, in bytes.
+ */
+#define OID_SHARED_TOKEN_CACHE_ACCESS_TOKEN_CAPACITY \
+  (OID_SHARED_TOKEN_CACHE_SIZE - offsetof(OIDSharedTokenCacheLayout, accessToken))
+
+@interface OIDSharedTokenCacheEntry ()
+
+- (instancetype)initWithAccessToken:(NSString *)accessToken
+                          tokenType:(nullable NSString *)tokenType
+          accessTokenExpirationDate:(nullable NSDate *)accessTokenExpirationDate
+                         generation:(uint64_t)generation NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation OIDSharedTokenCacheEntry
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(
+        @selector(initWithAccessToken:tokenType:accessTokenExpirationDate:generation:))
+
+- (instancetype)initWithAccessToken:(NSString *)accessToken
+                          tokenType:(nullable NSString *)tokenType
+          accessTokenExpirationDate:(nullable NSDate *)accessTokenExpirationDate
+                         generation:(uint64_t)generation {
+  self = [super init];
+  if (self) {
+    _accessToken = [accessToken copy];
+    _tokenType = [tokenType copy];
+    _accessTokenExpirationDate = accessTokenExpirationDate;
+    _generation = generation;
+  }
+  return self;
+}
+
+- (BOOL)isFresh {
+  if (!_accessTokenExpirationDate) {
+    // if there is no expiration time, the token is assumed to never expire
+    return YES;
+  }
+  OIDClock *clock = [OIDClock sharedClock];
+  NSTimeInterval expiresIn = [_accessTokenExpirationDate timeIntervalSinceDate:[clock now]];
+  return expiresIn > clock.accessTokenRefreshTolerance;
+}
+
+- (NSString *)description {
+  return [NSString stringWithFormat:@"<%@: %p, accessToken: \"%@\", expires: %@, generation: %llu>",
+                                    NSStringFromClass([self class]),
+                                    (void *)self,
+                                    [OIDTokenUtilities redact:_accessToken],
+                                    _accessTokenExpirationDate,
+                                    _generation];
+}
+
+@end
+
+@implementation OIDSharedTokenCache {
+  /*! @brief The mapped file.
+   */
+  OIDSharedTokenCacheLayout *_layout;
+
+  /*! @brief The file descriptor of the cache file if writable, on which writers take an exclusive
+          @c flock, or -1.
+   */
+  int _fd;
+}
+
++ (NSUInteger)maximumAccessTokenLength {
+  return OID_SHARED_TOKEN_CACHE_ACCESS_TOKEN_CAPACITY;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithFileURL:writable:error:))
+
+- (nullable instancetype)initWithFileURL:(NSURL *)fileURL
+                                writable:(BOOL)writable
+                                   error:(NSError **_Nullable)error {
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+  _fileURL = fileURL;
+  _writable = writable;
+  _fd = -1;
+
+  int flags = writable ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC);
+  int fd = open(fileURL.fileSystemRepresentation, flags, 0600);
+  if (fd < 0) {
+    return [self failWithErrno:errno error:error];
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    int fstatErrno = errno;
+    close(fd);
+    return [self failWithErrno:fstatErrno error:error];
+  }
+  BOOL created = status.st_size == 0;
+  if (writable && created && ftruncate(fd, OID_SHARED_TOKEN_CACHE_SIZE) != 0) {
+    int ftruncateErrno = errno;
+    close(fd);
+    return [self failWithErrno:ftruncateErrno error:error];
+  }
+  if (!created && status.st_size < (off_t)OID_SHARED_TOKEN_CACHE_SIZE) {
+    close(fd);
+    return [self failWithErrno:EINVAL error:error];
+  }
+  if (!writable && created) {
+    // the owning process has not initialized the file yet
+    close(fd);
+    return [self failWithErrno:ENODATA error:error];
+  }
+
+  int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+  void *mapping = mmap(NULL, OID_SHARED_TOKEN_CACHE_SIZE, protection, MAP_SHARED, fd, 0);
+  int mmapErrno = errno;
+  if (writable && mapping != MAP_FAILED) {
+    _fd = fd;
+  } else {
+    // the mapping stays valid once the file is closed
+    close(fd);
+  }
+  if (mapping == MAP_FAILED) {
+    return [self failWithErrno:mmapErrno error:error];
+  }
+  _layout = mapping;
+
+  if (writable) {
+    [self lockForWriting];
+    if (created || _layout->magic != kSharedTokenCacheMagic ||
+        _layout->version != kSharedTokenCacheVersion) {
+      _layout->magic = kSharedTokenCacheMagic;
+      _layout->version = kSharedTokenCacheVersion;
+    }
+    uint64_t sequence = atomic_load_explicit(&_layout->sequence, memory_order_relaxed);
+    if (sequence & 1) {
+      // A writer terminated mid-write. Clears the half-written fields, then makes the sequence
+      // even again, or every later write would leave it odd and readers would give up.
+      _layout->expirationTime = 0;
+      _layout->accessTokenLength = 0;
+      _layout->tokenTypeLength = 0;
+      atomic_store_explicit(&_layout->sequence, sequence + 1, memory_order_release);
+    }
+    [self unlockForWriting];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  if (_layout) {
+    munmap(_layout, OID_SHARED_TOKEN_CACHE_SIZE);
+  }
+  if (_fd >= 0) {
+    close(_fd);
+  }
+}
+
+/*! @brief Takes the exclusive lock serializing the writers of the cache file, in this and other
+        processes. Readers never take it.
+ */
+- (void)lockForWriting {
+  while (flock(_fd, LOCK_EX) != 0 && errno == EINTR) {
+  }
+}
+
+/*! @brief Releases the lock taken by @c lockForWriting.
+ */
+- (void)unlockForWriting {
+  flock(_fd, LOCK_UN);
+}
+
+/*! @brief Sets the error for a failed system call and returns nil.
+    @param code The @c errno of the failed call.
+    @param error The error to set.
+ */
+- (nullable instancetype)failWithErrno:(int)code error:(NSError **_Nullable)error {
+  if (error) {
+    *error = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                 code:code
+                             userInfo:@{ NSFilePathErrorKey : _fileURL.path ?: @"" }];
+  }
+  return nil;
+}
+
+#pragma mark - Reading
+
+- (nullable OIDSharedTokenCacheEntry *)currentEntry {
+  OIDSharedTokenCacheLayout *layout = _layout;
+  if (layout->magic != kSharedTokenCacheMagic || layout->version != kSharedTokenCacheVersion) {
+    return nil;
+  }
+
+  char accessToken[OID_SHARED_TOKEN_CACHE_ACCESS_TOKEN_CAPACITY];
+  char tokenType[OID_SHARED_TOKEN_CACHE_TOKEN_TYPE_CAPACITY];
+  for (NSUInteger attempt = 0; attempt < kSharedTokenCacheMaximumReadAttempts; attempt++) {
+    uint64_t sequence = atomic_load_explicit(&layout->sequence, memory_order_acquire);
+    if (sequence & 1) {
+      // a write is in progress
+      continue;
+    }
+    // The fields may be overwritten while they are copied, so the lengths are bounded before use
+    // and the copy is only used if the sequence did not change meanwhile.
+    double expirationTime = layout->expirationTime;
+    size_t accessTokenLength = MIN(layout->accessTokenLength, sizeof(accessToken));
+    size_t tokenTypeLength = MIN(layout->tokenTypeLength, sizeof(tokenType));
+    memcpy(accessToken, layout->accessToken, accessTokenLength);
+    memcpy(tokenType, layout->tokenType, tokenTypeLength);
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&layout->sequence, memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    if (!accessTokenLength) {
+      return nil;
+    }
+    NSString *accessTokenString = [[NSString alloc] initWithBytes:accessToken
+                                                           length:accessTokenLength
+                                                         encoding:NSUTF8StringEncoding];
+    NSString *tokenTypeString = tokenTypeLength
+        ? [[NSString alloc] initWithBytes:tokenType
+                                   length:tokenTypeLength
+                                 encoding:NSUTF8StringEncoding]
+        : nil;
+    NSDate *expirationDate =
+        expirationTime ? [NSDate dateWithTimeIntervalSince1970:expirationTime] : nil;
+    if (!accessTokenString) {
+      return nil;
+    }
+    return [[OIDSharedTokenCacheEntry alloc] initWithAccessToken:accessTokenString
+                                                       tokenType:tokenTypeString
+                                       accessTokenExpirationDate:expirationDate
+                                                      generation:sequence / 2];
+  }
+  return nil;
+}
+
+- (nullable NSString *)freshAccessToken {
+  OIDSharedTokenCacheEntry *entry = [self currentEntry];
+  return entry.isFresh ? entry.accessToken : nil;
+}
+
+#pragma mark - Writing
+
+- (BOOL)writeAuthState:(OIDAuthState *)authState {
+  if (!_writable) {
+    return NO;
+  }
+  OIDAuthStateSnapshot *snapshot = authState.snapshot;
+  NSData *accessToken = snapshot.needsTokenRefresh
+      ? nil
+      : [snapshot.accessToken dataUsingEncoding:NSUTF8StringEncoding];
+  NSData *tokenType = [snapshot.tokenType dataUsingEncoding:NSUTF8StringEncoding];
+  BOOL fits = accessToken.length <= OID_SHARED_TOKEN_CACHE_ACCESS_TOKEN_CAPACITY &&
+      tokenType.length <= OID_SHARED_TOKEN_CACHE_TOKEN_TYPE_CAPACITY;
+  if (!fits) {
+    accessToken = nil;
+  }
+  NSTimeInterval expirationTime = accessToken
+      ? snapshot.accessTokenExpirationDate.timeIntervalSince1970
+      : 0;
+
+  // Writers are serialized within the process, and across processes by the file lock.
+  @synchronized(self) {
+    [self lockForWriting];
+    OIDSharedTokenCacheLayout *layout = _layout;
+    uint64_t sequence = atomic_load_explicit(&layout->sequence, memory_order_relaxed);
+    atomic_store_explicit(&layout->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    layout->expirationTime = expirationTime;
+    layout->accessTokenLength = (uint32_t)accessToken.length;
+    [accessToken getBytes:layout->accessToken length:accessToken.length];
+    layout->tokenTypeLength = accessToken ? (uint32_t)tokenType.length : 0;
+    if (accessToken) {
+      [tokenType getBytes:layout->tokenType length:tokenType.length];
+    }
+
+    atomic_store_explicit(&layout->sequence, sequence + 2, memory_order_release);
+    [self unlockForWriting];
+  }
+  return fits;
+}
+
+#pragma mark - OIDAuthStateChangeDelegate
+
+- (void)didChangeState:(OIDAuthState *)state {
+  [self writeAuthState:state];
+}
+
+@end
@@ -0,0 +1,147 @@
+/*! @file OIDTokenBroker.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The requests of the token broker protocol, each a single byte.
+ */
+typedef NS_ENUM(uint8_t, OIDTokenBrokerRequest) {
+  /*! @brief Requests a fresh access token.
+   */
+  OIDTokenBrokerRequestFreshAccessToken = 1,
+};
+
+/*! @brief The status byte which starts each response of the token broker protocol.
+ */
+typedef NS_ENUM(uint8_t, OIDTokenBrokerStatus) {
+  /*! @brief The payload is the expiration time of the access token, in seconds since 1970 as a
+          big-endian 64-bit integer or 0 if unknown, followed by the access token in UTF-8.
+   */
+  OIDTokenBrokerStatusSuccess = 0,
+
+  /*! @brief The access token could not be refreshed. The payload is a description of the error in
+          UTF-8.
+   */
+  OIDTokenBrokerStatusError = 1,
+};
+
+/*! @brief Serves fresh access tokens of an @c OIDAuthState to other processes over a Unix domain
+        socket, so that many processes on a host share one authorization, one refresh at a time
+        and one connection to the token endpoint.
+    @discussion The protocol is deliberately tiny. A client sends @c OIDTokenBrokerRequest bytes
+        over a stream connection, and for each receives a response made of an
+        @c OIDTokenBrokerStatus byte, the length of the payload as a big-endian 32-bit integer, and
+        the payload. Connections are long-lived, and responses are sent in the order of the
+        requests.
+
+        While the access token is fresh, requests are answered on the connection's queue without
+        involving the main queue. Otherwise the token is refreshed with
+        @c OIDAuthState.performActionWithFreshTokens:additionalRefreshParameters:dispatchQueue:,
+        which performs a single refresh for all the requests waiting for it.
+
+        The socket is only accessible to the user running the broker from the moment it is
+        bound, and connections from processes of other users are closed without a response.
+ */
+@interface OIDTokenBroker : NSObject
+
+/*! @brief The authorization state whose tokens are served.
+ */
+@property(nonatomic, readonly) OIDAuthState *authState;
+
+/*! @brief The path of the Unix domain socket.
+ */
+@property(nonatomic, readonly) NSString *socketPath;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithAuthState:socketPath:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param authState The authorization state whose tokens are served.
+    @param socketPath The path of the Unix domain socket. A stale socket at that path is replaced,
+        but neither a socket on which another broker accepts connections nor any other kind of
+        file.
+ */
+- (instancetype)initWithAuthState:(OIDAuthState *)authState
+                       socketPath:(NSString *)socketPath NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Starts accepting connections.
+    @param error The error, in @c NSPOSIXErrorDomain, if the socket could not be created, such as
+        @c EEXIST if a file other than a socket is at @c socketPath, or @c EADDRINUSE if a broker,
+        in this process or another one, already accepts connections at @c socketPath.
+    @return YES if the broker was started.
+ */
+- (BOOL)startWithError:(NSError **_Nullable)error;
+
+/*! @brief Closes the socket and all connections. Called when the broker is deallocated.
+ */
+- (void)stop;
+
+@end
+
+/*! @brief Fetches fresh access tokens from an @c OIDTokenBroker, for use by processes which share
+        the broker's authorization instead of keeping their own.
+    @discussion The connection is opened on first use and kept open, and is reopened once if the
+        broker closed it. Requests are synchronous and serialized; use one client per thread for
+        concurrent requests.
+ */
+@interface OIDTokenBrokerClient : NSObject
+
+/*! @brief The path of the broker's Unix domain socket.
+ */
+@property(nonatomic, readonly) NSString *socketPath;
+
+/*! @brief How long to wait for the broker to respond, in seconds. Defaults to 60, which allows for
+        a token refresh.
+ */
+@property(nonatomic, assign) NSTimeInterval timeout;
+
+/*! @internal
+    @brief Unavailable. Please use @c initWithSocketPath:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Designated initializer.
+    @param socketPath The path of the broker's Unix domain socket.
+ */
+- (instancetype)initWithSocketPath:(NSString *)socketPath NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Fetches a fresh access token from the broker, waiting for it to refresh the token if
+        needed.
+    @param expirationDate Set to the expiration date of the access token, if known.
+    @param error The error if no token was fetched: in @c NSPOSIXErrorDomain if the broker could
+        not be reached, or with the code @c ::OIDErrorCodeTokenRefreshError if the broker could not
+        refresh the token.
+    @return The access token, or nil if an error occurred.
+ */
+- (nullable NSString *)fetchFreshAccessTokenWithExpirationDate:
+                           (NSDate *_Nullable *_Nullable)expirationDate
+                                                          error:(NSError **_Nullable)error;
+
+/*! @brief Closes the connection to the broker. Called when the client is deallocated.
+ */
+- (void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
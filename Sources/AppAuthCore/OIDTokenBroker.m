@@ -0,0 +1,717 @@
+/*! @file OIDTokenBroker.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDTokenBroker.h"
+
+#import <errno.h>
+#import <fcntl.h>
+#import <sys/socket.h>
+#import <sys/stat.h>
+#import <sys/un.h>
+#import <unistd.h>
+
+#import "OIDAuthState.h"
+#import "OIDAuthStateSnapshot.h"
+#import "OIDDefines.h"
+#import "OIDError.h"
+#import "OIDErrorUtilities.h"
+
+/*! @brief The flags passed to @c send, avoiding @c SIGPIPE where the platform supports it per call.
+ */
+#ifdef MSG_NOSIGNAL
+static const int kTokenBrokerSendFlags = MSG_NOSIGNAL;
+#else
+static const int kTokenBrokerSendFlags = 0;
+#endif
+
+/*! @brief The size of the header of a response: the status byte and the payload length.
+ */
+static const size_t kTokenBrokerResponseHeaderSize = 5;
+
+/*! @brief The largest response payload a client accepts.
+ */
+static const uint32_t kTokenBrokerMaximumPayloadLength = 65536;
+
+/*! @brief Returns an error in @c NSPOSIXErrorDomain.
+    @param code The @c errno value.
+ */
+static NSError *OIDTokenBrokerPOSIXError(int code) {
+  return [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:nil];
+}
+
+/*! @brief Configures a socket to be closed on exec and not to raise @c SIGPIPE.
+ */
+static void OIDTokenBrokerConfigureSocket(int fd) {
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+  int noSIGPIPE = 1;
+  setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSIGPIPE, sizeof(noSIGPIPE));
+#endif
+}
+
+/*! @brief Fills in the address of a Unix domain socket.
+    @return NO if the path is too long.
+ */
+static BOOL OIDTokenBrokerSocketAddress(NSString *socketPath, struct sockaddr_un *address) {
+  memset(address, 0, sizeof(*address));
+  address->sun_family = AF_UNIX;
+  const char *path = socketPath.fileSystemRepresentation;
+  if (strlen(path) >= sizeof(address->sun_path)) {
+    return NO;
+  }
+  strncpy(address->sun_path, path, sizeof(address->sun_path) - 1);
+  return YES;
+}
+
+/*! @brief Returns whether a broker accepts connections on the socket at a path, as opposed to the
+        socket being stale, left behind by a broker which exited without removing it.
+ */
+static BOOL OIDTokenBrokerSocketIsLive(NSString *socketPath) {
+  struct sockaddr_un address;
+  if (!OIDTokenBrokerSocketAddress(socketPath, &address)) {
+    return NO;
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return NO;
+  }
+  OIDTokenBrokerConfigureSocket(fd);
+  // a stale socket refuses connections
+  BOOL live = connect(fd, (struct sockaddr *)&address, sizeof(address)) == 0;
+  close(fd);
+  return live;
+}
+
+/*! @brief Removes the socket at a path if it is still the one a broker bound, and not one bound
+        since by another broker.
+ */
+static void OIDTokenBrokerRemoveSocket(NSString *socketPath, dev_t boundDevice, ino_t boundInode) {
+  struct stat status;
+  const char *path = socketPath.fileSystemRepresentation;
+  if (lstat(path, &status) == 0 && status.st_dev == boundDevice && status.st_ino == boundInode) {
+    unlink(path);
+  }
+}
+
+/*! @brief Binds a socket to a path, and makes it listen, without it ever being reachable with the
+        permissions given by the umask: the socket is bound in a new directory only accessible to
+        the user, restricted to the user, then moved into place.
+    @param fd The socket.
+    @param socketPath The path to bind the socket to, at which there must be no file other than a
+        stale socket.
+    @param boundStatus Set to the status of the bound socket.
+    @return 0, or the @c errno of the failure: @c EEXIST if a file other than a socket is at the
+        path, @c EADDRINUSE if a broker accepts connections on the socket at the path.
+ */
+static int OIDTokenBrokerBindPrivately(int fd, NSString *socketPath, struct stat *boundStatus) {
+  const char *path = socketPath.fileSystemRepresentation;
+  struct stat existingStatus;
+  if (lstat(path, &existingStatus) == 0) {
+    if (!S_ISSOCK(existingStatus.st_mode)) {
+      return EEXIST;
+    }
+    if (OIDTokenBrokerSocketIsLive(socketPath)) {
+      return EADDRINUSE;
+    }
+  }
+
+  NSString *directory = [socketPath stringByDeletingLastPathComponent];
+  NSString *privateDirectoryTemplate =
+      [(directory.length ? directory : @".") stringByAppendingPathComponent:@".oidtbXXXXXX"];
+  char *privateDirectory = strdup(privateDirectoryTemplate.fileSystemRepresentation);
+  if (!privateDirectory) {
+    return ENOMEM;
+  }
+  // created with mode 0700
+  if (!mkdtemp(privateDirectory)) {
+    int code = errno;
+    free(privateDirectory);
+    return code;
+  }
+  NSString *privatePath =
+      [[NSString stringWithUTF8String:privateDirectory] stringByAppendingPathComponent:@"s"];
+  struct sockaddr_un privateAddress;
+  int code = 0;
+  if (!OIDTokenBrokerSocketAddress(privatePath, &privateAddress)) {
+    code = ENAMETOOLONG;
+  } else if (bind(fd, (struct sockaddr *)&privateAddress, sizeof(privateAddress)) != 0 ||
+             chmod(privateAddress.sun_path, S_IRUSR | S_IWUSR) != 0 ||
+             listen(fd, SOMAXCONN) != 0 ||
+             // replaces a stale socket atomically
+             rename(privateAddress.sun_path, path) != 0 ||
+             lstat(path, boundStatus) != 0) {
+    code = errno;
+    unlink(privateAddress.sun_path);
+  }
+  rmdir(privateDirectory);
+  free(privateDirectory);
+  return code;
+}
+
+/*! @brief Sends all bytes, returning NO if the connection failed.
+ */
+static BOOL OIDTokenBrokerSendAll(int fd, const void *bytes, size_t length) {
+  const uint8_t *cursor = bytes;
+  while (length > 0) {
+    ssize_t sent = send(fd, cursor, length, kTokenBrokerSendFlags);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return NO;
+    }
+    cursor += sent;
+    length -= (size_t)sent;
+  }
+  return YES;
+}
+
+/*! @brief Receives exactly @c length bytes, returning NO with @c errno set if the connection
+        failed or was closed (in which case @c errno is @c ECONNRESET).
+ */
+static BOOL OIDTokenBrokerReceiveAll(int fd, void *bytes, size_t length) {
+  uint8_t *cursor = bytes;
+  while (length > 0) {
+    ssize_t received = recv(fd, cursor, length, 0);
+    if (received == 0) {
+      errno = ECONNRESET;
+      return NO;
+    }
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return NO;
+    }
+    cursor += received;
+    length -= (size_t)received;
+  }
+  return YES;
+}
+
+/*! @brief Sends a response.
+    @param fd The connection.
+    @param status The status of the response.
+    @param prefix Bytes starting the payload, if any.
+    @param payload The rest of the payload.
+ */
+static BOOL OIDTokenBrokerSendResponse(int fd,
+                                       OIDTokenBrokerStatus status,
+                                       NSData *_Nullable prefix,
+                                       NSData *payload) {
+  NSMutableData *response =
+      [NSMutableData dataWithCapacity:kTokenBrokerResponseHeaderSize + prefix.length +
+                                      payload.length];
+  uint8_t statusByte = status;
+  uint32_t length = CFSwapInt32HostToBig((uint32_t)(prefix.length + payload.length));
+  [response appendBytes:&statusByte length:sizeof(statusByte)];
+  [response appendBytes:&length length:sizeof(length)];
+  if (prefix) {
+    [response appendData:prefix];
+  }
+  [response appendData:payload];
+  return OIDTokenBrokerSendAll(fd, response.bytes, response.length);
+}
+
+@class OIDTokenBrokerConnection;
+
+@interface OIDTokenBroker ()
+
+/*! @brief Forgets a connection once it is closed.
+ */
+- (void)connectionDidClose:(OIDTokenBrokerConnection *)connection;
+
+@end
+
+/*! @brief A connection accepted by an @c OIDTokenBroker.
+ */
+@interface OIDTokenBrokerConnection : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithFileDescriptor:(int)fd
+                                broker:(OIDTokenBroker *)broker NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Starts reading requests.
+ */
+- (void)start;
+
+/*! @brief Closes the connection.
+ */
+- (void)close;
+
+@end
+
+@implementation OIDTokenBrokerConnection {
+  /*! @brief The socket of the connection.
+   */
+  int _fd;
+
+  /*! @brief The broker, which retains the connection until it is closed.
+   */
+  __weak OIDTokenBroker *_broker;
+
+  /*! @brief The authorization state whose tokens are served.
+   */
+  OIDAuthState *_authState;
+
+  /*! @brief The serial queue on which requests are read and served.
+   */
+  dispatch_queue_t _queue;
+
+  /*! @brief Fires when requests can be read. Suspended while waiting for a refresh, so that
+          responses are sent in the order of the requests.
+   */
+  dispatch_source_t _readSource;
+
+  /*! @brief The number of requests read but not yet served. Accessed on @c _queue.
+   */
+  NSUInteger _queuedRequests;
+
+  /*! @brief Whether the connection is waiting for a refresh. Accessed on @c _queue.
+   */
+  BOOL _waitingForRefresh;
+
+  /*! @brief Whether the connection was closed. Accessed on @c _queue.
+   */
+  BOOL _closed;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithFileDescriptor:broker:))
+
+- (instancetype)initWithFileDescriptor:(int)fd broker:(OIDTokenBroker *)broker {
+  self = [super init];
+  if (self) {
+    _fd = fd;
+    _broker = broker;
+    _authState = broker.authState;
+    _queue = dispatch_queue_create("org.openid.appauth.tokenbroker.connection",
+                                   DISPATCH_QUEUE_SERIAL);
+    _readSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)fd, 0, _queue);
+  }
+  return self;
+}
+
+- (void)start {
+  __weak OIDTokenBrokerConnection *weakSelf = self;
+  dispatch_source_set_event_handler(_readSource, ^{
+    [weakSelf readRequests];
+  });
+  int fd = _fd;
+  dispatch_source_set_cancel_handler(_readSource, ^{
+    close(fd);
+  });
+  dispatch_resume(_readSource);
+}
+
+- (void)close {
+  dispatch_async(_queue, ^{
+    [self closeOnQueue];
+  });
+}
+
+- (void)closeOnQueue {
+  if (_closed) {
+    return;
+  }
+  _closed = YES;
+  dispatch_source_cancel(_readSource);
+  if (_waitingForRefresh) {
+    // the cancel handler only runs once the source is resumed
+    dispatch_resume(_readSource);
+  }
+  [_broker connectionDidClose:self];
+}
+
+- (void)readRequests {
+  uint8_t requests[256];
+  ssize_t count = recv(_fd, requests, sizeof(requests), 0);
+  if (count < 0 && (errno == EINTR || errno == EAGAIN)) {
+    return;
+  }
+  if (count <= 0) {
+    [self closeOnQueue];
+    return;
+  }
+  for (ssize_t i = 0; i < count; i++) {
+    if (requests[i] != OIDTokenBrokerRequestFreshAccessToken) {
+      // not a client of this protocol
+      [self closeOnQueue];
+      return;
+    }
+  }
+  _queuedRequests += (NSUInteger)count;
+  [self serveQueuedRequests];
+}
+
+- (void)serveQueuedRequests {
+  while (_queuedRequests > 0 && !_waitingForRefresh && !_closed) {
+    OIDAuthStateSnapshot *snapshot = _authState.snapshot;
+    NSString *accessToken = [_authState freshAccessToken];
+    if (accessToken) {
+      _queuedRequests--;
+      NSDate *expirationDate = [accessToken isEqualToString:snapshot.accessToken]
+          ? snapshot.accessTokenExpirationDate
+          : _authState.snapshot.accessTokenExpirationDate;
+      [self sendAccessToken:accessToken expirationDate:expirationDate error:nil];
+      continue;
+    }
+
+    // Stops reading while the token is refreshed, so responses keep the order of the requests.
+    _waitingForRefresh = YES;
+    dispatch_suspend(_readSource);
+    [_authState performActionWithFreshTokens:^(NSString *_Nullable freshAccessToken,
+                                               NSString *_Nullable idToken,
+                                               NSError *_Nullable error) {
+      if (self->_closed) {
+        return;
+      }
+      self->_waitingForRefresh = NO;
+      dispatch_resume(self->_readSource);
+      self->_queuedRequests--;
+      [self sendAccessToken:freshAccessToken
+             expirationDate:self->_authState.snapshot.accessTokenExpirationDate
+                      error:error];
+      [self serveQueuedRequests];
+    }
+                         additionalRefreshParameters:nil
+                                       dispatchQueue:_queue];
+  }
+}
+
+- (void)sendAccessToken:(nullable NSString *)accessToken
+         expirationDate:(nullable NSDate *)expirationDate
+                  error:(nullable NSError *)error {
+  BOOL sent;
+  if (accessToken && !error) {
+    int64_t expirationTime = (int64_t)expirationDate.timeIntervalSince1970;
+    uint64_t bigEndianExpirationTime = CFSwapInt64HostToBig((uint64_t)expirationTime);
+    sent = OIDTokenBrokerSendResponse(_fd,
+                                      OIDTokenBrokerStatusSuccess,
+                                      [NSData dataWithBytes:&bigEndianExpirationTime
+                                                     length:sizeof(bigEndianExpirationTime)],
+                                      [accessToken dataUsingEncoding:NSUTF8StringEncoding]);
+  } else {
+    NSString *description = error.localizedDescription ?: @"The token could not be refreshed.";
+    sent = OIDTokenBrokerSendResponse(_fd,
+                                      OIDTokenBrokerStatusError,
+                                      nil,
+                                      [description dataUsingEncoding:NSUTF8StringEncoding]);
+  }
+  if (!sent) {
+    [self closeOnQueue];
+  }
+}
+
+@end
+
+@implementation OIDTokenBroker {
+  /*! @brief Accepts connections. Guarded by @synchronized(self).
+   */
+  dispatch_source_t _acceptSource;
+
+  /*! @brief The open connections. Guarded by @synchronized(self).
+   */
+  NSMutableSet<OIDTokenBrokerConnection *> *_connections;
+
+  /*! @brief The device and inode of the socket bound by @c _acceptSource. Guarded by
+          @synchronized(self).
+   */
+  dev_t _boundDevice;
+  ino_t _boundInode;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithAuthState:socketPath:))
+
+- (instancetype)initWithAuthState:(OIDAuthState *)authState socketPath:(NSString *)socketPath {
+  self = [super init];
+  if (self) {
+    _authState = authState;
+    _socketPath = [socketPath copy];
+    _connections = [NSMutableSet set];
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self stop];
+}
+
+- (BOOL)startWithError:(NSError **_Nullable)error {
+  struct sockaddr_un address;
+  if (!OIDTokenBrokerSocketAddress(_socketPath, &address)) {
+    if (error) {
+      *error = OIDTokenBrokerPOSIXError(ENAMETOOLONG);
+    }
+    return NO;
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    if (error) {
+      *error = OIDTokenBrokerPOSIXError(errno);
+    }
+    return NO;
+  }
+  OIDTokenBrokerConfigureSocket(fd);
+  struct stat boundStatus;
+  int code = OIDTokenBrokerBindPrivately(fd, _socketPath, &boundStatus);
+  if (!code && fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0) {
+    code = errno;
+    unlink(address.sun_path);
+  }
+  if (code) {
+    close(fd);
+    if (error) {
+      *error = OIDTokenBrokerPOSIXError(code);
+    }
+    return NO;
+  }
+
+  dispatch_queue_t queue = dispatch_queue_create("org.openid.appauth.tokenbroker",
+                                                 DISPATCH_QUEUE_SERIAL);
+  dispatch_source_t acceptSource =
+      dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)fd, 0, queue);
+  __weak OIDTokenBroker *weakSelf = self;
+  dispatch_source_set_event_handler(acceptSource, ^{
+    [weakSelf acceptConnectionsOnSocket:fd];
+  });
+  NSString *socketPath = _socketPath;
+  dev_t boundDevice = boundStatus.st_dev;
+  ino_t boundInode = boundStatus.st_ino;
+  dispatch_source_set_cancel_handler(acceptSource, ^{
+    close(fd);
+    // the cancel handler runs asynchronously, by which time a new broker may have been bound to
+    // the same path
+    OIDTokenBrokerRemoveSocket(socketPath, boundDevice, boundInode);
+  });
+  @synchronized(self) {
+    if (_acceptSource) {
+      dispatch_source_cancel(_acceptSource);
+    }
+    _acceptSource = acceptSource;
+    _boundDevice = boundDevice;
+    _boundInode = boundInode;
+  }
+  dispatch_resume(acceptSource);
+  return YES;
+}
+
+- (void)stop {
+  NSSet<OIDTokenBrokerConnection *> *connections;
+  @synchronized(self) {
+    if (_acceptSource) {
+      dispatch_source_cancel(_acceptSource);
+      _acceptSource = nil;
+      // removed right away, as the socket keeps accepting connections until the cancel handler
+      // closes it, and a broker started meanwhile would take it for a live one
+      OIDTokenBrokerRemoveSocket(_socketPath, _boundDevice, _boundInode);
+    }
+    connections = [_connections copy];
+    [_connections removeAllObjects];
+  }
+  for (OIDTokenBrokerConnection *connection in connections) {
+    [connection close];
+  }
+}
+
+- (void)acceptConnectionsOnSocket:(int)listeningFD {
+  while (YES) {
+    int fd = accept(listeningFD, NULL, NULL);
+    if (fd < 0) {
+      // EAGAIN once all pending connections were accepted
+      return;
+    }
+    // tokens are only served to processes of the user running the broker
+    uid_t peerUID;
+    gid_t peerGID;
+    if (getpeereid(fd, &peerUID, &peerGID) != 0 || peerUID != geteuid()) {
+      close(fd);
+      continue;
+    }
+    OIDTokenBrokerConfigureSocket(fd);
+    // accepted sockets may inherit O_NONBLOCK; responses are written with blocking sends
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    OIDTokenBrokerConnection *connection =
+        [[OIDTokenBrokerConnection alloc] initWithFileDescriptor:fd broker:self];
+    @synchronized(self) {
+      [_connections addObject:connection];
+    }
+    [connection start];
+  }
+}
+
+- (void)connectionDidClose:(OIDTokenBrokerConnection *)connection {
+  @synchronized(self) {
+    [_connections removeObject:connection];
+  }
+}
+
+@end
+
+@implementation OIDTokenBrokerClient {
+  /*! @brief The connection to the broker, or -1. Guarded by @synchronized(self).
+   */
+  int _fd;
+}
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithSocketPath:))
+
+- (instancetype)initWithSocketPath:(NSString *)socketPath {
+  self = [super init];
+  if (self) {
+    _socketPath = [socketPath copy];
+    _timeout = 60;
+    _fd = -1;
+  }
+  return self;
+}
+
+- (void)dealloc {
+  [self close];
+}
+
+- (void)close {
+  @synchronized(self) {
+    if (_fd >= 0) {
+      close(_fd);
+      _fd = -1;
+    }
+  }
+}
+
+/*! @brief Connects to the broker. Called synchronized on the receiver.
+    @return The connection, or -1 with @c errno set.
+ */
+- (int)openConnection {
+  struct sockaddr_un address;
+  if (!OIDTokenBrokerSocketAddress(_socketPath, &address)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  OIDTokenBrokerConfigureSocket(fd);
+  struct timeval timeout = {
+    .tv_sec = (time_t)_timeout,
+    .tv_usec = (suseconds_t)((_timeout - (time_t)_timeout) * 1000000),
+  };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+    int code = errno;
+    close(fd);
+    errno = code;
+    return -1;
+  }
+  return fd;
+}
+
+- (nullable NSString *)fetchFreshAccessTokenWithExpirationDate:
+                           (NSDate *_Nullable *_Nullable)expirationDate
+                                                          error:(NSError **_Nullable)error {
+  @synchronized(self) {
+    // A kept-alive connection may have been closed by the broker, in which case it is reopened
+    // once. A new connection is not retried.
+    for (NSUInteger attempt = 0; attempt < 2; attempt++) {
+      BOOL reused = _fd >= 0;
+      if (!reused) {
+        _fd = [self openConnection];
+        if (_fd < 0) {
+          if (error) {
+            *error = OIDTokenBrokerPOSIXError(errno);
+          }
+          return nil;
+        }
+      }
+
+      uint8_t request = OIDTokenBrokerRequestFreshAccessToken;
+      uint8_t header[kTokenBrokerResponseHeaderSize];
+      if (!OIDTokenBrokerSendAll(_fd, &request, sizeof(request)) ||
+          !OIDTokenBrokerReceiveAll(_fd, header, sizeof(header))) {
+        int code = errno;
+        close(_fd);
+        _fd = -1;
+        if (reused && (code == ECONNRESET || code == EPIPE)) {
+          continue;
+        }
+        if (error) {
+          *error = OIDTokenBrokerPOSIXError(code);
+        }
+        return nil;
+      }
+      return [self readResponseWithHeader:header expirationDate:expirationDate error:error];
+    }
+    return nil;
+  }
+}
+
+/*! @brief Reads the payload of a response. Called synchronized on the receiver.
+    @param header The header of the response.
+    @param expirationDate Set to the expiration date of the access token, if known.
+    @param error The error if the response was an error or could not be read.
+ */
+- (nullable NSString *)readResponseWithHeader:(const uint8_t *)header
+                               expirationDate:(NSDate *_Nullable *_Nullable)expirationDate
+                                        error:(NSError **_Nullable)error {
+  OIDTokenBrokerStatus status = header[0];
+  uint32_t length;
+  memcpy(&length, header + 1, sizeof(length));
+  length = CFSwapInt32BigToHost(length);
+  BOOL valid = length <= kTokenBrokerMaximumPayloadLength &&
+      (status == OIDTokenBrokerStatusError ||
+       (status == OIDTokenBrokerStatusSuccess && length > sizeof(uint64_t)));
+  NSMutableData *payload = valid ? [NSMutableData dataWithLength:length] : nil;
+  if (!valid || !OIDTokenBrokerReceiveAll(_fd, payload.mutableBytes, length)) {
+    int code = valid ? errno : EPROTO;
+    close(_fd);
+    _fd = -1;
+    if (error) {
+      *error = OIDTokenBrokerPOSIXError(code);
+    }
+    return nil;
+  }
+
+  if (status == OIDTokenBrokerStatusError) {
+    NSString *description = [[NSString alloc] initWithData:payload
+                                                  encoding:NSUTF8StringEncoding];
+    if (error) {
+      *error = [OIDErrorUtilities errorWithCode:OIDErrorCodeTokenRefreshError
+                                underlyingError:nil
+                                    description:description];
+    }
+    return nil;
+  }
+
+  uint64_t expirationTime;
+  memcpy(&expirationTime, payload.bytes, sizeof(expirationTime));
+  expirationTime = CFSwapInt64BigToHost(expirationTime);
+  if (expirationDate) {
+    *expirationDate =
+        expirationTime ? [NSDate dateWithTimeIntervalSince1970:(int64_t)expirationTime] : nil;
+  }
+  NSData *accessToken = [payload subdataWithRange:NSMakeRange(sizeof(expirationTime),
+                                                              length - sizeof(expirationTime))];
+  return [[NSString alloc] initWithData:accessToken encoding:NSUTF8StringEncoding];
+}
+
+@end
@@ -0,0 +1,95 @@
+/*! @file OIDTokenRefreshRetryPolicy.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Runs a block after a delay.
+    @param delay The delay in seconds.
+    @param block The block to run.
+ */
+typedef void (^OIDRetryScheduler)(NSTimeInterval delay, dispatch_block_t block);
+
+/*! @brief Decides whether and when a failed @c OIDAuthState token refresh is retried.
+    @discussion Network errors, HTTP 408, 429 and 5xx responses, and the OAuth
+        @c temporarily_unavailable error are retried, up to @c maximumAttempts attempts in total.
+        Each retry waits for an exponentially increasing backoff, reduced by a random jitter so
+        that clients which failed together do not retry together. A @c Retry-After header in the
+        response is honored: the retry waits at least that long, and is not made at all if the
+        server asks to wait longer than @c maximumBackoff.
+ */
+@interface OIDTokenRefreshRetryPolicy : NSObject
+
+/*! @brief The maximum number of attempts, including the first. Defaults to 3.
+ */
+@property(nonatomic) NSUInteger maximumAttempts;
+
+/*! @brief The backoff before the first retry, in seconds. Defaults to 1.
+ */
+@property(nonatomic) NSTimeInterval initialBackoff;
+
+/*! @brief The factor the backoff is multiplied by after each retry. Defaults to 2.
+ */
+@property(nonatomic) double backoffMultiplier;
+
+/*! @brief The maximum backoff, in seconds. Defaults to 30.
+ */
+@property(nonatomic) NSTimeInterval maximumBackoff;
+
+/*! @brief The largest fraction of the backoff randomly removed from it, between 0 and 1.
+        Defaults to 0.5.
+ */
+@property(nonatomic) double jitter;
+
+/*! @brief Schedules retries. Defaults to @c dispatch_after on a global queue. Tests can substitute
+        a scheduler which runs blocks on a virtual clock.
+ */
+@property(nonatomic, copy, null_resettable) OIDRetryScheduler scheduler;
+
+/*! @brief Returns the current date, used to interpret @c Retry-After dates. Defaults to returning
+        @c OIDClock.sharedClock.now.
+ */
+@property(nonatomic, copy, null_resettable) NSDate *(^currentDate)(void);
+
+/*! @brief Determines whether a failed attempt is retried.
+    @param attempt The number of the attempt which failed, starting at 1.
+    @param error The error the attempt failed with.
+    @param delay If the attempt is retried, set to the delay before the retry in seconds.
+    @return YES if the attempt should be retried.
+ */
+- (BOOL)shouldRetryAttempt:(NSUInteger)attempt
+                afterError:(NSError *)error
+                     delay:(NSTimeInterval *)delay;
+
+/*! @brief Returns whether an error is transient, so that a retry may succeed.
+    @param error The error returned by the token request.
+ */
++ (BOOL)isRetryableError:(NSError *)error;
+
+/*! @brief Returns the delay requested by the @c Retry-After header of the response which caused an
+        error, if any.
+    @param error The error returned by the token request.
+    @param now The current date.
+    @return The delay in seconds, or a negative value if there was no valid @c Retry-After header.
+ */
++ (NSTimeInterval)retryAfterDelayForError:(NSError *)error now:(NSDate *)now;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,153 @@
+/*! @file OIDTokenRefreshRetryPolicy.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDTokenRefreshRetryPolicy.h"
+
+#import "OIDClock.h"
+#import "OIDError.h"
+
+/*! @brief The default maximum number of attempts.
+ */
+static NSUInteger const kDefaultMaximumAttempts = 3;
+
+/*! @brief The default backoff before the first retry, in seconds.
+ */
+static NSTimeInterval const kDefaultInitialBackoff = 1;
+
+/*! @brief The default backoff multiplier.
+ */
+static double const kDefaultBackoffMultiplier = 2;
+
+/*! @brief The default maximum backoff, in seconds.
+ */
+static NSTimeInterval const kDefaultMaximumBackoff = 30;
+
+/*! @brief The default jitter.
+ */
+static double const kDefaultJitter = 0.5;
+
+@implementation OIDTokenRefreshRetryPolicy
+
+@synthesize scheduler = _scheduler;
+@synthesize currentDate = _currentDate;
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _maximumAttempts = kDefaultMaximumAttempts;
+    _initialBackoff = kDefaultInitialBackoff;
+    _backoffMultiplier = kDefaultBackoffMultiplier;
+    _maximumBackoff = kDefaultMaximumBackoff;
+    _jitter = kDefaultJitter;
+  }
+  return self;
+}
+
+- (OIDRetryScheduler)scheduler {
+  if (_scheduler) {
+    return _scheduler;
+  }
+  return ^(NSTimeInterval delay, dispatch_block_t block) {
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                   dispatch_get_global_queue(QOS_CLASS_UTILITY, 0),
+                   block);
+  };
+}
+
+- (NSDate *(^)(void))currentDate {
+  if (_currentDate) {
+    return _currentDate;
+  }
+  return ^{
+    return [[OIDClock sharedClock] now];
+  };
+}
+
+- (BOOL)shouldRetryAttempt:(NSUInteger)attempt
+                afterError:(NSError *)error
+                     delay:(NSTimeInterval *)delay {
+  if (attempt >= _maximumAttempts || ![[self class] isRetryableError:error]) {
+    return NO;
+  }
+
+  NSTimeInterval backoff = _initialBackoff * pow(_backoffMultiplier, attempt - 1);
+  backoff = MIN(backoff, _maximumBackoff);
+  double jitter = MIN(MAX(_jitter, 0), 1);
+  backoff -= backoff * jitter * ((double)arc4random() / UINT32_MAX);
+
+  NSTimeInterval retryAfter = [[self class] retryAfterDelayForError:error
+                                                                now:self.currentDate()];
+  if (retryAfter > _maximumBackoff) {
+    // The server asked to wait for longer than actions should be held for.
+    return NO;
+  }
+  *delay = MAX(backoff, retryAfter);
+  return YES;
+}
+
+/*! @brief Returns the HTTP error underlying an error returned by a token request, if any.
+ */
++ (nullable NSError *)HTTPErrorForError:(NSError *)error {
+  NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+  if ([underlyingError.domain isEqualToString:OIDHTTPErrorDomain]) {
+    return underlyingError;
+  }
+  return nil;
+}
+
++ (BOOL)isRetryableError:(NSError *)error {
+  if ([error.domain isEqualToString:OIDGeneralErrorDomain]) {
+    if (error.code == OIDErrorCodeNetworkError) {
+      NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+      return !([underlyingError.domain isEqualToString:NSURLErrorDomain] &&
+               underlyingError.code == NSURLErrorCancelled);
+    }
+    if (error.code == OIDErrorCodeServerError) {
+      NSInteger statusCode = [self HTTPErrorForError:error].code;
+      return statusCode == 408 || statusCode == 429 || (statusCode >= 500 && statusCode < 600);
+    }
+    return NO;
+  }
+  if ([error.domain isEqualToString:OIDOAuthTokenErrorDomain]) {
+    return error.code == OIDErrorCodeOAuthTemporarilyUnavailable;
+  }
+  return NO;
+}
+
++ (NSTimeInterval)retryAfterDelayForError:(NSError *)error now:(NSDate *)now {
+  NSString *retryAfter = [self HTTPErrorForError:error].userInfo[OIDHTTPRetryAfterErrorKey];
+  if (![retryAfter isKindOfClass:[NSString class]]) {
+    return -1;
+  }
+  retryAfter = [retryAfter stringByTrimmingCharactersInSet:
+      [NSCharacterSet whitespaceCharacterSet]];
+
+  NSScanner *scanner = [NSScanner scannerWithString:retryAfter];
+  NSInteger seconds;
+  if ([scanner scanInteger:&seconds] && scanner.isAtEnd) {
+    return seconds >= 0 ? seconds : -1;
+  }
+
+  NSDate *date = [OIDClock dateFromHTTPDate:retryAfter];
+  if (!date) {
+    return -1;
+  }
+  return MAX([date timeIntervalSinceDate:now], 0);
+}
+
+@end
@@ -20,6 +20,7 @@
 
 #import "OIDDefines.h"
 #import "OIDError.h"
+#import "OIDFieldMapping.h"
 #import "OIDScopeUtilities.h"
 #import "OIDServiceConfiguration.h"
 #import "OIDURLQueryComponent.h"
@@ -72,6 +73,11 @@ static NSString *const kAdditionalParametersKey = @"additionalParameters";
  */
 static NSString *const kAdditionalHeadersKey = @"additionalHeaders";
 
+/*! @brief Maximum number of entries kept in each of the per-client caches used by
+        @c OIDTokenRequest.URLRequest.
+ */
+static NSUInteger const kClientCacheLimit = 16;
+
 @implementation OIDTokenRequest
 
 - (instancetype)init
@@ -227,22 +233,12 @@ static NSString *const kAdditionalHeadersKey = @"additionalHeaders";
   NSString *refreshToken = [aDecoder decodeObjectOfClass:[NSString class] forKey:kRefreshTokenKey];
   NSString *codeVerifier = [aDecoder decodeObjectOfClass:[NSString class] forKey:kCodeVerifierKey];
   NSURL *redirectURL = [aDecoder decodeObjectOfClass:[NSURL class] forKey:kRedirectURLKey];
-  NSSet *additionalParameterCodingClasses = [NSSet setWithArray:@[
-    [NSDictionary class],
-    [NSString class]
-  ]];
-    
   NSDictionary *additionalParameters =
-      [aDecoder decodeObjectOfClasses:additionalParameterCodingClasses forKey:kAdditionalParametersKey];
-    
-    
-  NSSet *additionalHeaderCodingClasses = [NSSet setWithArray:@[
-    [NSDictionary class],
-    [NSString class]
-  ]];
-    
+      [aDecoder decodeObjectOfClasses:[OIDFieldMapping stringDictionaryTypes]
+                               forKey:kAdditionalParametersKey];
   NSDictionary *additionalHeaders =
-      [aDecoder decodeObjectOfClasses:additionalHeaderCodingClasses forKey:kAdditionalHeadersKey];
+      [aDecoder decodeObjectOfClasses:[OIDFieldMapping stringDictionaryTypes]
+                               forKey:kAdditionalHeadersKey];
   
   self = [super init];
   if (self) {
@@ -334,6 +330,103 @@ static NSString *const kAdditionalHeadersKey = @"additionalHeaders";
   return query;
 }
 
+/*! @brief Returns the "Basic" Authorization header value for this client's credentials, encoding
+        them on first use and caching the result for later requests of the same client.
+    @see https://tools.ietf.org/html/rfc6749#section-2.3.1
+ */
+- (NSString *)basicAuthorizationHeaderValue {
+  static NSCache<NSArray<NSString *> *, NSString *> *headerValues;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    headerValues = [[NSCache alloc] init];
+    headerValues.countLimit = kClientCacheLimit;
+  });
+
+  NSArray<NSString *> *key = @[ _clientID, _clientSecret ];
+  NSString *authValue = [headerValues objectForKey:key];
+  if (authValue) {
+    return authValue;
+  }
+
+  // The client id and secret are encoded using the "application/x-www-form-urlencoded"
+  // encoding algorithm per RFC 6749 Section 2.3.1.
+  // https://tools.ietf.org/html/rfc6749#section-2.3.1
+  NSString *encodedClientID = [OIDTokenUtilities formUrlEncode:_clientID];
+  NSString *encodedClientSecret = [OIDTokenUtilities formUrlEncode:_clientSecret];
+
+  NSString *credentials =
+      [NSString stringWithFormat:@"%@:%@", encodedClientID, encodedClientSecret];
+  NSData *plainData = [credentials dataUsingEncoding:NSUTF8StringEncoding];
+  NSString *basicAuth = [plainData base64EncodedStringWithOptions:kNilOptions];
+
+  authValue = [NSString stringWithFormat:@"Basic %@", basicAuth];
+  [headerValues setObject:authValue forKey:key];
+  return authValue;
+}
+
+/*! @brief Returns the encoded request body, reusing the already-encoded parameters which are the
+        same for every request of this client and grant type.
+    @discussion Only the refresh token, authorization code, code verifier and additional parameters
+        are encoded for each request.
+ */
+- (NSString *)tokenRequestBodyString {
+  static NSCache<NSArray *, NSString *> *staticBodies;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    staticBodies = [[NSCache alloc] init];
+    staticBodies.countLimit = kClientCacheLimit;
+  });
+
+  // Without a client secret, the client_id is sent in the body rather than the header.
+  NSString *bodyClientID = _clientSecret ? nil : _clientID;
+  NSArray *key = @[
+    _grantType ?: [NSNull null],
+    _scope ?: [NSNull null],
+    _redirectURL ?: [NSNull null],
+    bodyClientID ?: [NSNull null],
+    @(gOIDURLQueryComponentForceIOS7Handling),
+  ];
+  NSString *staticBody = [staticBodies objectForKey:key];
+  if (!staticBody) {
+    OIDURLQueryComponent *staticParameters = [[OIDURLQueryComponent alloc] init];
+    if (_grantType) {
+      [staticParameters addParameter:kGrantTypeKey value:_grantType];
+    }
+    if (_scope) {
+      [staticParameters addParameter:kScopeKey value:_scope];
+    }
+    if (_redirectURL) {
+      [staticParameters addParameter:kRedirectURLKey value:_redirectURL.absoluteString];
+    }
+    if (bodyClientID) {
+      [staticParameters addParameter:kClientIDKey value:bodyClientID];
+    }
+    staticBody = [staticParameters URLEncodedParameters] ?: @"";
+    [staticBodies setObject:staticBody forKey:key];
+  }
+
+  OIDURLQueryComponent *dynamicParameters = [[OIDURLQueryComponent alloc] init];
+  if (_refreshToken) {
+    [dynamicParameters addParameter:kRefreshTokenKey value:_refreshToken];
+  }
+  if (_authorizationCode) {
+    [dynamicParameters addParameter:kAuthorizationCodeKey value:_authorizationCode];
+  }
+  if (_codeVerifier) {
+    [dynamicParameters addParameter:kCodeVerifierKey value:_codeVerifier];
+  }
+  [dynamicParameters addParameters:_additionalParameters];
+  if (dynamicParameters.parameters.count == 0) {
+    return staticBody;
+  }
+
+  NSString *dynamicBody = [dynamicParameters URLEncodedParameters];
+  if (staticBody.length == 0) {
+    return dynamicBody;
+  }
+  return [NSString stringWithFormat:@"%@&%@", staticBody, dynamicBody];
+}
+
 - (NSURLRequest *)URLRequest {
   static NSString *const kHTTPPost = @"POST";
   static NSString *const kHTTPContentTypeHeaderKey = @"Content-Type";
@@ -345,29 +438,26 @@ static NSString *const kAdditionalHeadersKey = @"additionalHeaders";
   URLRequest.HTTPMethod = kHTTPPost;
   [URLRequest setValue:kHTTPContentTypeHeaderValue forHTTPHeaderField:kHTTPContentTypeHeaderKey];
 
-  OIDURLQueryComponent *bodyParameters = [self tokenRequestBody];
   NSMutableDictionary *httpHeaders = [[NSMutableDictionary alloc] init];
 
   if (_clientSecret) {
-    // The client id and secret are encoded using the "application/x-www-form-urlencoded" 
-    // encoding algorithm per RFC 6749 Section 2.3.1.
-    // https://tools.ietf.org/html/rfc6749#section-2.3.1
-    NSString *encodedClientID = [OIDTokenUtilities formUrlEncode:_clientID];
-    NSString *encodedClientSecret = [OIDTokenUtilities formUrlEncode:_clientSecret];
-    
-    NSString *credentials =
-        [NSString stringWithFormat:@"%@:%@", encodedClientID, encodedClientSecret];
-    NSData *plainData = [credentials dataUsingEncoding:NSUTF8StringEncoding];
-    NSString *basicAuth = [plainData base64EncodedStringWithOptions:kNilOptions];
-
-    NSString *authValue = [NSString stringWithFormat:@"Basic %@", basicAuth];
-    [httpHeaders setObject:authValue forKey:@"Authorization"];
-  } else  {
-    [bodyParameters addParameter:kClientIDKey value:_clientID];
+    [httpHeaders setObject:[self basicAuthorizationHeaderValue] forKey:@"Authorization"];
+  }
+
+  // Subclasses which provide their own body parameters have them encoded in full.
+  NSString *bodyString;
+  if ([self methodForSelector:@selector(tokenRequestBody)] ==
+      [OIDTokenRequest instanceMethodForSelector:@selector(tokenRequestBody)]) {
+    bodyString = [self tokenRequestBodyString];
+  } else {
+    OIDURLQueryComponent *bodyParameters = [self tokenRequestBody];
+    if (!_clientSecret) {
+      [bodyParameters addParameter:kClientIDKey value:_clientID];
+    }
+    bodyString = [bodyParameters URLEncodedParameters];
   }
 
   // Constructs request with the body string and headers.
-  NSString *bodyString = [bodyParameters URLEncodedParameters];
   NSData *body = [bodyString dataUsingEncoding:NSUTF8StringEncoding];
   URLRequest.HTTPBody = body;
 
@@ -0,0 +1,174 @@
+/*! @file OIDTokenRequestScheduler.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDScheduledTokenRequest;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The priority classes of token requests.
+ */
+typedef NS_ENUM(NSInteger, OIDTokenRequestPriority) {
+  /*! @brief Requests a user is waiting for, such as a refresh triggered from the UI.
+   */
+  OIDTokenRequestPriorityInteractive = 0,
+
+  /*! @brief Requests without a particular priority. The default.
+   */
+  OIDTokenRequestPriorityNormal = 1,
+
+  /*! @brief Requests no user is waiting for, such as bulk refreshes and device flow polls.
+   */
+  OIDTokenRequestPriorityBackground = 2,
+};
+
+/*! @brief Limits the number of token requests in flight for each priority class, so that requests
+        a user is waiting for are not queued behind background work.
+    @discussion Each priority class has its own limit, and requests beyond it wait in first-in,
+        first-out order until a request of the same class completes. Requests of one class never
+        wait for those of another, so keep the sum of the limits within the
+        @c HTTPMaximumConnectionsPerHost of the @c OIDURLSessionProvider session, or background
+        requests may still hold every connection.
+
+        Set @c sharedScheduler to schedule the token requests made through
+        @c OIDAuthorizationService, including the token refreshes of every @c OIDAuthState.
+        Whether or not requests are scheduled, their priority sets the @c NSURLSessionTask.priority
+        of their session task, and the quality of service their response is processed at.
+ */
+@interface OIDTokenRequestScheduler : NSObject
+
+/*! @brief Creates a scheduler allowing 3 interactive, 2 normal and 1 background request in flight,
+        six in total, as many as the connections per host an @c NSURLSession opens by default.
+ */
+- (instancetype)init NS_DESIGNATED_INITIALIZER;
+
+/*! @brief The scheduler of token requests made through @c OIDAuthorizationService, if any.
+        Defaults to nil.
+ */
++ (nullable OIDTokenRequestScheduler *)sharedScheduler;
+
+/*! @brief Sets the scheduler of token requests made through @c OIDAuthorizationService.
+    @param scheduler The scheduler, or nil to send every request right away.
+ */
++ (void)setSharedScheduler:(nullable OIDTokenRequestScheduler *)scheduler;
+
+/*! @brief Returns the @c NSURLSessionTask.priority of the requests of a priority class.
+    @param priority The priority class.
+ */
++ (float)sessionTaskPriorityForPriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Returns the quality of service the responses of a priority class are processed at.
+    @param priority The priority class.
+ */
++ (qos_class_t)QOSClassForPriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Returns the maximum number of requests of a priority class in flight.
+    @param priority The priority class.
+ */
+- (NSUInteger)maximumConcurrentRequestsForPriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Sets the maximum number of requests of a priority class in flight. Raising it starts
+        waiting requests right away.
+    @param maximumConcurrentRequests The maximum number of requests, at least 1.
+    @param priority The priority class.
+ */
+- (void)setMaximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                         forPriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Returns the number of requests of a priority class in flight.
+    @param priority The priority class.
+ */
+- (NSUInteger)runningRequestCountForPriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Returns the number of requests of a priority class waiting to be sent.
+    @param priority The priority class.
+ */
+- (NSUInteger)waitingRequestCountForPriority:(OIDTokenRequestPriority)priority;
+
+/*! @internal
+    @brief Starts a request if its priority class has fewer requests in flight than allowed,
+        otherwise queues it.
+    @param request The request.
+ */
+- (void)scheduleRequest:(OIDScheduledTokenRequest *)request;
+
+/*! @internal
+    @brief Raises the priority of a request. A waiting request moves to the queue of its new
+        priority class, and a request in flight has the priority of its session task raised.
+    @param request The request.
+    @param priority The new priority, ignored unless higher than the current one.
+ */
+- (void)raisePriorityOfRequest:(OIDScheduledTokenRequest *)request
+                    toPriority:(OIDTokenRequestPriority)priority;
+
+/*! @internal
+    @brief Frees the slot of a request which completed, and starts the next waiting request, or
+        removes a request which completed before it was started from its queue.
+    @param request The request.
+ */
+- (void)requestDidComplete:(OIDScheduledTokenRequest *)request;
+
+@end
+
+/*! @internal
+    @brief A token request, started by an @c OIDTokenRequestScheduler or right away.
+ */
+@interface OIDScheduledTokenRequest : NSObject
+
+/*! @brief The priority of the request.
+ */
+@property(nonatomic, readonly) OIDTokenRequestPriority priority;
+
+/*! @internal
+    @brief Unavailable. Use @c initWithPriority:startHandler:.
+ */
+- (instancetype)init NS_UNAVAILABLE;
+
+/*! @brief Creates a request.
+    @param priority The priority of the request.
+    @param startHandler Sends the request, and calls @c complete once it completes.
+ */
+- (instancetype)initWithPriority:(OIDTokenRequestPriority)priority
+                    startHandler:(void (^)(OIDScheduledTokenRequest *request))startHandler
+    NS_DESIGNATED_INITIALIZER;
+
+/*! @brief Sends the request, scheduled by @c scheduler if not nil.
+    @param scheduler The scheduler, if any.
+ */
+- (void)startWithScheduler:(nullable OIDTokenRequestScheduler *)scheduler;
+
+/*! @brief Sets the session task sending the request, whose priority follows that of the request.
+    @param sessionTask The session task.
+ */
+- (void)setSessionTask:(NSURLSessionTask *)sessionTask;
+
+/*! @brief Raises the priority of the request.
+    @param priority The new priority, ignored unless higher than the current one.
+ */
+- (void)raisePriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Marks the request as completed, freeing its slot in the scheduler, or its place in the
+        queue if it has not started, in which case it never will. Calls after the first have no
+        effect.
+ */
+- (void)complete;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,387 @@
+/*! @file OIDTokenRequestScheduler.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDTokenRequestScheduler.h"
+
+#import "OIDDefines.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The number of priority classes.
+ */
+#define OID_TOKEN_REQUEST_PRIORITY_COUNT 3
+
+/*! @brief The scheduler of token requests made through @c OIDAuthorizationService. Guarded by
+        @synchronized on @c OIDTokenRequestScheduler.
+ */
+static OIDTokenRequestScheduler *_Nullable gSharedScheduler;
+
+/*! @brief Returns the index of a priority class in the per-class arrays of a scheduler, treating
+        unknown values as @c OIDTokenRequestPriorityNormal.
+ */
+static inline NSUInteger OIDTokenRequestPriorityIndex(OIDTokenRequestPriority priority) {
+  return priority >= 0 && priority < OID_TOKEN_REQUEST_PRIORITY_COUNT
+      ? (NSUInteger)priority
+      : (NSUInteger)OIDTokenRequestPriorityNormal;
+}
+
+@interface OIDScheduledTokenRequest ()
+
+/*! @brief The scheduler of the request, if any. Guarded by @synchronized(self).
+ */
+@property(nonatomic, nullable) OIDTokenRequestScheduler *scheduler;
+
+/*! @brief The priority class whose slot the request occupies while in flight, or @c NSNotFound
+        before it was given one. Guarded by @synchronized on the scheduler.
+ */
+@property(nonatomic) NSUInteger slotIndex;
+
+/*! @brief Whether the request completed. Guarded by @synchronized(self).
+ */
+@property(nonatomic, readonly, getter=isCompleted) BOOL completed;
+
+/*! @brief Sets the priority of the request and of its session task, unless lower than the current
+        one.
+    @return YES if the priority was raised.
+ */
+- (BOOL)updatePriority:(OIDTokenRequestPriority)priority;
+
+/*! @brief Calls the start handler.
+ */
+- (void)start;
+
+@end
+
+@implementation OIDTokenRequestScheduler {
+  /*! @brief The maximum number of requests in flight, per priority class. Guarded by
+          @synchronized(self).
+   */
+  NSUInteger _maximumConcurrentRequests[OID_TOKEN_REQUEST_PRIORITY_COUNT];
+
+  /*! @brief The number of requests in flight, per priority class. Guarded by @synchronized(self).
+   */
+  NSUInteger _runningRequestCounts[OID_TOKEN_REQUEST_PRIORITY_COUNT];
+
+  /*! @brief The requests waiting to be sent, oldest first, per priority class. Guarded by
+          @synchronized(self).
+   */
+  NSMutableArray<OIDScheduledTokenRequest *> *_waitingRequests[OID_TOKEN_REQUEST_PRIORITY_COUNT];
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _maximumConcurrentRequests[OIDTokenRequestPriorityInteractive] = 3;
+    _maximumConcurrentRequests[OIDTokenRequestPriorityNormal] = 2;
+    _maximumConcurrentRequests[OIDTokenRequestPriorityBackground] = 1;
+    for (NSUInteger i = 0; i < OID_TOKEN_REQUEST_PRIORITY_COUNT; i++) {
+      _waitingRequests[i] = [NSMutableArray array];
+    }
+  }
+  return self;
+}
+
++ (nullable OIDTokenRequestScheduler *)sharedScheduler {
+  @synchronized([OIDTokenRequestScheduler class]) {
+    return gSharedScheduler;
+  }
+}
+
++ (void)setSharedScheduler:(nullable OIDTokenRequestScheduler *)scheduler {
+  @synchronized([OIDTokenRequestScheduler class]) {
+    gSharedScheduler = scheduler;
+  }
+}
+
++ (float)sessionTaskPriorityForPriority:(OIDTokenRequestPriority)priority {
+  switch (priority) {
+    case OIDTokenRequestPriorityInteractive:
+      return NSURLSessionTaskPriorityHigh;
+    case OIDTokenRequestPriorityNormal:
+      return NSURLSessionTaskPriorityDefault;
+    case OIDTokenRequestPriorityBackground:
+      return NSURLSessionTaskPriorityLow;
+  }
+  return NSURLSessionTaskPriorityDefault;
+}
+
++ (qos_class_t)QOSClassForPriority:(OIDTokenRequestPriority)priority {
+  switch (priority) {
+    case OIDTokenRequestPriorityInteractive:
+      return QOS_CLASS_USER_INITIATED;
+    case OIDTokenRequestPriorityNormal:
+      return QOS_CLASS_DEFAULT;
+    case OIDTokenRequestPriorityBackground:
+      // not QOS_CLASS_BACKGROUND, which may be deferred for minutes in Low Power Mode
+      return QOS_CLASS_UTILITY;
+  }
+  return QOS_CLASS_DEFAULT;
+}
+
+- (NSUInteger)maximumConcurrentRequestsForPriority:(OIDTokenRequestPriority)priority {
+  @synchronized(self) {
+    return _maximumConcurrentRequests[OIDTokenRequestPriorityIndex(priority)];
+  }
+}
+
+- (void)setMaximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+                         forPriority:(OIDTokenRequestPriority)priority {
+  NSArray<OIDScheduledTokenRequest *> *requestsToStart;
+  @synchronized(self) {
+    _maximumConcurrentRequests[OIDTokenRequestPriorityIndex(priority)] =
+        MAX(maximumConcurrentRequests, 1);
+    requestsToStart = [self dequeueStartableRequests];
+  }
+  [self startRequests:requestsToStart];
+}
+
+- (NSUInteger)runningRequestCountForPriority:(OIDTokenRequestPriority)priority {
+  @synchronized(self) {
+    return _runningRequestCounts[OIDTokenRequestPriorityIndex(priority)];
+  }
+}
+
+- (NSUInteger)waitingRequestCountForPriority:(OIDTokenRequestPriority)priority {
+  @synchronized(self) {
+    return _waitingRequests[OIDTokenRequestPriorityIndex(priority)].count;
+  }
+}
+
+- (void)scheduleRequest:(OIDScheduledTokenRequest *)request {
+  BOOL startsNow = NO;
+  @synchronized(self) {
+    if (request.isCompleted) {
+      // cancelled before it was scheduled
+      return;
+    }
+    NSUInteger index = OIDTokenRequestPriorityIndex(request.priority);
+    if (_runningRequestCounts[index] < _maximumConcurrentRequests[index]) {
+      _runningRequestCounts[index]++;
+      request.slotIndex = index;
+      startsNow = YES;
+    } else {
+      [_waitingRequests[index] addObject:request];
+    }
+  }
+  if (startsNow) {
+    [request start];
+  }
+}
+
+- (void)raisePriorityOfRequest:(OIDScheduledTokenRequest *)request
+                    toPriority:(OIDTokenRequestPriority)priority {
+  NSArray<OIDScheduledTokenRequest *> *requestsToStart;
+  @synchronized(self) {
+    NSUInteger oldIndex = OIDTokenRequestPriorityIndex(request.priority);
+    if (![request updatePriority:priority]) {
+      return;
+    }
+    NSUInteger waitingIndex = [_waitingRequests[oldIndex] indexOfObjectIdenticalTo:request];
+    if (waitingIndex == NSNotFound) {
+      // in flight, in the slot it was started in
+      return;
+    }
+    [_waitingRequests[oldIndex] removeObjectAtIndex:waitingIndex];
+    [_waitingRequests[OIDTokenRequestPriorityIndex(priority)] addObject:request];
+    requestsToStart = [self dequeueStartableRequests];
+  }
+  [self startRequests:requestsToStart];
+}
+
+- (void)requestDidComplete:(OIDScheduledTokenRequest *)request {
+  NSArray<OIDScheduledTokenRequest *> *requestsToStart;
+  @synchronized(self) {
+    NSUInteger index = OIDTokenRequestPriorityIndex(request.priority);
+    NSUInteger waitingIndex = [_waitingRequests[index] indexOfObjectIdenticalTo:request];
+    if (waitingIndex != NSNotFound) {
+      // cancelled before it was started
+      [_waitingRequests[index] removeObjectAtIndex:waitingIndex];
+      return;
+    }
+    if (request.slotIndex == NSNotFound) {
+      // cancelled before it was scheduled
+      return;
+    }
+    _runningRequestCounts[request.slotIndex]--;
+    requestsToStart = [self dequeueStartableRequests];
+  }
+  [self startRequests:requestsToStart];
+}
+
+/*! @brief Removes the waiting requests which may be started from their queues, counting them as
+        in flight. Must be called while synchronized on self.
+    @return The requests to start.
+ */
+- (NSArray<OIDScheduledTokenRequest *> *)dequeueStartableRequests {
+  NSMutableArray<OIDScheduledTokenRequest *> *requests = [NSMutableArray array];
+  for (NSUInteger index = 0; index < OID_TOKEN_REQUEST_PRIORITY_COUNT; index++) {
+    NSMutableArray<OIDScheduledTokenRequest *> *waitingRequests = _waitingRequests[index];
+    while (waitingRequests.count &&
+           _runningRequestCounts[index] < _maximumConcurrentRequests[index]) {
+      OIDScheduledTokenRequest *request = waitingRequests.firstObject;
+      [waitingRequests removeObjectAtIndex:0];
+      _runningRequestCounts[index]++;
+      request.slotIndex = index;
+      [requests addObject:request];
+    }
+  }
+  return requests;
+}
+
+/*! @brief Starts requests which were waiting, each at the quality of service of its priority.
+    @param requests The requests.
+ */
+- (void)startRequests:(NSArray<OIDScheduledTokenRequest *> *)requests {
+  for (OIDScheduledTokenRequest *request in requests) {
+    qos_class_t QOSClass = [[self class] QOSClassForPriority:request.priority];
+    dispatch_async(dispatch_get_global_queue(QOSClass, 0), ^{
+      [request start];
+    });
+  }
+}
+
+@end
+
+@implementation OIDScheduledTokenRequest {
+  /*! @brief Sends the request. Cleared once called. Guarded by @synchronized(self).
+   */
+  void (^_Nullable _startHandler)(OIDScheduledTokenRequest *request);
+
+  /*! @brief The session task sending the request, if any. Guarded by @synchronized(self).
+   */
+  NSURLSessionTask *_Nullable _sessionTask;
+
+}
+
+@synthesize priority = _priority;
+@synthesize scheduler = _scheduler;
+@synthesize slotIndex = _slotIndex;
+@synthesize completed = _completed;
+
+- (instancetype)init
+    OID_UNAVAILABLE_USE_INITIALIZER(@selector(initWithPriority:startHandler:))
+
+- (instancetype)initWithPriority:(OIDTokenRequestPriority)priority
+                    startHandler:(void (^)(OIDScheduledTokenRequest *request))startHandler {
+  self = [super init];
+  if (self) {
+    _priority = priority;
+    _startHandler = [startHandler copy];
+    _slotIndex = NSNotFound;
+  }
+  return self;
+}
+
+- (OIDTokenRequestPriority)priority {
+  @synchronized(self) {
+    return _priority;
+  }
+}
+
+- (nullable OIDTokenRequestScheduler *)scheduler {
+  @synchronized(self) {
+    return _scheduler;
+  }
+}
+
+- (void)setScheduler:(nullable OIDTokenRequestScheduler *)scheduler {
+  @synchronized(self) {
+    _scheduler = scheduler;
+  }
+}
+
+- (BOOL)isCompleted {
+  @synchronized(self) {
+    return _completed;
+  }
+}
+
+- (void)startWithScheduler:(nullable OIDTokenRequestScheduler *)scheduler {
+  if (!scheduler) {
+    [self start];
+    return;
+  }
+  @synchronized(self) {
+    if (_completed) {
+      return;
+    }
+    _scheduler = scheduler;
+  }
+  [scheduler scheduleRequest:self];
+}
+
+- (void)start {
+  void (^startHandler)(OIDScheduledTokenRequest *request);
+  @synchronized(self) {
+    startHandler = _startHandler;
+    _startHandler = nil;
+  }
+  if (startHandler) {
+    startHandler(self);
+  }
+}
+
+- (void)setSessionTask:(NSURLSessionTask *)sessionTask {
+  OIDTokenRequestPriority priority;
+  @synchronized(self) {
+    _sessionTask = sessionTask;
+    priority = _priority;
+  }
+  sessionTask.priority = [OIDTokenRequestScheduler sessionTaskPriorityForPriority:priority];
+}
+
+- (void)raisePriority:(OIDTokenRequestPriority)priority {
+  OIDTokenRequestScheduler *scheduler = self.scheduler;
+  if (scheduler) {
+    [scheduler raisePriorityOfRequest:self toPriority:priority];
+  } else {
+    [self updatePriority:priority];
+  }
+}
+
+- (BOOL)updatePriority:(OIDTokenRequestPriority)priority {
+  NSURLSessionTask *sessionTask;
+  @synchronized(self) {
+    // lower values are higher priorities
+    if (priority >= _priority) {
+      return NO;
+    }
+    _priority = priority;
+    sessionTask = _sessionTask;
+  }
+  sessionTask.priority = [OIDTokenRequestScheduler sessionTaskPriorityForPriority:priority];
+  return YES;
+}
+
+- (void)complete {
+  OIDTokenRequestScheduler *scheduler;
+  @synchronized(self) {
+    if (_completed) {
+      return;
+    }
+    _completed = YES;
+    _startHandler = nil;
+    _sessionTask = nil;
+    scheduler = _scheduler;
+  }
+  [scheduler requestDidComplete:self];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
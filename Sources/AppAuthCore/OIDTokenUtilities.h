@@ -37,6 +37,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (NSString *)encodeBase64urlNoPadding:(NSData *)data;
 
+/*! @brief Decodes base64url-nopadding encoded data.
+    @param base64urlNoPaddingString The base64url encoded string, with or without padding.
+    @return The decoded data, or nil if the input isn't valid base64url.
+ */
++ (nullable NSData *)decodeBase64urlNoPadding:(NSString *)base64urlNoPaddingString;
+
 /*! @brief Generates a URL-safe string of random data.
     @param size The number of random bytes to encode. NB. the length of the output string will be
         greater than the number of random bytes, due to the URL-safe encoding.
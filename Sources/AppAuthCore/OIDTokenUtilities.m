@@ -38,6 +38,25 @@ static NSString *const kFormUrlEncodedAllowedCharacters =
   return base64string;
 }
 
++ (nullable NSData *)decodeBase64urlNoPadding:(NSString *)base64urlNoPaddingString {
+  NSMutableString *base64string = [base64urlNoPaddingString mutableCopy];
+  // converts base64url to base64
+  NSRange range = NSMakeRange(0, base64string.length);
+  [base64string replaceOccurrencesOfString:@"-"
+                                 withString:@"+"
+                                    options:NSLiteralSearch
+                                      range:range];
+  [base64string replaceOccurrencesOfString:@"_"
+                                 withString:@"/"
+                                    options:NSLiteralSearch
+                                      range:range];
+  // restores padding
+  while (base64string.length % 4 != 0) {
+    [base64string appendString:@"="];
+  }
+  return [[NSData alloc] initWithBase64EncodedString:base64string options:0];
+}
+
 + (nullable NSString *)randomURLSafeStringWithSize:(NSUInteger)size {
   NSMutableData *randomData = [NSMutableData dataWithLength:size];
   int result = SecRandomCopyBytes(kSecRandomDefault, randomData.length, randomData.mutableBytes);
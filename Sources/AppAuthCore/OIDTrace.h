@@ -0,0 +1,151 @@
+/*! @file OIDTrace.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+#import <stdatomic.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief The phases of discovery, token requests and their callbacks which can be traced.
+ */
+typedef NS_ENUM(NSInteger, OIDTracePhase) {
+  /*! @brief Fetching a discovery document, from sending the request to receiving the response.
+   */
+  OIDTracePhaseDiscoveryFetch = 0,
+
+  /*! @brief Building the @c NSURLRequest for a token request.
+   */
+  OIDTracePhaseTokenRequestBuild = 1,
+
+  /*! @brief Waiting for the response to a token request.
+   */
+  OIDTracePhaseNetworkWait = 2,
+
+  /*! @brief Parsing the JSON of a discovery document or token response.
+   */
+  OIDTracePhaseJSONParse = 3,
+
+  /*! @brief Mapping the parsed JSON of a token response onto an @c OIDTokenResponse.
+   */
+  OIDTracePhaseFieldMapping = 4,
+
+  /*! @brief Parsing and validating the ID Token of a token response.
+   */
+  OIDTracePhaseIDTokenValidation = 5,
+
+  /*! @brief Waiting for the main queue to run a completion callback.
+   */
+  OIDTracePhaseCallbackDispatch = 6,
+};
+
+/*! @protocol OIDTraceObserver
+    @brief Receives the begin and end of every traced phase.
+    @discussion Observers are called synchronously on the thread performing the phase, which is
+        often not the main thread, so implementations must be thread safe and return quickly.
+ */
+@protocol OIDTraceObserver <NSObject>
+
+/*! @brief Called when a phase begins.
+    @param phase The phase.
+    @param identifier Identifies this interval, and is passed again when it ends.
+ */
+- (void)tracePhase:(OIDTracePhase)phase didBeginWithIdentifier:(uint64_t)identifier;
+
+/*! @brief Called when a phase ends.
+    @param phase The phase.
+    @param identifier The identifier passed when the interval began.
+ */
+- (void)tracePhase:(OIDTracePhase)phase didEndWithIdentifier:(uint64_t)identifier;
+
+@end
+
+/*! @brief Configures tracing of the time spent in each phase of discovery and token requests.
+    @discussion Tracing is disabled by default, in which case each traced phase costs a single
+        check of a global flag. Once enabled, each phase is reported to the observer as an interval
+        and, where available, emitted as an @c os_signpost interval under the
+        "org.openid.appauth" subsystem so it appears in Instruments and production traces.
+ */
+@interface OIDTrace : NSObject
+
+/*! @brief The observer which receives traced intervals, if any.
+ */
++ (nullable id<OIDTraceObserver>)observer;
+
+/*! @brief Sets the observer which receives traced intervals.
+    @param observer The observer, or nil to stop observing. It is retained.
+ */
++ (void)setObserver:(nullable id<OIDTraceObserver>)observer;
+
+/*! @brief Whether traced intervals are emitted as @c os_signpost intervals.
+ */
++ (BOOL)signpostsEnabled;
+
+/*! @brief Enables or disables emitting traced intervals as @c os_signpost intervals. Has no effect
+        where signposts are unavailable.
+    @param enabled Whether signposts should be emitted.
+ */
++ (void)setSignpostsEnabled:(BOOL)enabled;
+
+/*! @brief Returns a short name for the phase, as used for its signposts.
+    @param phase The phase.
+ */
++ (NSString *)nameForPhase:(OIDTracePhase)phase;
+
+@end
+
+/*! @brief Whether any tracing is enabled. For use by the inline functions below, which read it
+        with a relaxed load from any thread.
+ */
+extern atomic_bool gOIDTraceEnabled;
+
+/*! @brief Begins a traced interval. For use by the inline functions below.
+ */
+uint64_t OIDTraceBeginPhaseSlow(OIDTracePhase phase);
+
+/*! @brief Ends a traced interval. For use by the inline functions below.
+ */
+void OIDTraceEndPhaseSlow(OIDTracePhase phase, uint64_t identifier);
+
+/*! @brief Begins a traced interval, at the cost of a single check when tracing is disabled.
+    @param phase The phase which begins.
+    @return The identifier of the interval, to pass to @c OIDTraceEndPhase, or 0 when tracing is
+        disabled.
+ */
+static inline uint64_t OIDTraceBeginPhase(OIDTracePhase phase) {
+  return atomic_load_explicit(&gOIDTraceEnabled, memory_order_relaxed)
+      ? OIDTraceBeginPhaseSlow(phase)
+      : 0;
+}
+
+/*! @brief Ends a traced interval begun with @c OIDTraceBeginPhase.
+    @param phase The phase which ends.
+    @param identifier The identifier returned when the interval began.
+ */
+static inline void OIDTraceEndPhase(OIDTracePhase phase, uint64_t identifier) {
+  if (identifier) {
+    OIDTraceEndPhaseSlow(phase, identifier);
+  }
+}
+
+/*! @brief Dispatches a completion callback to the main queue, tracing the wait as an
+        @c OIDTracePhaseCallbackDispatch interval.
+    @param block The block to run on the main queue.
+ */
+void OIDTraceDispatchToMainQueue(dispatch_block_t block);
+
+NS_ASSUME_NONNULL_END
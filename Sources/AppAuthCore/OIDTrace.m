@@ -0,0 +1,180 @@
+/*! @file OIDTrace.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDTrace.h"
+
+#import <os/log.h>
+#import <os/signpost.h>
+
+atomic_bool gOIDTraceEnabled = false;
+
+/*! @brief The observer of traced intervals. Guarded by @synchronized on @c OIDTrace.
+ */
+static id<OIDTraceObserver> gTraceObserver;
+
+/*! @brief Whether signposts are emitted for traced intervals.
+ */
+static BOOL gTraceSignpostsEnabled;
+
+/*! @brief Source of interval identifiers when signposts are unavailable or disabled.
+ */
+static _Atomic uint64_t gTraceNextIdentifier = 1;
+
+/*! @brief Returns the log which signposts are emitted to.
+ */
+static os_log_t OIDTraceSignpostLog(void) API_AVAILABLE(ios(12.0), macos(10.14), tvos(12.0),
+                                                          watchos(5.0)) {
+  static os_log_t log;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    log = os_log_create("org.openid.appauth", "Tracing");
+  });
+  return log;
+}
+
+/*! @brief Emits the signpost beginning or ending an interval. The names passed to the signpost
+        macros must be string literals, hence one case per phase.
+ */
+static void OIDTraceEmitSignpost(OIDTracePhase phase, os_signpost_id_t signpostID, BOOL begin)
+    API_AVAILABLE(ios(12.0), macos(10.14), tvos(12.0), watchos(5.0)) {
+  os_log_t log = OIDTraceSignpostLog();
+#define OID_TRACE_SIGNPOST_CASE(tracePhase, name) \
+  case tracePhase: \
+    if (begin) { \
+      os_signpost_interval_begin(log, signpostID, name); \
+    } else { \
+      os_signpost_interval_end(log, signpostID, name); \
+    } \
+    break;
+
+  switch (phase) {
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseDiscoveryFetch, "DiscoveryFetch")
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseTokenRequestBuild, "TokenRequestBuild")
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseNetworkWait, "NetworkWait")
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseJSONParse, "JSONParse")
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseFieldMapping, "FieldMapping")
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseIDTokenValidation, "IDTokenValidation")
+    OID_TRACE_SIGNPOST_CASE(OIDTracePhaseCallbackDispatch, "CallbackDispatch")
+  }
+#undef OID_TRACE_SIGNPOST_CASE
+}
+
+uint64_t OIDTraceBeginPhaseSlow(OIDTracePhase phase) {
+  id<OIDTraceObserver> observer;
+  BOOL signpostsEnabled;
+  @synchronized([OIDTrace class]) {
+    observer = gTraceObserver;
+    signpostsEnabled = gTraceSignpostsEnabled;
+  }
+
+  uint64_t identifier = 0;
+  if (signpostsEnabled) {
+    if (@available(iOS 12.0, macOS 10.14, tvOS 12.0, watchOS 5.0, *)) {
+      os_signpost_id_t signpostID = os_signpost_id_generate(OIDTraceSignpostLog());
+      OIDTraceEmitSignpost(phase, signpostID, YES);
+      identifier = signpostID;
+    }
+  }
+  if (!identifier) {
+    identifier = atomic_fetch_add(&gTraceNextIdentifier, 1);
+  }
+  [observer tracePhase:phase didBeginWithIdentifier:identifier];
+  return identifier;
+}
+
+void OIDTraceEndPhaseSlow(OIDTracePhase phase, uint64_t identifier) {
+  id<OIDTraceObserver> observer;
+  BOOL signpostsEnabled;
+  @synchronized([OIDTrace class]) {
+    observer = gTraceObserver;
+    signpostsEnabled = gTraceSignpostsEnabled;
+  }
+
+  if (signpostsEnabled) {
+    if (@available(iOS 12.0, macOS 10.14, tvOS 12.0, watchOS 5.0, *)) {
+      OIDTraceEmitSignpost(phase, (os_signpost_id_t)identifier, NO);
+    }
+  }
+  [observer tracePhase:phase didEndWithIdentifier:identifier];
+}
+
+void OIDTraceDispatchToMainQueue(dispatch_block_t block) {
+  uint64_t identifier = OIDTraceBeginPhase(OIDTracePhaseCallbackDispatch);
+  if (!identifier) {
+    dispatch_async(dispatch_get_main_queue(), block);
+    return;
+  }
+  dispatch_async(dispatch_get_main_queue(), ^{
+    OIDTraceEndPhase(OIDTracePhaseCallbackDispatch, identifier);
+    block();
+  });
+}
+
+@implementation OIDTrace
+
++ (nullable id<OIDTraceObserver>)observer {
+  @synchronized([OIDTrace class]) {
+    return gTraceObserver;
+  }
+}
+
++ (void)setObserver:(nullable id<OIDTraceObserver>)observer {
+  @synchronized([OIDTrace class]) {
+    gTraceObserver = observer;
+    atomic_store_explicit(&gOIDTraceEnabled, gTraceObserver || gTraceSignpostsEnabled,
+                          memory_order_relaxed);
+  }
+}
+
++ (BOOL)signpostsEnabled {
+  @synchronized([OIDTrace class]) {
+    return gTraceSignpostsEnabled;
+  }
+}
+
++ (void)setSignpostsEnabled:(BOOL)enabled {
+  if (@available(iOS 12.0, macOS 10.14, tvOS 12.0, watchOS 5.0, *)) {
+    @synchronized([OIDTrace class]) {
+      gTraceSignpostsEnabled = enabled;
+      atomic_store_explicit(&gOIDTraceEnabled, gTraceObserver || gTraceSignpostsEnabled,
+                            memory_order_relaxed);
+    }
+  }
+}
+
++ (NSString *)nameForPhase:(OIDTracePhase)phase {
+  switch (phase) {
+    case OIDTracePhaseDiscoveryFetch:
+      return @"DiscoveryFetch";
+    case OIDTracePhaseTokenRequestBuild:
+      return @"TokenRequestBuild";
+    case OIDTracePhaseNetworkWait:
+      return @"NetworkWait";
+    case OIDTracePhaseJSONParse:
+      return @"JSONParse";
+    case OIDTracePhaseFieldMapping:
+      return @"FieldMapping";
+    case OIDTracePhaseIDTokenValidation:
+      return @"IDTokenValidation";
+    case OIDTracePhaseCallbackDispatch:
+      return @"CallbackDispatch";
+  }
+  return @"Unknown";
+}
+
+@end
@@ -21,6 +21,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class OIDAuthState;
+@class OIDNetworkTask;
 @class OIDTVAuthorizationRequest;
 @class OIDTVAuthorizationResponse;
 @class OIDTVServiceConfiguration;
@@ -72,10 +73,11 @@ typedef void (^OIDTVAuthorizationCancelBlock)(void);
     @param issuerURL The service provider's OpenID Connect issuer.
     @param completion A block which will be invoked when the authorization service configuration has
         been created, or when an error has occurred.
+    @return A handle with which the discovery can be cancelled.
     @see https://openid.net/specs/openid-connect-discovery-1_0.html
  */
-+ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
-                                   completion:(OIDTVDiscoveryCallback)completion;
++ (OIDNetworkTask *)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                               completion:(OIDTVDiscoveryCallback)completion;
 
 /*! @brief Convenience method for creating a TV authorization service configuration from an OpenID
         Connect compliant identity provider's discovery document. This method validates the presence
@@ -84,10 +86,11 @@ typedef void (^OIDTVAuthorizationCancelBlock)(void);
     @param discoveryURL The URL of the service provider's OpenID Connect discovery document.
     @param completion A block which will be invoked when the authorization service configuration has
         been created, or when an error has occurred.
+    @return A handle with which the discovery can be cancelled.
     @see https://openid.net/specs/openid-connect-discovery-1_0.html
  */
-+ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
-                                         completion:(OIDTVDiscoveryCallback)completion;
++ (OIDNetworkTask *)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                                     completion:(OIDTVDiscoveryCallback)completion;
 
 /*! @brief Starts a TV authorization flow with the given request and polls for a response.
     @param request The TV authorization request to initiate.
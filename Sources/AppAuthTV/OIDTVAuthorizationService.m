@@ -22,6 +22,7 @@
 #import "OIDAuthState.h"
 #import "OIDDefines.h"
 #import "OIDErrorUtilities.h"
+#import "OIDMetrics.h"
 #import "OIDServiceDiscovery.h"
 #import "OIDURLQueryComponent.h"
 #import "OIDURLSessionProvider.h"
@@ -50,19 +51,19 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
 
 #pragma mark OIDC Discovery
 
-+ (void)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
-                                   completion:(OIDTVDiscoveryCallback)completion {
++ (OIDNetworkTask *)discoverServiceConfigurationForIssuer:(NSURL *)issuerURL
+                                               completion:(OIDTVDiscoveryCallback)completion {
   NSURL *fullDiscoveryURL =
       [issuerURL URLByAppendingPathComponent:kOpenIDConfigurationWellKnownPath];
 
-  [[self class] discoverServiceConfigurationForDiscoveryURL:fullDiscoveryURL
-                                                 completion:completion];
+  return [[self class] discoverServiceConfigurationForDiscoveryURL:fullDiscoveryURL
+                                                        completion:completion];
 }
 
-+ (void)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
-                                         completion:(OIDTVDiscoveryCallback)completion {
++ (OIDNetworkTask *)discoverServiceConfigurationForDiscoveryURL:(NSURL *)discoveryURL
+                                                     completion:(OIDTVDiscoveryCallback)completion {
   // Call the corresponding discovery method in OIDAuthorizationService
-  [OIDAuthorizationService discoverServiceConfigurationForDiscoveryURL:discoveryURL
+  return [OIDAuthorizationService discoverServiceConfigurationForDiscoveryURL:discoveryURL
       completion:^(OIDServiceConfiguration * _Nullable configuration, NSError * _Nullable error) {
     if (configuration == nil) {
       completion(nil, error);
@@ -111,11 +112,23 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
 
   // Performs the initial authorization reqeust.
   NSURLRequest *URLRequest = [request URLRequest];
+  OIDMetricsRequest *metricsRequest =
+      [OIDMetricsRequest requestToEndpoint:OIDMetricsEndpointDeviceAuthorization
+                                URLRequest:URLRequest];
+  if (metricsRequest) {
+    OIDTVAuthorizationInitialization authorizationInitialization = initialization;
+    initialization = ^(OIDTVAuthorizationResponse *_Nullable response, NSError *_Nullable error) {
+      [metricsRequest didCompleteWithError:error];
+      authorizationInitialization(response, error);
+    };
+  }
+
   NSURLSession *session = [NSURLSession sharedSession];
   [[session dataTaskWithRequest:URLRequest
               completionHandler:^(NSData *_Nullable data,
                                   NSURLResponse *_Nullable response,
                                   NSError *_Nullable error) {
+    [metricsRequest didReceiveData:data];
     if (error) {
       // A network error or server error occurred.
       NSError *returnedError =
@@ -231,6 +244,9 @@ static NSString *const kOpenIDConfigurationWellKnownPath = @".well-known/openid-
 
         // Polls token endpoint.
         [OIDAuthorizationService performTokenRequest:pollRequest
+                       originalAuthorizationResponse:nil
+                                            priority:OIDTokenRequestPriorityBackground
+                                             timeout:0
                                             callback:^(OIDTokenResponse *_Nullable tokenResponse,
                                                        NSError *_Nullable tokenError) {
           if (!pollRunning) {
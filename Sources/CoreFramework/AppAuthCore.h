@@ -27,9 +27,14 @@ FOUNDATION_EXPORT const unsigned char AppAuthCoreVersionString[];
 #import <AppAuthCore/OIDAuthState.h>
 #import <AppAuthCore/OIDAuthStateChangeDelegate.h>
 #import <AppAuthCore/OIDAuthStateErrorDelegate.h>
+#import <AppAuthCore/OIDAuthStateRegistry.h>
+#import <AppAuthCore/OIDAuthStateSnapshot.h>
 #import <AppAuthCore/OIDAuthorizationRequest.h>
 #import <AppAuthCore/OIDAuthorizationResponse.h>
 #import <AppAuthCore/OIDAuthorizationService.h>
+#import <AppAuthCore/OIDAuthorizedURLSession.h>
+#import <AppAuthCore/OIDCircuitBreaker.h>
+#import <AppAuthCore/OIDClock.h>
 #import <AppAuthCore/OIDError.h>
 #import <AppAuthCore/OIDErrorUtilities.h>
 #import <AppAuthCore/OIDExternalUserAgent.h>
@@ -37,6 +42,11 @@ FOUNDATION_EXPORT const unsigned char AppAuthCoreVersionString[];
 #import <AppAuthCore/OIDExternalUserAgentSession.h>
 #import <AppAuthCore/OIDGrantTypes.h>
 #import <AppAuthCore/OIDIDToken.h>
+#import <AppAuthCore/OIDIDTokenSignatureVerifier.h>
+#import <AppAuthCore/OIDJWKSCache.h>
+#import <AppAuthCore/OIDMetrics.h>
+#import <AppAuthCore/OIDMetricsAggregator.h>
+#import <AppAuthCore/OIDNetworkTask.h>
 #import <AppAuthCore/OIDRegistrationRequest.h>
 #import <AppAuthCore/OIDRegistrationResponse.h>
 #import <AppAuthCore/OIDResponseTypes.h>
@@ -44,9 +54,15 @@ FOUNDATION_EXPORT const unsigned char AppAuthCoreVersionString[];
 #import <AppAuthCore/OIDScopeUtilities.h>
 #import <AppAuthCore/OIDServiceConfiguration.h>
 #import <AppAuthCore/OIDServiceDiscovery.h>
+#import <AppAuthCore/OIDSharedAuthStateCoordinator.h>
+#import <AppAuthCore/OIDSharedTokenCache.h>
+#import <AppAuthCore/OIDTokenBroker.h>
+#import <AppAuthCore/OIDTokenRefreshRetryPolicy.h>
 #import <AppAuthCore/OIDTokenRequest.h>
+#import <AppAuthCore/OIDTokenRequestScheduler.h>
 #import <AppAuthCore/OIDTokenResponse.h>
 #import <AppAuthCore/OIDTokenUtilities.h>
+#import <AppAuthCore/OIDTrace.h>
 #import <AppAuthCore/OIDURLSessionProvider.h>
 #import <AppAuthCore/OIDEndSessionRequest.h>
 #import <AppAuthCore/OIDEndSessionResponse.h>
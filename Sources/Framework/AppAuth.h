@@ -27,9 +27,14 @@ FOUNDATION_EXPORT const unsigned char AppAuthVersionString[];
 #import <AppAuth/OIDAuthState.h>
 #import <AppAuth/OIDAuthStateChangeDelegate.h>
 #import <AppAuth/OIDAuthStateErrorDelegate.h>
+#import <AppAuth/OIDAuthStateRegistry.h>
+#import <AppAuth/OIDAuthStateSnapshot.h>
 #import <AppAuth/OIDAuthorizationRequest.h>
 #import <AppAuth/OIDAuthorizationResponse.h>
 #import <AppAuth/OIDAuthorizationService.h>
+#import <AppAuth/OIDAuthorizedURLSession.h>
+#import <AppAuth/OIDCircuitBreaker.h>
+#import <AppAuth/OIDClock.h>
 #import <AppAuth/OIDError.h>
 #import <AppAuth/OIDErrorUtilities.h>
 #import <AppAuth/OIDExternalUserAgent.h>
@@ -37,6 +42,11 @@ FOUNDATION_EXPORT const unsigned char AppAuthVersionString[];
 #import <AppAuth/OIDExternalUserAgentSession.h>
 #import <AppAuth/OIDGrantTypes.h>
 #import <AppAuth/OIDIDToken.h>
+#import <AppAuth/OIDIDTokenSignatureVerifier.h>
+#import <AppAuth/OIDJWKSCache.h>
+#import <AppAuth/OIDMetrics.h>
+#import <AppAuth/OIDMetricsAggregator.h>
+#import <AppAuth/OIDNetworkTask.h>
 #import <AppAuth/OIDRegistrationRequest.h>
 #import <AppAuth/OIDRegistrationResponse.h>
 #import <AppAuth/OIDResponseTypes.h>
@@ -44,9 +54,15 @@ FOUNDATION_EXPORT const unsigned char AppAuthVersionString[];
 #import <AppAuth/OIDScopeUtilities.h>
 #import <AppAuth/OIDServiceConfiguration.h>
 #import <AppAuth/OIDServiceDiscovery.h>
+#import <AppAuth/OIDSharedAuthStateCoordinator.h>
+#import <AppAuth/OIDSharedTokenCache.h>
+#import <AppAuth/OIDTokenBroker.h>
+#import <AppAuth/OIDTokenRefreshRetryPolicy.h>
 #import <AppAuth/OIDTokenRequest.h>
+#import <AppAuth/OIDTokenRequestScheduler.h>
 #import <AppAuth/OIDTokenResponse.h>
 #import <AppAuth/OIDTokenUtilities.h>
+#import <AppAuth/OIDTrace.h>
 #import <AppAuth/OIDURLSessionProvider.h>
 #import <AppAuth/OIDEndSessionRequest.h>
 #import <AppAuth/OIDEndSessionResponse.h>
@@ -0,0 +1,168 @@
+/*! @file OIDAuthStateRegistryTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthStateRegistry.h"
+#import "Sources/AppAuthCore/OIDAuthStateSnapshot.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The number of accounts of the benchmark.
+ */
+static NSUInteger const kBenchmarkAccountCount = 10000;
+
+/*! @brief How long the token endpoint takes to respond, in seconds.
+ */
+static NSTimeInterval const kTokenEndpointLatency = 0.05;
+
+/*! @brief Unit tests for @c OIDAuthStateRegistry.
+ */
+@interface OIDAuthStateRegistryTests : XCTestCase
+@end
+
+@implementation OIDAuthStateRegistryTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+  [OIDMockOpenIDProvider setLatency:kTokenEndpointLatency];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+- (void)testLookupByAccountIDAndSubject {
+  OIDAuthStateRegistry *registry = [[OIDAuthStateRegistry alloc] init];
+  OIDAuthState *alice = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                           refreshToken:@"refresh_token"
+                                                              expiresIn:3600
+                                                                subject:@"alice"];
+  OIDAuthState *bob = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                         refreshToken:@"refresh_token"
+                                                            expiresIn:3600
+                                                              subject:@"bob"];
+  [registry setAuthState:alice forAccountID:@"account1"];
+  [registry setAuthState:bob forAccountID:@"account2"];
+  XCTAssertEqual(registry.count, 2);
+  XCTAssertEqual([registry authStateForAccountID:@"account1"], alice);
+  XCTAssertEqualObjects([registry accountIDsForSubject:@"bob"], @[ @"account2" ]);
+
+  // replacing an account updates the subject index
+  [registry setAuthState:alice forAccountID:@"account2"];
+  XCTAssertEqualObjects([registry accountIDsForSubject:@"bob"], @[]);
+  NSSet *aliceAccounts = [NSSet setWithArray:[registry accountIDsForSubject:@"alice"]];
+  XCTAssertEqualObjects(aliceAccounts, ([NSSet setWithObjects:@"account1", @"account2", nil]));
+
+  [registry removeAuthStateForAccountID:@"account1"];
+  XCTAssertNil([registry authStateForAccountID:@"account1"]);
+  XCTAssertEqualObjects([registry accountIDsForSubject:@"alice"], @[ @"account2" ]);
+}
+
+- (void)testAccountsOfSameIssuerShareConfiguration {
+  OIDAuthState *alice = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                           refreshToken:@"refresh_token"
+                                                              expiresIn:3600
+                                                                subject:@"alice"];
+  OIDAuthState *bob = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                         refreshToken:@"refresh_token"
+                                                            expiresIn:3600
+                                                              subject:@"bob"];
+  OIDAuthStateRegistry *registry = [[OIDAuthStateRegistry alloc] init];
+  [registry setAuthState:alice forAccountID:@"alice"];
+  [registry setAuthState:bob forAccountID:@"bob"];
+  XCTAssertNotNil([registry configurationForAccountID:@"bob"]);
+  XCTAssertEqual([registry configurationForAccountID:@"alice"],
+                 [registry configurationForAccountID:@"bob"]);
+}
+
+- (void)testRefreshRespectsPerIssuerConcurrencyLimit {
+  OIDAuthStateRegistry *registry =
+      [[OIDAuthStateRegistry alloc] initWithMaximumConcurrentRefreshesPerIssuer:2];
+  for (NSUInteger i = 0; i < 5; i++) {
+    NSString *accountID = [NSString stringWithFormat:@"expiring%lu", (unsigned long)i];
+    OIDAuthState *expiring = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                                refreshToken:@"refresh_token"
+                                                                   expiresIn:30
+                                                                     subject:accountID];
+    [registry setAuthState:expiring forAccountID:accountID];
+  }
+  OIDAuthState *fresh = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                           refreshToken:@"refresh_token"
+                                                              expiresIn:3600
+                                                                subject:@"fresh"];
+  [registry setAuthState:fresh forAccountID:@"fresh"];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Refreshes complete."];
+  [registry refreshAuthStatesExpiringWithin:300
+                                 completion:^(NSDictionary<NSString *, NSError *> *errors) {
+    XCTAssertTrue([NSThread isMainThread]);
+    XCTAssertEqual(errors.count, 0);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 5);
+  XCTAssertLessThanOrEqual([OIDMockOpenIDProvider maximumConcurrentRequestCount], 2);
+  NSString *refreshedAccessToken =
+      [registry authStateForAccountID:@"expiring0"].snapshot.accessToken;
+  XCTAssertTrue([refreshedAccessToken hasPrefix:@"access_token_"], @"%@", refreshedAccessToken);
+  XCTAssertEqualObjects(fresh.snapshot.accessToken, @"access_token");
+}
+
+- (void)testRegistryWith10000AccountsPerformance {
+  NSMutableArray<OIDAuthState *> *authStates = [NSMutableArray array];
+  NSMutableArray<NSString *> *accountIDs = [NSMutableArray array];
+  for (NSUInteger i = 0; i < kBenchmarkAccountCount; i++) {
+    NSString *accountID = [NSString stringWithFormat:@"account%lu", (unsigned long)i];
+    [accountIDs addObject:accountID];
+    [authStates addObject:[OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                             refreshToken:@"refresh_token"
+                                                                expiresIn:3600
+                                                                  subject:accountID]];
+  }
+  [self measureBlock:^{
+    @autoreleasepool {
+      OIDAuthStateRegistry *registry = [[OIDAuthStateRegistry alloc] init];
+      for (NSUInteger i = 0; i < kBenchmarkAccountCount; i++) {
+        [registry setAuthState:authStates[i] forAccountID:accountIDs[i]];
+      }
+      for (NSString *accountID in accountIDs) {
+        XCTAssertNotNil([registry authStateForAccountID:accountID]);
+        XCTAssertEqual([registry accountIDsForSubject:accountID].count, 1);
+      }
+      XCTAssertEqual(registry.count, kBenchmarkAccountCount);
+    }
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
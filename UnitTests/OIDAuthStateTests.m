@@ -20,15 +20,22 @@
 
 #import "OIDAuthorizationResponseTests.h"
 #import "OIDRegistrationResponseTests.h"
+#import "OIDServiceDiscoveryTests.h"
 #import "OIDTokenResponseTests.h"
 
 #if SWIFT_PACKAGE
 @import AppAuthCore;
 #else
 #import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthStateSnapshot.h"
+#import "Sources/AppAuthCore/OIDAuthorizationRequest.h"
 #import "Sources/AppAuthCore/OIDAuthorizationResponse.h"
+#import "Sources/AppAuthCore/OIDClock.h"
+#import "Sources/AppAuthCore/OIDError.h"
 #import "Sources/AppAuthCore/OIDErrorUtilities.h"
 #import "Sources/AppAuthCore/OIDRegistrationResponse.h"
+#import "Sources/AppAuthCore/OIDServiceConfiguration.h"
+#import "Sources/AppAuthCore/OIDServiceDiscovery.h"
 #import "Sources/AppAuthCore/OIDTokenResponse.h"
 #endif
 
@@ -126,6 +133,7 @@
   _didChangeStateExpectation = nil;
   _didEncounterAuthorizationErrorExpectation = nil;
   _didEncounterTransientErrorExpectation = nil;
+  [OIDClock setSharedClock:nil];
 
   [super tearDown];
 }
@@ -457,6 +465,24 @@
   XCTAssertEqual([authState isTokenFresh], NO, @"");
 }
 
+- (void)testIsTokenFreshUsesSharedClock {
+  __block NSDate *now = [NSDate dateWithTimeIntervalSince1970:0];
+  OIDClock *clock = [[OIDClock alloc] init];
+  clock.currentDate = ^{
+    return now;
+  };
+  clock.accessTokenRefreshTolerance = 30;
+  [OIDClock setSharedClock:clock];
+
+  // The access token of the test instance expires in 60 seconds.
+  OIDAuthState *authState = [[self class] testInstance];
+  XCTAssertEqualObjects(authState.accessTokenExpirationDate, [now dateByAddingTimeInterval:60]);
+  XCTAssertEqual([authState isTokenFresh], YES, @"");
+
+  now = [now dateByAddingTimeInterval:31];
+  XCTAssertEqual([authState isTokenFresh], NO, @"");
+}
+
 - (void)testIsTokenFreshRespectsTokenRefreshOverride {
   OIDAuthState *authState = [[self class] testInstance];
   [authState setNeedsTokenRefresh];
@@ -477,6 +503,217 @@
   XCTAssertEqual([authState isTokenFresh], YES, @"");
 }
 
+/*! @brief Returns a token response whose access token, refresh token and scope all end with the
+        same suffix.
+ */
++ (OIDTokenResponse *)tokenResponseWithSuffix:(NSUInteger)suffix {
+  NSString *suffixString = [NSString stringWithFormat:@"%lu", (unsigned long)suffix];
+  return [[OIDTokenResponse alloc]
+      initWithRequest:[OIDTokenRequestTests testInstance]
+           parameters:@{
+             @"access_token" : [@"access_token_" stringByAppendingString:suffixString],
+             @"refresh_token" : [@"refresh_token_" stringByAppendingString:suffixString],
+             @"scope" : [@"scope_" stringByAppendingString:suffixString],
+             @"expires_in" : @3600,
+           }];
+}
+
+- (void)testSetNeedsTokenRefreshPublishesNewSnapshot {
+  OIDAuthState *authState = [[self class] testInstance];
+  OIDAuthStateSnapshot *snapshot = authState.snapshot;
+  [authState setNeedsTokenRefresh];
+  XCTAssertFalse(snapshot.needsTokenRefresh);
+  XCTAssertTrue(authState.snapshot.needsTokenRefresh);
+  XCTAssertEqualObjects(authState.snapshot.accessToken, snapshot.accessToken);
+}
+
+/*! @brief Stress test in which readers on several threads check that every snapshot they observe
+        holds the values of a single update, while another thread keeps updating the state. Run
+        with the Thread Sanitizer enabled to also check for data races.
+ */
+- (void)testConcurrentReadersObserveConsistentSnapshots {
+  static NSUInteger const kResponseCount = 64;
+  static NSUInteger const kIterations = 20000;
+  static size_t const kThreadCount = 8;
+  NSMutableArray<OIDTokenResponse *> *tokenResponses = [NSMutableArray array];
+  for (NSUInteger i = 0; i < kResponseCount; i++) {
+    [tokenResponses addObject:[[self class] tokenResponseWithSuffix:i]];
+  }
+  OIDAuthState *authState = [[self class] testInstance];
+  [authState updateWithTokenResponse:tokenResponses[0] error:nil];
+
+  __block NSUInteger inconsistentSnapshots = 0;
+  NSObject *lock = [[NSObject alloc] init];
+  dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+  dispatch_apply(kThreadCount, queue, ^(size_t thread) {
+    for (NSUInteger i = 0; i < kIterations; i++) {
+      if (thread == 0) {
+        [authState updateWithTokenResponse:tokenResponses[i % kResponseCount] error:nil];
+        if (i % 16 == 0) {
+          [authState setNeedsTokenRefresh];
+        }
+        continue;
+      }
+      OIDAuthStateSnapshot *snapshot = authState.snapshot;
+      NSString *suffix = [snapshot.accessToken componentsSeparatedByString:@"_"].lastObject;
+      BOOL consistent =
+          [snapshot.refreshToken isEqualToString:[@"refresh_token_" stringByAppendingString:suffix]]
+          && [snapshot.scope isEqualToString:[@"scope_" stringByAppendingString:suffix]]
+          && snapshot.lastTokenResponse.accessToken == snapshot.accessToken;
+      // Also exercises the getters which read the current snapshot.
+      (void)authState.refreshToken;
+      (void)[authState freshAccessToken];
+      if (!consistent) {
+        @synchronized(lock) {
+          inconsistentSnapshots++;
+        }
+      }
+    }
+  });
+  XCTAssertEqual(inconsistentSnapshots, 0);
+}
+
+/*! @brief Decodes 1,000 archived authorization states of the same issuer, reporting the memory
+        and time it takes. Their configurations and discovery documents are interned, so all the
+        decoded states share one instance of each.
+ */
+- (void)testDecoding1000ArchivedAuthStatesPerformance {
+  if (@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)) {
+    NSDictionary *dictionary = [OIDServiceDiscoveryTests completeServiceDiscoveryDictionary];
+    OIDServiceDiscovery *discoveryDocument =
+        [[OIDServiceDiscovery alloc] initWithDictionary:dictionary error:NULL];
+    OIDServiceConfiguration *configuration =
+        [[OIDServiceConfiguration alloc] initWithDiscoveryDocument:discoveryDocument];
+    OIDAuthorizationRequest *request =
+        [[OIDAuthorizationRequest alloc] initWithConfiguration:configuration
+                                                      clientId:@"client"
+                                                        scopes:@[ @"openid" ]
+                                                   redirectURL:[NSURL URLWithString:@"app:/cb"]
+                                                  responseType:OIDResponseTypeCode
+                                          additionalParameters:nil];
+    NSMutableArray<NSData *> *archives = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+      NSString *code = [NSString stringWithFormat:@"code%lu", (unsigned long)i];
+      OIDAuthorizationResponse *response =
+          [[OIDAuthorizationResponse alloc] initWithRequest:request parameters:@{ @"code" : code }];
+      OIDAuthState *authState = [[OIDAuthState alloc] initWithAuthorizationResponse:response];
+      [archives addObject:[NSKeyedArchiver archivedDataWithRootObject:authState
+                                                requiringSecureCoding:YES
+                                                                error:NULL]];
+    }
+
+    __block NSArray<OIDAuthState *> *authStates;
+    NSArray<id<XCTMetric>> *metrics =
+        @[ [[XCTMemoryMetric alloc] init], [[XCTClockMetric alloc] init] ];
+    [self measureWithMetrics:metrics block:^{
+      NSMutableArray<OIDAuthState *> *decoded = [NSMutableArray array];
+      for (NSData *data in archives) {
+        OIDAuthState *authState = [NSKeyedUnarchiver unarchivedObjectOfClass:[OIDAuthState class]
+                                                                    fromData:data
+                                                                       error:NULL];
+        [decoded addObject:authState];
+      }
+      authStates = decoded;
+    }];
+
+    XCTAssertEqual(authStates.count, 1000);
+    NSHashTable *configurations =
+        [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (OIDAuthState *authState in authStates) {
+      [configurations addObject:authState.lastAuthorizationResponse.request.configuration];
+    }
+    XCTAssertEqual(configurations.count, 1);
+    XCTAssertEqual(configurations.anyObject, configuration);
+  }
+}
+
+/*! @brief Returns archives of @c count auth states, keyed by account, whose refresh tokens end
+        with the account's index.
+ */
++ (NSDictionary<NSString *, NSData *> *)archivedAuthStatesWithCount:(NSUInteger)count
+    API_AVAILABLE(ios(12.0), macos(10.13), tvos(11.0), watchos(4.0)) {
+  NSMutableDictionary<NSString *, NSData *> *archives = [NSMutableDictionary dictionary];
+  for (NSUInteger i = 0; i < count; i++) {
+    OIDAuthState *authState = [[OIDAuthState alloc]
+        initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstance]
+                        tokenResponse:[self tokenResponseWithSuffix:i]];
+    NSString *key = [NSString stringWithFormat:@"account%lu", (unsigned long)i];
+    archives[key] = [NSKeyedArchiver archivedDataWithRootObject:authState
+                                          requiringSecureCoding:YES
+                                                          error:NULL];
+  }
+  return archives;
+}
+
+- (void)testDecodeAuthStatesFromArchivedData {
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    NSMutableDictionary<NSString *, NSData *> *archives =
+        [[[self class] archivedAuthStatesWithCount:3] mutableCopy];
+    archives[@"corrupt"] = [@"not an archive" dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSMutableSet<NSString *> *decodedKeys = [NSMutableSet set];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Decoded auth states"];
+    [OIDAuthState decodeAuthStatesFromArchivedData:archives
+                                maximumConcurrency:2
+                                    decodedHandler:^(NSString *key, OIDAuthState *authState) {
+      @synchronized(decodedKeys) {
+        [decodedKeys addObject:key];
+      }
+    } completion:^(NSDictionary<NSString *, OIDAuthState *> *authStates,
+                   NSDictionary<NSString *, NSError *> *errors) {
+      XCTAssertTrue([NSThread isMainThread]);
+      XCTAssertEqual(authStates.count, 3);
+      for (NSUInteger i = 0; i < 3; i++) {
+        NSString *key = [NSString stringWithFormat:@"account%lu", (unsigned long)i];
+        NSString *refreshToken = [NSString stringWithFormat:@"refresh_token_%lu", (unsigned long)i];
+        XCTAssertEqualObjects(authStates[key].refreshToken, refreshToken);
+        XCTAssertNotNil([authStates[key] freshAccessToken]);
+      }
+      XCTAssertEqual(errors.count, 1);
+      XCTAssertEqualObjects(errors[@"corrupt"].domain, OIDGeneralErrorDomain);
+      XCTAssertEqual(errors[@"corrupt"].code, OIDErrorCodeAuthStateDecodingError);
+      @synchronized(decodedKeys) {
+        XCTAssertEqualObjects(decodedKeys, [NSSet setWithArray:authStates.allKeys]);
+      }
+      [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+  }
+}
+
+/*! @brief Measures the time from starting to bulk decode 1,000 archived auth states until the
+        first of them has a usable access token.
+ */
+- (void)testTimeToFirstUsableTokenFrom1000ArchivedAuthStatesPerformance {
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    NSDictionary<NSString *, NSData *> *archives =
+        [[self class] archivedAuthStatesWithCount:1000];
+
+    [self measureMetrics:@[ XCTPerformanceMetric_WallClockTime ]
+        automaticallyStartMeasuring:NO
+                           forBlock:^{
+      dispatch_semaphore_t usableToken = dispatch_semaphore_create(0);
+      XCTestExpectation *expectation = [self expectationWithDescription:@"Decoded auth states"];
+      [self startMeasuring];
+      [OIDAuthState decodeAuthStatesFromArchivedData:archives
+                                  maximumConcurrency:0
+                                      decodedHandler:^(NSString *key, OIDAuthState *authState) {
+        if ([authState freshAccessToken]) {
+          dispatch_semaphore_signal(usableToken);
+        }
+      } completion:^(NSDictionary<NSString *, OIDAuthState *> *authStates,
+                     NSDictionary<NSString *, NSError *> *errors) {
+        XCTAssertEqual(authStates.count, 1000);
+        XCTAssertEqual(errors.count, 0);
+        [expectation fulfill];
+      }];
+      dispatch_semaphore_wait(usableToken, DISPATCH_TIME_FOREVER);
+      [self stopMeasuring];
+      [self waitForExpectationsWithTimeout:30 handler:nil];
+    }];
+  }
+}
+
 - (void)testThatRefreshTokenExceptionWillBeRaisedForTokenRequestWithAdditionalParameters {
   OIDAuthState *authState = [[OIDAuthState alloc] initWithAuthorizationResponse:nil tokenResponse:nil registrationResponse:nil];
   XCTAssertThrowsSpecificNamed([authState tokenRefreshRequestWithAdditionalParameters:nil],
@@ -0,0 +1,323 @@
+/*! @file OIDAuthorizationFlowPerformanceTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <time.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "OIDMockOpenIDProvider.h"
+#import "OIDServiceConfigurationTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthorizationRequest.h"
+#import "Sources/AppAuthCore/OIDAuthorizationResponse.h"
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDExternalUserAgent.h"
+#import "Sources/AppAuthCore/OIDExternalUserAgentSession.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#import "Sources/AppAuthCore/OIDTokenUtilities.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Environment variable naming the file the per-phase results are written to as JSON.
+    @discussion When unset, results are only reported through XCTest's own measurements.
+ */
+static NSString *const kBenchmarkReportPathEnvironmentKey = @"OID_BENCHMARK_REPORT_PATH";
+
+/*! @brief Number of operations timed individually for each phase.
+ */
+static NSUInteger const kBenchmarkIterations = 500;
+
+/*! @brief Per-phase results collected while the suite runs, keyed by phase name.
+ */
+static NSMutableDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *gBenchmarkResults;
+
+/*! @brief An external user agent which presents nothing, so that the redirect can be handed to the
+        session directly.
+ */
+@interface OIDAuthorizationFlowPerformanceTestsUserAgent : NSObject <OIDExternalUserAgent>
+@end
+
+@implementation OIDAuthorizationFlowPerformanceTestsUserAgent
+
+- (BOOL)presentExternalUserAgentRequest:(id<OIDExternalUserAgentRequest>)request
+                                session:(id<OIDExternalUserAgentSession>)session {
+  return YES;
+}
+
+- (void)dismissExternalUserAgentAnimated:(BOOL)animated completion:(void (^)(void))completion {
+  if (completion) {
+    completion();
+  }
+}
+
+@end
+
+/*! @brief Measures each phase of the authorization code flow against an in-process token endpoint.
+    @discussion Each phase is measured with XCTest, for baselines in Xcode, and also timed one
+        operation at a time. When @c OID_BENCHMARK_REPORT_PATH is set, the mean and percentile
+        nanoseconds per operation of every phase are written to that path as JSON, to be tracked
+        across releases. Memory use is reported by XCTest's memory metric where it is available.
+ */
+@interface OIDAuthorizationFlowPerformanceTests : XCTestCase
+@end
+
+@implementation OIDAuthorizationFlowPerformanceTests
+
++ (void)setUp {
+  [super setUp];
+  gBenchmarkResults = [NSMutableDictionary dictionary];
+}
+
++ (void)tearDown {
+  NSDictionary<NSString *, NSString *> *environment = [NSProcessInfo processInfo].environment;
+  NSString *reportPath = environment[kBenchmarkReportPathEnvironmentKey];
+  if (reportPath.length) {
+    NSDictionary *report = @{ @"unit" : @"ns/op", @"phases" : gBenchmarkResults };
+    NSData *data = [NSJSONSerialization dataWithJSONObject:report
+                                                   options:NSJSONWritingPrettyPrinted
+                                                     error:NULL];
+    [data writeToFile:reportPath atomically:YES];
+  }
+  gBenchmarkResults = nil;
+  [super tearDown];
+}
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Times @c kBenchmarkIterations operations of a phase one by one, records the mean and
+        percentiles, then measures the phase with XCTest.
+    @param phase The name of the phase in the report.
+    @param block Performs one operation of the phase.
+ */
+- (void)measurePhase:(NSString *)phase block:(void (^)(NSUInteger iteration))block {
+  NSMutableArray<NSNumber *> *samples = [NSMutableArray arrayWithCapacity:kBenchmarkIterations];
+  uint64_t total = 0;
+  for (NSUInteger i = 0; i < kBenchmarkIterations; i++) {
+    @autoreleasepool {
+      uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+      block(i);
+      uint64_t duration = clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start;
+      total += duration;
+      [samples addObject:@(duration)];
+    }
+  }
+  [samples sortUsingSelector:@selector(compare:)];
+  NSNumber *(^percentile)(double) = ^(double p) {
+    NSUInteger index = MIN((NSUInteger)(p * samples.count), samples.count - 1);
+    return samples[index];
+  };
+  gBenchmarkResults[phase] = @{
+    @"iterations" : @(kBenchmarkIterations),
+    @"mean" : @(total / kBenchmarkIterations),
+    @"p50" : percentile(0.50),
+    @"p90" : percentile(0.90),
+    @"p99" : percentile(0.99),
+  };
+
+  void (^measuredBlock)(void) = ^{
+    for (NSUInteger i = 0; i < kBenchmarkIterations; i++) {
+      @autoreleasepool {
+        block(i);
+      }
+    }
+  };
+  if (@available(iOS 13.0, macOS 10.15, tvOS 13.0, *)) {
+    [self measureWithMetrics:@[ [[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init] ]
+                       block:measuredBlock];
+  } else {
+    [self measureBlock:measuredBlock];
+  }
+}
+
+/*! @brief Builds a token endpoint response with a valid ID Token for the given authorization
+        response.
+ */
++ (NSDictionary *)tokenResponseForAuthorizationResponse:(OIDAuthorizationResponse *)response {
+  long long now = (long long)[[NSDate date] timeIntervalSince1970];
+  NSMutableDictionary *claims = [NSMutableDictionary dictionary];
+  claims[@"iss"] = @"https://www.example.com";
+  claims[@"sub"] = @"subject";
+  claims[@"aud"] = response.request.clientID;
+  claims[@"exp"] = @(now + 3600);
+  claims[@"iat"] = @(now);
+  claims[@"nonce"] = response.request.nonce;
+  NSData *header = [NSJSONSerialization dataWithJSONObject:@{ @"alg" : @"none" }
+                                                   options:0
+                                                     error:NULL];
+  NSData *payload = [NSJSONSerialization dataWithJSONObject:claims options:0 error:NULL];
+  NSString *idToken =
+      [NSString stringWithFormat:@"%@.%@.",
+                                 [OIDTokenUtilities encodeBase64urlNoPadding:header],
+                                 [OIDTokenUtilities encodeBase64urlNoPadding:payload]];
+  return @{
+    @"access_token" : @"access_token",
+    @"token_type" : @"Bearer",
+    @"expires_in" : @3600,
+    @"refresh_token" : @"refresh_token",
+    @"id_token" : idToken,
+  };
+}
+
+/*! @brief Measures creating authorization requests, including PKCE, state and nonce generation.
+ */
+- (void)testRequestConstructionPerformance {
+  OIDServiceConfiguration *configuration = [OIDServiceConfigurationTests testInstance];
+  NSURL *redirectURL = [NSURL URLWithString:@"com.example.app:/oauth2redirect"];
+  [self measurePhase:@"request_construction" block:^(NSUInteger iteration) {
+    OIDAuthorizationRequest *request =
+        [[OIDAuthorizationRequest alloc] initWithConfiguration:configuration
+                                                      clientId:@"client"
+                                                        scopes:@[ @"openid", @"profile" ]
+                                                   redirectURL:redirectURL
+                                                  responseType:OIDResponseTypeCode
+                                          additionalParameters:nil];
+    XCTAssertNotNil([request authorizationRequestURL]);
+  }];
+}
+
+/*! @brief Measures handling the authorization redirect in
+        @c OIDExternalUserAgentSession.resumeExternalUserAgentFlowWithURL:error:.
+ */
+- (void)testRedirectParsingPerformance {
+  OIDServiceConfiguration *configuration = [OIDServiceConfigurationTests testInstance];
+  NSURL *redirectURL = [NSURL URLWithString:@"com.example.app:/oauth2redirect"];
+  OIDAuthorizationFlowPerformanceTestsUserAgent *userAgent =
+      [[OIDAuthorizationFlowPerformanceTestsUserAgent alloc] init];
+  __block NSUInteger callbacks = 0;
+  [self measurePhase:@"redirect_parsing" block:^(NSUInteger iteration) {
+    OIDAuthorizationRequest *request =
+        [[OIDAuthorizationRequest alloc] initWithConfiguration:configuration
+                                                      clientId:@"client"
+                                                        scopes:@[ @"openid" ]
+                                                   redirectURL:redirectURL
+                                                  responseType:OIDResponseTypeCode
+                                          additionalParameters:nil];
+    id<OIDExternalUserAgentSession> session =
+        [OIDAuthorizationService presentAuthorizationRequest:request
+                                           externalUserAgent:userAgent
+                                                    callback:^(OIDAuthorizationResponse *response,
+                                                               NSError *error) {
+      callbacks++;
+    }];
+    NSString *redirect =
+        [NSString stringWithFormat:@"com.example.app:/oauth2redirect?code=code&state=%@",
+                                   request.state];
+    XCTAssertTrue([session resumeExternalUserAgentFlowWithURL:[NSURL URLWithString:redirect]
+                                                        error:NULL]);
+  }];
+
+  // Lets the callbacks, which are dispatched to the main queue, run before the test ends.
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+  XCTAssertGreaterThan(callbacks, 0);
+}
+
+/*! @brief Measures building the token exchange @c NSURLRequest from an authorization response.
+ */
+- (void)testTokenRequestBuildingPerformance {
+  OIDAuthorizationResponse *authorizationResponse =
+      [OIDAuthorizationResponseTests testInstanceCodeFlowClientAuth];
+  [self measurePhase:@"token_request_building" block:^(NSUInteger iteration) {
+    OIDTokenRequest *tokenRequest = [authorizationResponse tokenExchangeRequest];
+    XCTAssertNotNil([tokenRequest URLRequest]);
+  }];
+}
+
+/*! @brief Measures the token exchange through the in-process transport, including response parsing
+        and ID Token validation in
+        @c OIDAuthorizationService.performTokenRequest:originalAuthorizationResponse:callback:.
+ */
+- (void)testTokenExchangePerformance {
+  OIDAuthorizationResponse *authorizationResponse =
+      [OIDAuthorizationResponseTests testInstanceCodeFlow];
+  // Answers every exchange of the same code, which the mock provider would only accept once.
+  NSDictionary *tokenResponse =
+      [[self class] tokenResponseForAuthorizationResponse:authorizationResponse];
+  [OIDMockOpenIDProvider setResponseWithStatusCode:200
+                                           headers:nil
+                                              JSON:tokenResponse
+                                           forPath:OIDMockOpenIDProviderTokenPath];
+  OIDTokenRequest *tokenRequest = [authorizationResponse tokenExchangeRequest];
+
+  [self measurePhase:@"token_exchange" block:^(NSUInteger iteration) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Token exchange."];
+    [OIDAuthorizationService performTokenRequest:tokenRequest
+                   originalAuthorizationResponse:authorizationResponse
+                                        callback:^(OIDTokenResponse *tokenResponse,
+                                                   NSError *error) {
+      XCTAssertNotNil(tokenResponse);
+      XCTAssertNil(error);
+      [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+  }];
+}
+
+/*! @brief Measures updating an @c OIDAuthState with a token response and archiving it.
+ */
+- (void)testAuthStateUpdateAndArchivalPerformance {
+  OIDAuthorizationResponse *authorizationResponse =
+      [OIDAuthorizationResponseTests testInstanceCodeFlow];
+  OIDTokenResponse *tokenResponse =
+      [[OIDTokenResponse alloc] initWithRequest:[authorizationResponse tokenExchangeRequest]
+                                     parameters:@{
+                                       @"access_token" : @"access_token",
+                                       @"token_type" : @"Bearer",
+                                       @"expires_in" : @3600,
+                                       @"refresh_token" : @"refresh_token",
+                                     }];
+  OIDAuthState *authState =
+      [[OIDAuthState alloc] initWithAuthorizationResponse:authorizationResponse
+                                            tokenResponse:tokenResponse];
+
+  [self measurePhase:@"auth_state_update_archival" block:^(NSUInteger iteration) {
+    [authState updateWithTokenResponse:tokenResponse error:nil];
+    NSData *data;
+    if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+      data = [NSKeyedArchiver archivedDataWithRootObject:authState
+                                   requiringSecureCoding:YES
+                                                   error:NULL];
+    } else {
+#if !TARGET_OS_IOS
+      data = [NSKeyedArchiver archivedDataWithRootObject:authState];
+#endif
+    }
+    XCTAssertNotNil(data);
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
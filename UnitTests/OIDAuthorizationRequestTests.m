@@ -26,6 +26,7 @@
 #import "Sources/AppAuthCore/OIDAuthorizationRequest.h"
 #import "Sources/AppAuthCore/OIDScopeUtilities.h"
 #import "Sources/AppAuthCore/OIDServiceConfiguration.h"
+#import "Sources/AppAuthCore/OIDURLQueryComponent.h"
 #endif
 
 // Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
@@ -475,6 +476,39 @@ static int const kCodeVerifierRecommendedLength = 43;
                  @"The spec RECOMMENDS a '43-octet URL safe string'");
 }
 
+/*! @brief Tests that requests created after @c OIDAuthorizationRequest.pregenerateParameters get
+        unique values, and that each code challenge matches its code verifier.
+ */
+- (void)testPregeneratedParameters {
+  [OIDAuthorizationRequest pregenerateParameters];
+
+  OIDServiceConfiguration *configuration = [OIDServiceConfigurationTests testInstance];
+  NSMutableSet<NSString *> *seenValues = [NSMutableSet set];
+  for (int i = 0; i < 20; i++) {
+    OIDAuthorizationRequest *request =
+        [[OIDAuthorizationRequest alloc] initWithConfiguration:configuration
+                                                      clientId:kTestClientID
+                                                        scopes:@[ kTestScope ]
+                                                   redirectURL:[NSURL URLWithString:kTestRedirectURL]
+                                                  responseType:OIDResponseTypeCode
+                                          additionalParameters:nil];
+    XCTAssertNotNil(request.state);
+    XCTAssertNotNil(request.nonce);
+    XCTAssertNotNil(request.codeVerifier);
+    XCTAssertEqualObjects(request.codeChallenge,
+                          [OIDAuthorizationRequest codeChallengeS256ForVerifier:request.codeVerifier]);
+    XCTAssertEqualObjects(request.codeChallengeMethod,
+                          OIDOAuthorizationRequestCodeChallengeMethodS256);
+
+    XCTAssertFalse([seenValues containsObject:request.state]);
+    XCTAssertFalse([seenValues containsObject:request.nonce]);
+    XCTAssertFalse([seenValues containsObject:request.codeVerifier]);
+    [seenValues addObject:request.state];
+    [seenValues addObject:request.nonce];
+    [seenValues addObject:request.codeVerifier];
+  }
+}
+
 - (void)testSupportedResponseTypes {
   NSDictionary *additionalParameters =
       @{ kTestAdditionalParameterKey : kTestAdditionalParameterValue };
@@ -560,6 +594,72 @@ static int const kCodeVerifierRecommendedLength = 43;
 
 }
 
+/*! @brief Tests that requests sharing the same static parameters each get a complete authorization
+        URL containing their own state, nonce and code challenge.
+ */
+- (void)testAuthorizationRequestURLParameters {
+  OIDAuthorizationRequest *request = [[self class] testInstance];
+  for (int i = 0; i < 2; i++) {
+    NSString *state = [OIDAuthorizationRequest generateState];
+    NSString *nonce = [OIDAuthorizationRequest generateState];
+    OIDAuthorizationRequest *requestWithNewState =
+        [[OIDAuthorizationRequest alloc] initWithConfiguration:request.configuration
+                                                      clientId:request.clientID
+                                                  clientSecret:request.clientSecret
+                                                         scope:request.scope
+                                                   redirectURL:request.redirectURL
+                                                  responseType:request.responseType
+                                                         state:state
+                                                         nonce:nonce
+                                                  codeVerifier:request.codeVerifier
+                                                 codeChallenge:request.codeChallenge
+                                           codeChallengeMethod:request.codeChallengeMethod
+                                          additionalParameters:request.additionalParameters];
+    NSURL *URL = [requestWithNewState authorizationRequestURL];
+    XCTAssertEqualObjects(URL.host, request.configuration.authorizationEndpoint.host);
+    XCTAssertEqualObjects(URL.path, request.configuration.authorizationEndpoint.path);
+
+    OIDURLQueryComponent *query = [[OIDURLQueryComponent alloc] initWithURL:URL];
+    NSDictionary *expectedParameters = @{
+      @"response_type" : kTestResponseType,
+      @"client_id" : kTestClientID,
+      @"redirect_uri" : kTestRedirectURL,
+      @"scope" : kTestScopesMerged,
+      @"state" : state,
+      @"nonce" : nonce,
+      @"code_challenge" : [[self class] codeChallenge],
+      @"code_challenge_method" : [[self class] codeChallengeMethod],
+      kTestAdditionalParameterKey : kTestAdditionalParameterValue,
+    };
+    XCTAssertEqualObjects(query.dictionaryValue, expectedParameters);
+  }
+}
+
+/*! @brief Measures building authorization URLs for many requests of the same client.
+ */
+- (void)testAuthorizationRequestURLPerformance {
+  OIDServiceConfiguration *configuration = [OIDServiceConfigurationTests testInstance];
+  NSMutableArray<OIDAuthorizationRequest *> *requests = [NSMutableArray array];
+  for (int i = 0; i < 5000; i++) {
+    OIDAuthorizationRequest *request =
+        [[OIDAuthorizationRequest alloc] initWithConfiguration:configuration
+                                                      clientId:kTestClientID
+                                                        scopes:@[ kTestScope, kTestScopeA ]
+                                                   redirectURL:[NSURL URLWithString:kTestRedirectURL]
+                                                  responseType:OIDResponseTypeCode
+                                          additionalParameters:nil];
+    [requests addObject:request];
+  }
+
+  [self measureBlock:^{
+    for (OIDAuthorizationRequest *request in requests) {
+      @autoreleasepool {
+        XCTAssertNotNil([request authorizationRequestURL]);
+      }
+    }
+  }];
+}
+
 - (void)testExternalUserAgentMethods {
   OIDAuthorizationRequest *request = [[self class] testInstance];
   XCTAssertEqualObjects([request externalUserAgentRequestURL], [request authorizationRequestURL]);
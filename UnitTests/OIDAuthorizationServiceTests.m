@@ -0,0 +1,76 @@
+/*! @file OIDAuthorizationServiceTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+#import "OIDServiceConfigurationTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDServiceConfiguration.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDAuthorizationService.
+ */
+@interface OIDAuthorizationServiceTests : XCTestCase
+@end
+
+@implementation OIDAuthorizationServiceTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Tests that pre-warming sends a single @c HEAD request to the token endpoint through the
+        @c OIDURLSessionProvider session.
+ */
+- (void)testPrewarmConnectionForConfiguration {
+  OIDServiceConfiguration *configuration = [OIDServiceConfigurationTests testInstance];
+  NSPredicate *requestSent = [NSPredicate predicateWithBlock:^BOOL(id object,
+                                                                   NSDictionary *bindings) {
+    return [OIDMockOpenIDProvider requestCount] > 0;
+  }];
+  [self expectationForPredicate:requestSent evaluatedWithObject:self handler:nil];
+
+  [OIDAuthorizationService prewarmConnectionForConfiguration:configuration];
+
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 1);
+  NSURLRequest *request = [OIDMockOpenIDProvider receivedTasks].firstObject.originalRequest;
+  XCTAssertEqualObjects(request.HTTPMethod, @"HEAD");
+  XCTAssertEqualObjects(request.URL, configuration.tokenEndpoint);
+  XCTAssertNil(request.HTTPBody);
+}
+
+@end
+
+#pragma GCC diagnostic pop
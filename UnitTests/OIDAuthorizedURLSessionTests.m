@@ -0,0 +1,187 @@
+/*! @file OIDAuthorizedURLSessionTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthorizedURLSession.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The URL of the resource requested in the tests, which @c OIDMockOpenIDProvider serves
+        as its userinfo endpoint, accepting only the access tokens it issued.
+ */
+static NSString *const kResourceURL = @"https://resource.example.com/userinfo";
+
+/*! @brief An unexpired access token which the resource server rejects.
+ */
+static NSString *const kRevokedAccessToken = @"revoked_access_token";
+
+/*! @brief Unit tests for @c OIDAuthorizedURLSession.
+ */
+@interface OIDAuthorizedURLSessionTests : XCTestCase
+@end
+
+@implementation OIDAuthorizedURLSessionTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Returns an authorization state with an unexpired access token which the resource server
+        rejects, and a valid refresh token.
+ */
++ (OIDAuthState *)authStateWithRevokedAccessToken {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithAccessToken:kRevokedAccessToken
+                                                               refreshToken:@"refresh_token"
+                                                                  expiresIn:3600
+                                                                    subject:nil];
+  [OIDMockOpenIDProvider revokeToken:kRevokedAccessToken];
+  return authState;
+}
+
+/*! @brief Performs requests for @c kResourceURL concurrently and waits for all of them.
+    @param count The number of requests.
+    @param session The session performing the requests.
+    @param handler Called with the result of each request.
+ */
+- (void)performRequests:(NSUInteger)count
+            withSession:(OIDAuthorizedURLSession *)session
+                handler:(void (^)(NSHTTPURLResponse *response,
+                                  OIDAuthorizedRequestMetrics *metrics,
+                                  NSError *error))handler {
+  NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:kResourceURL]];
+  NSMutableArray<XCTestExpectation *> *expectations = [NSMutableArray array];
+  for (NSUInteger i = 0; i < count; i++) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Request completes."];
+    [expectations addObject:expectation];
+    [session performRequest:request
+                 completion:^(NSData *_Nullable data,
+                              NSURLResponse *_Nullable response,
+                              OIDAuthorizedRequestMetrics *metrics,
+                              NSError *_Nullable error) {
+      handler((NSHTTPURLResponse *)response, metrics, error);
+      [expectation fulfill];
+    }];
+  }
+  [self waitForExpectations:expectations timeout:5];
+}
+
+- (void)testAttachesFreshAccessTokenWithoutRefresh {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDAuthorizedURLSession *session = [[OIDAuthorizedURLSession alloc] initWithAuthState:authState];
+  [self performRequests:1
+            withSession:session
+                handler:^(NSHTTPURLResponse *response,
+                          OIDAuthorizedRequestMetrics *metrics,
+                          NSError *error) {
+    XCTAssertNil(error);
+    XCTAssertEqual(response.statusCode, 200);
+    XCTAssertEqual(metrics.attempts, 1);
+    XCTAssertFalse(metrics.waitedForTokenRefresh);
+    XCTAssertEqual(metrics.tokenWaitDuration, 0);
+    XCTAssertGreaterThanOrEqual(metrics.totalDuration, metrics.networkDuration);
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 0);
+}
+
+- (void)testReplaysRequestOnceAfterUnauthorizedResponse {
+  OIDAuthState *authState = [[self class] authStateWithRevokedAccessToken];
+  OIDAuthorizedURLSession *session = [[OIDAuthorizedURLSession alloc] initWithAuthState:authState];
+  [self performRequests:1
+            withSession:session
+                handler:^(NSHTTPURLResponse *response,
+                          OIDAuthorizedRequestMetrics *metrics,
+                          NSError *error) {
+    XCTAssertNil(error);
+    XCTAssertEqual(response.statusCode, 200);
+    XCTAssertEqual(metrics.attempts, 2);
+    XCTAssertTrue(metrics.waitedForTokenRefresh);
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderUserinfoPath],
+                 2);
+  XCTAssertEqualObjects(authState.accessToken, @"access_token_1");
+}
+
+- (void)testConcurrentUnauthorizedResponsesShareOneRefresh {
+  OIDAuthState *authState = [[self class] authStateWithRevokedAccessToken];
+  OIDAuthorizedURLSession *session = [[OIDAuthorizedURLSession alloc] initWithAuthState:authState];
+  [self performRequests:20
+            withSession:session
+                handler:^(NSHTTPURLResponse *response,
+                          OIDAuthorizedRequestMetrics *metrics,
+                          NSError *error) {
+    XCTAssertNil(error);
+    XCTAssertEqual(response.statusCode, 200);
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+}
+
+- (void)testReturnsUnauthorizedResponseOfReplay {
+  [OIDMockOpenIDProvider setStatusCode:401 forPath:OIDMockOpenIDProviderUserinfoPath];
+  OIDAuthState *authState = [[self class] authStateWithRevokedAccessToken];
+  OIDAuthorizedURLSession *session = [[OIDAuthorizedURLSession alloc] initWithAuthState:authState];
+  [self performRequests:1
+            withSession:session
+                handler:^(NSHTTPURLResponse *response,
+                          OIDAuthorizedRequestMetrics *metrics,
+                          NSError *error) {
+    XCTAssertEqual(response.statusCode, 401);
+    XCTAssertEqual(metrics.attempts, 2);
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderUserinfoPath],
+                 2);
+}
+
+- (void)testRequestsWithFreshAccessTokenPerformance {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDAuthorizedURLSession *session = [[OIDAuthorizedURLSession alloc] initWithAuthState:authState];
+  [self measureBlock:^{
+    @autoreleasepool {
+      [self performRequests:50
+                withSession:session
+                    handler:^(NSHTTPURLResponse *response,
+                              OIDAuthorizedRequestMetrics *metrics,
+                              NSError *error) {
+        XCTAssertEqual(response.statusCode, 200);
+      }];
+    }
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 0);
+}
+
+@end
+
+#pragma GCC diagnostic pop
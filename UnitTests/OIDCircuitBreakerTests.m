@@ -0,0 +1,205 @@
+/*! @file OIDCircuitBreakerTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+#import "OIDServiceConfigurationTests.h"
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDCircuitBreaker.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDErrorUtilities.h"
+#import "Sources/AppAuthCore/OIDServiceConfiguration.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The key of the circuit used by the tests.
+ */
+static NSString *const kCircuitKey = @"https://issuer.example.com";
+
+/*! @brief Unit tests for @c OIDCircuitBreaker.
+ */
+@interface OIDCircuitBreakerTests : XCTestCase
+@end
+
+@implementation OIDCircuitBreakerTests {
+  /*! @brief The date returned by the virtual clock of the circuit breakers under test.
+   */
+  NSDate *_now;
+}
+
+- (void)setUp {
+  [super setUp];
+  _now = [NSDate dateWithTimeIntervalSince1970:0];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDCircuitBreaker setTokenEndpointCircuitBreaker:nil];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Returns a circuit breaker with a virtual clock reading @c _now.
+ */
+- (OIDCircuitBreaker *)circuitBreakerWithFailureThreshold:(NSUInteger)failureThreshold {
+  OIDCircuitBreaker *circuitBreaker =
+      [[OIDCircuitBreaker alloc] initWithFailureThreshold:failureThreshold openInterval:30];
+  __weak OIDCircuitBreakerTests *weakSelf = self;
+  circuitBreaker.currentDate = ^{
+    OIDCircuitBreakerTests *strongSelf = weakSelf;
+    return strongSelf ? strongSelf->_now : [NSDate date];
+  };
+  return circuitBreaker;
+}
+
+/*! @brief Returns an error as returned by a token request answered with HTTP 503.
+ */
++ (NSError *)serverError {
+  NSHTTPURLResponse *response =
+      [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://www.example.com/"]
+                                  statusCode:503
+                                 HTTPVersion:@"HTTP/1.1"
+                                headerFields:nil];
+  NSError *HTTPError = [OIDErrorUtilities HTTPErrorWithHTTPResponse:response data:nil];
+  return [OIDErrorUtilities errorWithCode:OIDErrorCodeServerError
+                          underlyingError:HTTPError
+                              description:nil];
+}
+
+- (void)testOpensAfterConsecutiveFailures {
+  OIDCircuitBreaker *circuitBreaker = [self circuitBreakerWithFailureThreshold:3];
+  NSError *serverError = [[self class] serverError];
+
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:serverError];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:serverError];
+  // Any response other than a 5xx resets the count.
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:nil];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:serverError];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:serverError];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateClosed);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:serverError];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateOpen);
+  XCTAssertFalse([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+
+  // Other issuers are unaffected.
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:@"https://other.example.com"]);
+}
+
+- (void)testHalfOpenProbe {
+  OIDCircuitBreaker *circuitBreaker = [self circuitBreakerWithFailureThreshold:1];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:[[self class] serverError]];
+  XCTAssertFalse([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+
+  // Once the open interval has passed, a single probe is allowed, and a failure reopens.
+  _now = [_now dateByAddingTimeInterval:30];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateHalfOpen);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+  XCTAssertFalse([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:[[self class] serverError]];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateOpen);
+
+  // A successful probe closes the circuit.
+  _now = [_now dateByAddingTimeInterval:30];
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:nil];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateClosed);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+}
+
+/*! @brief Tests that cancelling the probe of a half-open circuit neither closes nor reopens it.
+ */
+- (void)testCancelledProbe {
+  OIDCircuitBreaker *circuitBreaker = [self circuitBreakerWithFailureThreshold:1];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:[[self class] serverError]];
+  _now = [_now dateByAddingTimeInterval:30];
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+
+  NSError *cancelled = [NSError errorWithDomain:NSURLErrorDomain
+                                           code:NSURLErrorCancelled
+                                       userInfo:nil];
+  NSError *cancelledError = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
+                                             underlyingError:cancelled
+                                                 description:nil];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:cancelledError];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateHalfOpen);
+
+  // The next request is the probe, and no other request is allowed alongside it.
+  XCTAssertTrue([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+  XCTAssertFalse([circuitBreaker shouldAllowRequestForKey:kCircuitKey]);
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:[[self class] serverError]];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateOpen);
+}
+
+- (void)testOAuthErrorsAreNotFailures {
+  OIDCircuitBreaker *circuitBreaker = [self circuitBreakerWithFailureThreshold:1];
+  NSError *invalidGrant =
+      [OIDErrorUtilities OAuthErrorWithDomain:OIDOAuthTokenErrorDomain
+                                OAuthResponse:@{ @"error" : @"invalid_grant" }
+                              underlyingError:nil];
+  [circuitBreaker recordRequestForKey:kCircuitKey completedWithError:invalidGrant];
+  XCTAssertEqual([circuitBreaker stateForKey:kCircuitKey], OIDCircuitBreakerStateClosed);
+}
+
+- (void)testKeyForConfiguration {
+  OIDServiceConfiguration *configuration = [OIDServiceConfigurationTests testInstance];
+  XCTAssertEqualObjects([OIDCircuitBreaker keyForConfiguration:configuration],
+                        configuration.tokenEndpoint.absoluteString);
+}
+
+/*! @brief Tests that token requests fail fast once the circuit of their issuer opens.
+ */
+- (void)testTokenRequestsFailFastWhileOpen {
+  [OIDCircuitBreaker setTokenEndpointCircuitBreaker:[self circuitBreakerWithFailureThreshold:2]];
+  [OIDMockOpenIDProvider setStatusCode:503 forPath:OIDMockOpenIDProviderTokenPath];
+  OIDTokenRequest *request = [OIDTokenRequestTests testInstance];
+
+  NSArray<NSNumber *> *expectedCodes = @[
+    @(OIDErrorCodeServerError), @(OIDErrorCodeServerError), @(OIDErrorCodeCircuitBreakerOpen)
+  ];
+  for (NSNumber *expectedCode in expectedCodes) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Token request fails."];
+    [OIDAuthorizationService performTokenRequest:request
+                                        callback:^(OIDTokenResponse *_Nullable tokenResponse,
+                                                   NSError *_Nullable error) {
+      XCTAssertNil(tokenResponse);
+      XCTAssertEqual(error.code, expectedCode.integerValue);
+      [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+  }
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 2);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,176 @@
+/*! @file OIDClockTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDClock.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#import "Sources/AppAuthCore/OIDTokenUtilities.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The date of the server in @c kServerDateHeader, two hours ahead of the local clock.
+ */
+static NSTimeInterval const kServerTime = 1767232800;
+
+/*! @brief The @c Date header sent by the token endpoint.
+ */
+static NSString *const kServerDateHeader = @"Thu, 01 Jan 2026 02:00:00 GMT";
+
+/*! @brief The date of the local clock during the tests.
+ */
+static NSTimeInterval const kLocalTime = kServerTime - 7200;
+
+/*! @brief Unit tests for @c OIDClock.
+ */
+@interface OIDClockTests : XCTestCase
+@end
+
+@implementation OIDClockTests {
+  /*! @brief The date returned by the virtual clock of @c _clock.
+   */
+  NSDate *_now;
+
+  /*! @brief The shared clock during the tests.
+   */
+  OIDClock *_clock;
+}
+
+- (void)setUp {
+  [super setUp];
+  _now = [NSDate dateWithTimeIntervalSince1970:kLocalTime];
+  _clock = [[OIDClock alloc] init];
+  __weak OIDClockTests *weakSelf = self;
+  _clock.currentDate = ^{
+    OIDClockTests *strongSelf = weakSelf;
+    return strongSelf ? strongSelf->_now : [NSDate date];
+  };
+  [OIDClock setSharedClock:_clock];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDClock setSharedClock:nil];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Returns a response with a Date header.
+ */
++ (NSHTTPURLResponse *)responseWithDateHeader:(NSString *)dateHeader {
+  return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://www.example.com/"]
+                                     statusCode:200
+                                    HTTPVersion:@"HTTP/1.1"
+                                   headerFields:@{ @"date" : dateHeader }];
+}
+
+/*! @brief Builds a token response whose ID Token was issued by the token endpoint, at the time of
+        its clock, for a token request.
+ */
++ (NSDictionary *)tokenResponseForRequest:(OIDTokenRequest *)request {
+  NSDictionary *claims = @{
+    @"iss" : @"https://www.example.com",
+    @"sub" : @"subject",
+    @"aud" : request.clientID,
+    @"exp" : @(kServerTime + 3600),
+    @"iat" : @(kServerTime),
+  };
+  NSData *header = [NSJSONSerialization dataWithJSONObject:@{ @"alg" : @"none" }
+                                                   options:0
+                                                     error:NULL];
+  NSData *payload = [NSJSONSerialization dataWithJSONObject:claims options:0 error:NULL];
+  NSString *idToken =
+      [NSString stringWithFormat:@"%@.%@.",
+                                 [OIDTokenUtilities encodeBase64urlNoPadding:header],
+                                 [OIDTokenUtilities encodeBase64urlNoPadding:payload]];
+  return @{
+    @"access_token" : @"access_token",
+    @"token_type" : @"Bearer",
+    @"expires_in" : @3600,
+    @"id_token" : idToken,
+  };
+}
+
+/*! @brief Performs a token request to a token endpoint whose clock is ahead of the local clock, and
+        waits for the result.
+ */
+- (NSError *)performTokenRequest {
+  OIDTokenRequest *request = [OIDTokenRequestTests testInstance];
+  [OIDMockOpenIDProvider setResponseWithStatusCode:200
+                                           headers:@{ @"Date" : kServerDateHeader }
+                                              JSON:[[self class] tokenResponseForRequest:request]
+                                           forPath:OIDMockOpenIDProviderTokenPath];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token request completes."];
+  __block NSError *tokenError;
+  [OIDAuthorizationService performTokenRequest:request
+                                      callback:^(OIDTokenResponse *_Nullable tokenResponse,
+                                                 NSError *_Nullable error) {
+    tokenError = error;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  return tokenError;
+}
+
+- (void)testLearnsServerTimeOffsetFromDateHeader {
+  [_clock updateServerTimeOffsetWithHTTPResponse:
+      [[self class] responseWithDateHeader:kServerDateHeader]];
+  XCTAssertEqual(_clock.serverTimeOffset, 7200);
+  XCTAssertEqualObjects([_clock serverNow], [NSDate dateWithTimeIntervalSince1970:kServerTime]);
+  XCTAssertEqualObjects([_clock now], _now);
+}
+
+- (void)testIgnoresInvalidDateHeader {
+  [_clock updateServerTimeOffsetWithHTTPResponse:
+      [[self class] responseWithDateHeader:@"yesterday"]];
+  XCTAssertEqual(_clock.serverTimeOffset, 0);
+
+  _clock.learnsServerTimeOffset = NO;
+  [_clock updateServerTimeOffsetWithHTTPResponse:
+      [[self class] responseWithDateHeader:kServerDateHeader]];
+  XCTAssertEqual(_clock.serverTimeOffset, 0);
+}
+
+- (void)testAcceptsIDTokenFromServerWithClockAhead {
+  XCTAssertNil([self performTokenRequest]);
+  XCTAssertEqual(_clock.serverTimeOffset, 7200);
+}
+
+- (void)testRejectsIDTokenFromServerWithClockAheadWithoutOffset {
+  _clock.learnsServerTimeOffset = NO;
+  NSError *error = [self performTokenRequest];
+  XCTAssertEqualObjects(error.domain, OIDGeneralErrorDomain);
+  XCTAssertEqual(error.code, OIDErrorCodeIDTokenFailedValidationError);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,94 @@
+/*! @file OIDErrorUtilitiesTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDErrorUtilities.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDErrorUtilities.
+ */
+@interface OIDErrorUtilitiesTests : XCTestCase
+@end
+
+@implementation OIDErrorUtilitiesTests
+
+/*! @brief Returns an HTTP response with the given status code for testing.
+ */
++ (NSHTTPURLResponse *)HTTPResponseWithStatusCode:(NSInteger)statusCode {
+  return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://www.example.com/"]
+                                     statusCode:statusCode
+                                    HTTPVersion:@"HTTP/1.1"
+                                   headerFields:nil];
+}
+
+- (void)testOAuthErrorCodeFromString {
+  XCTAssertEqual([OIDErrorUtilities OAuthErrorCodeFromString:@"invalid_request"],
+                 OIDErrorCodeOAuthInvalidRequest);
+  XCTAssertEqual([OIDErrorUtilities OAuthErrorCodeFromString:@"invalid_grant"],
+                 OIDErrorCodeOAuthInvalidGrant);
+  XCTAssertEqual([OIDErrorUtilities OAuthErrorCodeFromString:@"temporarily_unavailable"],
+                 OIDErrorCodeOAuthTemporarilyUnavailable);
+  XCTAssertEqual([OIDErrorUtilities OAuthErrorCodeFromString:@"unsupported_grant_type"],
+                 OIDErrorCodeOAuthUnsupportedGrantType);
+  XCTAssertEqual([OIDErrorUtilities OAuthErrorCodeFromString:@"not_an_oauth_error"],
+                 OIDErrorCodeOAuthOther);
+}
+
+/*! @brief Tests that the response body of an HTTP error is used as its description.
+ */
+- (void)testHTTPErrorDescription {
+  NSData *data = [@"Service Unavailable" dataUsingEncoding:NSUTF8StringEncoding];
+  NSError *error =
+      [OIDErrorUtilities HTTPErrorWithHTTPResponse:[[self class] HTTPResponseWithStatusCode:503]
+                                              data:data];
+  XCTAssertEqualObjects(error.domain, OIDHTTPErrorDomain);
+  XCTAssertEqual(error.code, 503);
+  XCTAssertEqualObjects(error.localizedDescription, @"Service Unavailable");
+  XCTAssertEqualObjects(error.userInfo[NSLocalizedDescriptionKey], @"Service Unavailable");
+}
+
+/*! @brief Tests that only the start of a large HTTP error body is kept, even when the limit falls
+        in the middle of a multi-byte character.
+ */
+- (void)testHTTPErrorDescriptionIsBounded {
+  NSMutableString *body = [NSMutableString stringWithString:@"a"];
+  for (int i = 0; i < 10000; i++) {
+    [body appendString:@"é"];
+  }
+  NSData *data = [body dataUsingEncoding:NSUTF8StringEncoding];
+  NSError *error =
+      [OIDErrorUtilities HTTPErrorWithHTTPResponse:[[self class] HTTPResponseWithStatusCode:502]
+                                              data:data];
+  NSString *description = error.localizedDescription;
+  XCTAssertTrue([body hasPrefix:description]);
+  XCTAssertEqual([description lengthOfBytesUsingEncoding:NSUTF8StringEncoding], 4095);
+}
+
+@end
+
+#pragma GCC diagnostic pop
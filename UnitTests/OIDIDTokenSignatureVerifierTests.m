@@ -0,0 +1,294 @@
+/*! @file OIDIDTokenSignatureVerifierTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDIDTokenSignatureVerifier.h"
+#import "Sources/AppAuthCore/OIDJWKSCache.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#import "Sources/AppAuthCore/OIDTokenUtilities.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The URL of the JSON Web Key Set, which @c OIDMockOpenIDProvider answers with @c kJWKS.
+ */
+static NSString *const kJWKSURL = @"https://issuer.example.com/jwks";
+
+/*! @brief A JSON Web Key Set with an RS256 key "rsa1" and an ES256 key "ec1".
+ */
+static NSString *const kJWKS =
+    @"{\"keys\":[{\"kty\":\"RSA\",\"kid\":\"rsa1\",\"use\":\"sig\",\"alg\":\"RS256\",\"n\":\"36k36"
+    @"uyDNLfDleN22zjloc3eebMB-25fx0UlbyEFRnxLgw6gAlfwAivg8fbMkWBrzf4_wVBvdSAjvy4pWHSDSTFXqIT8rYRaW"
+    @"HIKc17h_e91WaVd8LWv2v_HD81BeWNzJGbr_wLqv30fuE8PfNJJLgMlOG1Y-WgvLmSrsJ8aE1jSkmtdjWUTv7VwSdn2v"
+    @"x1XfulBTxoDwBMSkc-fnqtKg8iUGLr2PQfAPCCj0PkJjNmKVTYTomIJ4tMhFOQNl6DuTqaOmGxxWce3lqFghH6wYHpSh"
+    @"PRIz_eTHAEoLBM_aoSV86i52z7oqpxG9mQgvHmCLoSW5eRmaO7OccrHKqQkiw\",\"e\":\"AQAB\"},{\"kty\":\"E"
+    @"C\",\"kid\":\"ec1\",\"crv\":\"P-256\",\"x\":\"Yu5nN0h-g2PPiT9UTbEqw9tOGaSK5mohIdGT3Cmbnd0\","
+    @"\"y\":\"D0UYOozeh2gEvp6NIVy_v371D1ZgedqH0HpqXbECB6c\"}]}";
+
+/*! @brief An ID Token signed with the key "rsa1" of @c kJWKS.
+ */
+static NSString *const kRS256IDToken =
+    @"eyJhbGciOiJSUzI1NiIsImtpZCI6InJzYTEiLCJ0eXAiOiJKV1QifQ.eyJpc3MiOiJodHRwczovL2lzc3Vlci5leGFtc"
+    @"GxlLmNvbSIsInN1YiI6IjEyMyIsImF1ZCI6ImNsaWVudCIsImV4cCI6NDEwMjQ0NDgwMCwiaWF0IjoxNzAwMDAwMDAwf"
+    @"Q.gbeYjj_CwTkU27xG1Jlbs7HVM3dUuwsHDU0qps1sLJwCWsgZuz1RFfrAQsLglOUXg5ugRTevpO3iTP4QHYNyLH5rzV"
+    @"B_f7IwcMwAHzJ27ZirVqki-uqYXLANAds22h5fgQKbyDUUlJcYTm58DdNFtjCTIHxQ_gFCdkEZRENuAELHXi5rmSgubb"
+    @"mi-0mPI8UGy6IPcZEmedmSNtH626_6wls5N6LACd4LXaVoJtEFa4nUIU1u096XtGFrTp95GR_zlQHyBT0ewmZB1enh1h"
+    @"mWLPwG1B7J9qh2nvVhwddvpVMTTmXuLdu8KA8LEMWo1dTJ43X2UQlZkrWAhR_dYv5_CQ";
+
+/*! @brief An ID Token signed with the key "ec1" of @c kJWKS.
+ */
+static NSString *const kES256IDToken =
+    @"eyJhbGciOiJFUzI1NiIsImtpZCI6ImVjMSIsInR5cCI6IkpXVCJ9.eyJpc3MiOiJodHRwczovL2lzc3Vlci5leGFtcGx"
+    @"lLmNvbSIsInN1YiI6IjEyMyIsImF1ZCI6ImNsaWVudCIsImV4cCI6NDEwMjQ0NDgwMCwiaWF0IjoxNzAwMDAwMDAwfQ."
+    @"2EAghGxeXyjuYw0uhpP1JvY4XJxWRg09pixvVZHcg9FjdXIzEPLbrMqIqD0QA-xXmXiliZbwkAqSUNZqC9zLfQ";
+
+/*! @brief Unit tests for @c OIDIDTokenSignatureVerifier and @c OIDJWKSCache.
+ */
+@interface OIDIDTokenSignatureVerifierTests : XCTestCase
+@end
+
+@implementation OIDIDTokenSignatureVerifierTests {
+  /*! @brief The date returned by the virtual clock of the caches under test.
+   */
+  NSDate *_now;
+}
+
+- (void)setUp {
+  [super setUp];
+  _now = [NSDate dateWithTimeIntervalSince1970:0];
+  [OIDMockOpenIDProvider install];
+  NSData *JWKSData = [kJWKS dataUsingEncoding:NSUTF8StringEncoding];
+  NSDictionary *JWKS = [NSJSONSerialization JSONObjectWithData:JWKSData options:0 error:NULL];
+  [OIDMockOpenIDProvider setResponseWithStatusCode:200
+                                           headers:nil
+                                              JSON:JWKS
+                                           forPath:OIDMockOpenIDProviderJWKSPath];
+}
+
+- (void)tearDown {
+  [OIDIDTokenSignatureVerifier setSharedVerifier:nil];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Returns a block reading @c _now.
+ */
+- (NSDate *(^)(void))virtualClock {
+  __weak OIDIDTokenSignatureVerifierTests *weakSelf = self;
+  return ^{
+    OIDIDTokenSignatureVerifierTests *strongSelf = weakSelf;
+    return strongSelf ? strongSelf->_now : [NSDate date];
+  };
+}
+
+/*! @brief Returns the key of @c kJWKS with a key ID.
+ */
++ (NSDictionary<NSString *, id> *)keyWithID:(NSString *)keyID {
+  NSData *JWKSData = [kJWKS dataUsingEncoding:NSUTF8StringEncoding];
+  NSDictionary *JWKS = [NSJSONSerialization JSONObjectWithData:JWKSData options:0 error:NULL];
+  for (NSDictionary<NSString *, id> *key in JWKS[@"keys"]) {
+    if ([key[@"kid"] isEqual:keyID]) {
+      return key;
+    }
+  }
+  return nil;
+}
+
+/*! @brief Looks up a key in a key set cache and waits for the result.
+ */
+- (NSDictionary<NSString *, id> *)keyWithID:(NSString *)keyID
+                                    inCache:(OIDJWKSCache *)cache
+                                      error:(NSError **)error {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Key lookup completes."];
+  __block NSDictionary<NSString *, id> *foundKey;
+  __block NSError *lookupError;
+  [cache keyWithID:keyID completion:^(NSDictionary<NSString *, id> *_Nullable key,
+                                      NSError *_Nullable keyError) {
+    foundKey = key;
+    lookupError = keyError;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  if (error) {
+    *error = lookupError;
+  }
+  return foundKey;
+}
+
+/*! @brief Verifies an ID Token and waits for the result.
+ */
+- (NSError *)verifyIDToken:(NSString *)IDToken
+               withVerifier:(OIDIDTokenSignatureVerifier *)verifier {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Verification completes."];
+  __block NSError *verificationError;
+  [verifier verifyIDToken:IDToken
+                  JWKSURL:[NSURL URLWithString:kJWKSURL]
+               completion:^(NSError *_Nullable error) {
+    verificationError = error;
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  return verificationError;
+}
+
+- (void)testVerifiesRS256Signature {
+  NSDictionary<NSString *, id> *key = [[self class] keyWithID:@"rsa1"];
+  NSError *error = [OIDIDTokenSignatureVerifier verifySignatureOfToken:kRS256IDToken withKey:key];
+  XCTAssertNil(error);
+}
+
+- (void)testVerifiesES256Signature {
+  NSDictionary<NSString *, id> *key = [[self class] keyWithID:@"ec1"];
+  NSError *error = [OIDIDTokenSignatureVerifier verifySignatureOfToken:kES256IDToken withKey:key];
+  XCTAssertNil(error);
+}
+
+- (void)testRejectsModifiedClaims {
+  NSArray<NSString *> *sections = [kRS256IDToken componentsSeparatedByString:@"."];
+  NSData *claims = [@"{\"iss\":\"https://issuer.example.com\",\"sub\":\"456\"}"
+      dataUsingEncoding:NSUTF8StringEncoding];
+  NSString *modifiedToken =
+      [NSString stringWithFormat:@"%@.%@.%@",
+                                 sections[0],
+                                 [OIDTokenUtilities encodeBase64urlNoPadding:claims],
+                                 sections[2]];
+  NSDictionary<NSString *, id> *key = [[self class] keyWithID:@"rsa1"];
+  NSError *error = [OIDIDTokenSignatureVerifier verifySignatureOfToken:modifiedToken withKey:key];
+  XCTAssertEqualObjects(error.domain, OIDGeneralErrorDomain);
+  XCTAssertEqual(error.code, OIDErrorCodeIDTokenFailedValidationError);
+}
+
+- (void)testRejectsUnsupportedAlgorithm {
+  NSArray<NSString *> *sections = [kRS256IDToken componentsSeparatedByString:@"."];
+  NSData *header = [@"{\"alg\":\"none\"}" dataUsingEncoding:NSUTF8StringEncoding];
+  NSString *unsignedToken =
+      [NSString stringWithFormat:@"%@.%@.",
+                                 [OIDTokenUtilities encodeBase64urlNoPadding:header],
+                                 sections[1]];
+  NSDictionary<NSString *, id> *key = [[self class] keyWithID:@"rsa1"];
+  NSError *error = [OIDIDTokenSignatureVerifier verifySignatureOfToken:unsignedToken withKey:key];
+  XCTAssertEqual(error.code, OIDErrorCodeIDTokenFailedValidationError);
+}
+
+- (void)testRejectsKeyOfOtherType {
+  NSDictionary<NSString *, id> *key = [[self class] keyWithID:@"ec1"];
+  NSError *error = [OIDIDTokenSignatureVerifier verifySignatureOfToken:kRS256IDToken withKey:key];
+  XCTAssertEqual(error.code, OIDErrorCodeIDTokenFailedValidationError);
+}
+
+- (void)testVerifyIDTokenFetchesKeySetOnce {
+  OIDIDTokenSignatureVerifier *verifier =
+      [[OIDIDTokenSignatureVerifier alloc] initWithKeySetTimeToLive:3600];
+  verifier.currentDate = [self virtualClock];
+  XCTAssertNil([self verifyIDToken:kRS256IDToken withVerifier:verifier]);
+  XCTAssertNil([self verifyIDToken:kES256IDToken withVerifier:verifier]);
+  XCTAssertNil([self verifyIDToken:kRS256IDToken withVerifier:verifier]);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderJWKSPath], 1u);
+}
+
+- (void)testVerifyIDTokenFailsWhenKeySetUnavailable {
+  [OIDMockOpenIDProvider setOffline:YES];
+  OIDIDTokenSignatureVerifier *verifier =
+      [[OIDIDTokenSignatureVerifier alloc] initWithKeySetTimeToLive:3600];
+  verifier.currentDate = [self virtualClock];
+  NSError *error = [self verifyIDToken:kRS256IDToken withVerifier:verifier];
+  XCTAssertEqual(error.code, OIDErrorCodeIDTokenFailedValidationError);
+  XCTAssertNotNil(error.userInfo[NSUnderlyingErrorKey]);
+}
+
+/*! @brief Tests that the ID Tokens received with a service configuration built without discovery,
+        which provides no key set URL, are accepted without verifying their signature.
+ */
+- (void)testTokenRequestWithoutDiscoverySkipsVerification {
+  [OIDIDTokenSignatureVerifier
+      setSharedVerifier:[[OIDIDTokenSignatureVerifier alloc] initWithKeySetTimeToLive:3600]];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token"
+                                                               refreshToken:@"refresh_token"
+                                                                  expiresIn:0
+                                                                    subject:@"subject"];
+  XCTAssertNil(authState.lastAuthorizationResponse.request.configuration.discoveryDocument);
+  NSString *IDToken = authState.lastTokenResponse.idToken;
+  [OIDMockOpenIDProvider setResponseWithStatusCode:200
+                                           headers:nil
+                                              JSON:@{
+                                                @"access_token" : @"access_token_1",
+                                                @"token_type" : @"Bearer",
+                                                @"id_token" : IDToken
+                                              }
+                                           forPath:OIDMockOpenIDProviderTokenPath];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token request completes."];
+  [OIDAuthorizationService performTokenRequest:[authState tokenRefreshRequest]
+                                      callback:^(OIDTokenResponse *_Nullable response,
+                                                 NSError *_Nullable error) {
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(response.idToken, IDToken);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderJWKSPath], 0u);
+}
+
+- (void)testKeySetCacheRefetchesUnknownKeyIDsAtMostOncePerInterval {
+  OIDJWKSCache *cache = [[OIDJWKSCache alloc] initWithJWKSURL:[NSURL URLWithString:kJWKSURL]
+                                                   timeToLive:3600];
+  cache.currentDate = [self virtualClock];
+  NSError *error;
+  XCTAssertNil([self keyWithID:@"rotated" inCache:cache error:&error]);
+  XCTAssertEqual(error.code, OIDErrorCodeIDTokenFailedValidationError);
+  XCTAssertNil([self keyWithID:@"rotated" inCache:cache error:NULL]);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderJWKSPath], 1u);
+
+  _now = [_now dateByAddingTimeInterval:cache.minimumRefreshInterval];
+  XCTAssertNil([self keyWithID:@"rotated" inCache:cache error:NULL]);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderJWKSPath], 2u);
+  XCTAssertNotNil([self keyWithID:@"ec1" inCache:cache error:NULL]);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderJWKSPath], 2u);
+}
+
+- (void)testKeySetCacheUsesExpiredKeysWhenOffline {
+  OIDJWKSCache *cache = [[OIDJWKSCache alloc] initWithJWKSURL:[NSURL URLWithString:kJWKSURL]
+                                                   timeToLive:3600];
+  cache.currentDate = [self virtualClock];
+  NSError *error;
+  XCTAssertTrue([cache updateWithJWKSData:[kJWKS dataUsingEncoding:NSUTF8StringEncoding]
+                                    error:&error]);
+  XCTAssertNil(error);
+
+  [OIDMockOpenIDProvider setOffline:YES];
+  _now = [_now dateByAddingTimeInterval:cache.timeToLive];
+  XCTAssertEqualObjects([self keyWithID:@"rsa1" inCache:cache error:NULL],
+                        [[self class] keyWithID:@"rsa1"]);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderJWKSPath], 1u);
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,146 @@
+/*! @file OIDMetricsTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDMetrics.h"
+#import "Sources/AppAuthCore/OIDMetricsAggregator.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDMetrics and @c OIDMetricsAggregator.
+ */
+@interface OIDMetricsTests : XCTestCase
+@end
+
+@implementation OIDMetricsTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDMetrics setObserver:nil];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Tests the bucketing and percentiles of histograms.
+ */
+- (void)testHistogram {
+  OIDMetricsAggregator *aggregator = [[OIDMetricsAggregator alloc] init];
+  for (NSUInteger depth = 0; depth < 100; depth++) {
+    [aggregator pendingActionQueuedWithDepth:depth];
+  }
+  OIDMetricsHistogram *histogram = [aggregator snapshot].pendingActionDepth;
+  XCTAssertEqual(histogram.count, 100);
+  XCTAssertEqual(histogram.sum, 4950);
+  XCTAssertEqual(histogram.mean, 49.5);
+  // 0 | 1 | 2-3 | 4-7 | 8-15 | 16-31 | 32-63 | 64-127
+  NSArray<NSNumber *> *expectedCounts = @[ @1, @1, @2, @4, @8, @16, @32, @36 ];
+  XCTAssertEqualObjects([histogram.bucketCounts subarrayWithRange:NSMakeRange(0, 8)],
+                        expectedCounts);
+  XCTAssertEqual([histogram valueAtPercentile:50], 64);
+  XCTAssertEqual([histogram valueAtPercentile:99], 128);
+  XCTAssertEqual([histogram valueAtPercentile:0], 1);
+
+  [aggregator pendingActionQueuedWithDepth:NSUIntegerMax];
+  XCTAssertEqual([[aggregator snapshot].pendingActionDepth valueAtPercentile:100], UINT64_MAX);
+}
+
+/*! @brief Tests that errors are counted as OAuth errors or other errors, and that resetting
+        snapshots restart aggregation.
+ */
+- (void)testOutcomesAndReset {
+  OIDMetricsAggregator *aggregator = [[OIDMetricsAggregator alloc] init];
+  NSError *OAuthError = [NSError errorWithDomain:OIDOAuthTokenErrorDomain
+                                            code:OIDErrorCodeOAuthTokenInvalidGrant
+                                        userInfo:nil];
+  NSError *networkError = [NSError errorWithDomain:OIDGeneralErrorDomain
+                                              code:OIDErrorCodeNetworkError
+                                          userInfo:nil];
+  [aggregator tokenRefreshDidCompleteWithError:nil];
+  [aggregator tokenRefreshDidCompleteWithError:OAuthError];
+  [aggregator tokenRefreshDidCompleteWithError:networkError];
+  [aggregator tokenRefreshDidCompleteWithError:networkError];
+
+  OIDMetricsOutcomeCounts *refreshes = [aggregator snapshotAndReset].tokenRefreshes;
+  XCTAssertEqual(refreshes.successes, 1);
+  XCTAssertEqual(refreshes.OAuthErrors, 1);
+  XCTAssertEqual(refreshes.otherErrors, 2);
+
+  refreshes = [aggregator snapshot].tokenRefreshes;
+  XCTAssertEqual(refreshes.successes, 0);
+  XCTAssertEqual(refreshes.OAuthErrors, 0);
+  XCTAssertEqual(refreshes.otherErrors, 0);
+}
+
+/*! @brief Tests that token requests are reported to the metrics observer.
+ */
+- (void)testTokenRequestMetrics {
+  OIDMetricsAggregator *aggregator = [[OIDMetricsAggregator alloc] init];
+  [OIDMetrics setObserver:aggregator];
+  NSDictionary *parameters = @{
+    @"access_token" : @"AccessToken",
+    @"token_type" : @"Bearer",
+    @"expires_in" : @3600,
+  };
+  [OIDMockOpenIDProvider setResponseWithStatusCode:200
+                                           headers:nil
+                                              JSON:parameters
+                                           forPath:OIDMockOpenIDProviderTokenPath];
+  NSData *responseData = [NSJSONSerialization dataWithJSONObject:parameters options:0 error:NULL];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token request completes."];
+  OIDTokenRequest *request = [OIDTokenRequestTests testInstance];
+  [OIDAuthorizationService performTokenRequest:request
+                                      callback:^(OIDTokenResponse *_Nullable tokenResponse,
+                                                 NSError *_Nullable error) {
+    XCTAssertNotNil(tokenResponse);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  OIDMetricsSnapshot *snapshot = [aggregator snapshot];
+  XCTAssertEqual([snapshot latencyForEndpoint:OIDMetricsEndpointToken].count, 1);
+  XCTAssertEqual([snapshot bytesSentForEndpoint:OIDMetricsEndpointToken].sum,
+                 [request URLRequest].HTTPBody.length);
+  XCTAssertEqual([snapshot bytesReceivedForEndpoint:OIDMetricsEndpointToken].sum,
+                 responseData.length);
+  XCTAssertEqual([snapshot outcomesForEndpoint:OIDMetricsEndpointToken].successes, 1);
+  XCTAssertEqual([snapshot latencyForEndpoint:OIDMetricsEndpointDiscovery].count, 0);
+}
+
+@end
+
+#pragma GCC diagnostic pop
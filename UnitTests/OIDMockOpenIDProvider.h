@@ -0,0 +1,174 @@
+/*! @file OIDMockOpenIDProvider.h
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OIDAuthState;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! @brief Path of the discovery document, relative to an issuer of the mock provider.
+ */
+extern NSString *const OIDMockOpenIDProviderDiscoveryPath;
+
+/*! @brief Path of the registration endpoint, relative to an issuer of the mock provider.
+ */
+extern NSString *const OIDMockOpenIDProviderRegistrationPath;
+
+/*! @brief Path of the authorization endpoint, relative to an issuer of the mock provider.
+ */
+extern NSString *const OIDMockOpenIDProviderAuthorizationPath;
+
+/*! @brief Path of the token endpoint, relative to an issuer of the mock provider.
+ */
+extern NSString *const OIDMockOpenIDProviderTokenPath;
+
+/*! @brief Path of the userinfo endpoint, relative to an issuer of the mock provider.
+ */
+extern NSString *const OIDMockOpenIDProviderUserinfoPath;
+
+/*! @brief Path of the JSON Web Key Set, relative to an issuer of the mock provider.
+ */
+extern NSString *const OIDMockOpenIDProviderJWKSPath;
+
+/*! @brief An in-process OpenID Provider which answers requests through an @c NSURLProtocol, so
+        that complete flows can run without a network connection.
+    @discussion Serves discovery, dynamic registration, a non-interactive authorization endpoint
+        which redirects immediately with a code, the token endpoint (with client_secret_basic
+        authentication, PKCE and unsigned ID Tokens) and the userinfo endpoint.
+
+        Like the OpenID RP certification server, each issuer is named after a test ID, which selects
+        the fault the provider injects, e.g. @c rp-id_token-aud issues ID Tokens for the wrong
+        audience and @c rp-nonce-invalid returns the wrong nonce. Unknown test IDs behave correctly.
+        Extra faults and latency can be scripted with @c setStatusCode:forPath: and @c setLatency:,
+        and any response with @c setResponseWithStatusCode:headers:JSON:forPath:.
+
+        Requests to other hosts, such as the endpoints of the other test fixtures, are routed by
+        their path as if sent to an issuer without test ID, so that no test reaches the network.
+ */
+@interface OIDMockOpenIDProvider : NSURLProtocol
+
+/*! @brief Returns the issuer of the mock provider for the given test ID.
+    @param testID The test ID which selects the behavior of the provider.
+ */
++ (NSURL *)issuerForTestID:(NSString *)testID;
+
+/*! @brief Returns a session configuration which routes requests to the mock provider.
+ */
++ (NSURLSessionConfiguration *)sessionConfiguration;
+
+/*! @brief Resets the provider, and installs a session using it as the @c OIDURLSessionProvider
+        session.
+ */
++ (void)install;
+
+/*! @brief Restores the shared session as the @c OIDURLSessionProvider session and resets the
+        provider.
+ */
++ (void)uninstall;
+
+/*! @brief Sets the delay before each response is sent. Defaults to 0.
+ */
++ (void)setLatency:(NSTimeInterval)latency;
+
+/*! @brief Makes every request to an endpoint fail with the given HTTP status code.
+    @param statusCode The HTTP status code to answer with, or 0 to stop failing requests.
+    @param path The endpoint path, e.g. @c OIDMockOpenIDProviderTokenPath.
+ */
++ (void)setStatusCode:(NSInteger)statusCode forPath:(NSString *)path;
+
+/*! @brief Answers every request to an endpoint with the given response, instead of the one the
+        provider would send.
+    @param statusCode The HTTP status code, or 0 to stop scripting the responses of the endpoint.
+    @param headers Additional HTTP headers.
+    @param JSON An object to send as the JSON body, if any.
+    @param path The endpoint path, e.g. @c OIDMockOpenIDProviderTokenPath.
+ */
++ (void)setResponseWithStatusCode:(NSInteger)statusCode
+                          headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                             JSON:(nullable id)JSON
+                          forPath:(NSString *)path;
+
+/*! @brief Answers the next request to an endpoint with the given response. The responses queued
+        for an endpoint are sent in order, before any set for every request.
+    @param statusCode The HTTP status code.
+    @param headers Additional HTTP headers.
+    @param JSON An object to send as the JSON body, if any.
+    @param path The endpoint path, e.g. @c OIDMockOpenIDProviderTokenPath.
+ */
++ (void)enqueueResponseWithStatusCode:(NSInteger)statusCode
+                              headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                 JSON:(nullable id)JSON
+                              forPath:(NSString *)path;
+
+/*! @brief Sets whether requests fail with @c NSURLErrorNotConnectedToInternet, as when offline.
+ */
++ (void)setOffline:(BOOL)offline;
+
+/*! @brief Invalidates an access token or refresh token issued by the provider, as when the
+        end-user revokes the grant.
+ */
++ (void)revokeToken:(NSString *)token;
+
+/*! @brief The number of requests the provider has received since it was last reset.
+ */
++ (NSUInteger)requestCount;
+
+/*! @brief The number of requests to an endpoint the provider has received since it was last reset.
+    @param path The endpoint path, e.g. @c OIDMockOpenIDProviderTokenPath.
+ */
++ (NSUInteger)requestCountForPath:(NSString *)path;
+
+/*! @brief The highest number of requests in flight at once since the provider was last reset.
+ */
++ (NSUInteger)maximumConcurrentRequestCount;
+
+/*! @brief The number of requests stopped before they were answered, as when their session task is
+        cancelled, since the provider was last reset.
+ */
++ (NSUInteger)stoppedRequestCount;
+
+/*! @brief The session tasks of the requests received since the provider was last reset, in order.
+ */
++ (NSArray<NSURLSessionTask *> *)receivedTasks;
+
+/*! @brief Returns an authorization state of a client registered with the provider, whose tokens
+        the provider accepts.
+    @param accessToken The access token, which the userinfo endpoint accepts.
+    @param refreshToken The refresh token.
+    @param expiresIn The lifetime of the access token, in seconds.
+    @param subject The subject of the ID Token of the state, or nil for a state without ID Token.
+    @discussion The client and its tokens are forgotten when the provider is reset, so states are
+        created after @c install. Each token response of the provider returns a new refresh token,
+        and the tokens it issues are numbered in order since it was last reset, e.g.
+        @c access_token_1 and @c refresh_token_1.
+ */
++ (OIDAuthState *)authStateWithAccessToken:(NSString *)accessToken
+                              refreshToken:(NSString *)refreshToken
+                                 expiresIn:(NSTimeInterval)expiresIn
+                                   subject:(nullable NSString *)subject;
+
+/*! @brief Returns an authorization state with the access token @c access_token and the refresh
+        token @c refresh_token, without ID Token.
+    @param expiresIn The lifetime of the access token, in seconds.
+ */
++ (OIDAuthState *)authStateWithExpiresIn:(NSTimeInterval)expiresIn;
+
+@end
+
+NS_ASSUME_NONNULL_END
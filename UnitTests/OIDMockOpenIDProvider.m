@@ -0,0 +1,898 @@
+/*! @file OIDMockOpenIDProvider.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthorizationRequest.h"
+#import "Sources/AppAuthCore/OIDAuthorizationResponse.h"
+#import "Sources/AppAuthCore/OIDResponseTypes.h"
+#import "Sources/AppAuthCore/OIDScopes.h"
+#import "Sources/AppAuthCore/OIDServiceConfiguration.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#import "Sources/AppAuthCore/OIDTokenUtilities.h"
+#import "Sources/AppAuthCore/OIDURLSessionProvider.h"
+#endif
+
+NSString *const OIDMockOpenIDProviderDiscoveryPath = @".well-known/openid-configuration";
+
+NSString *const OIDMockOpenIDProviderRegistrationPath = @"registration";
+
+NSString *const OIDMockOpenIDProviderAuthorizationPath = @"authorize";
+
+NSString *const OIDMockOpenIDProviderTokenPath = @"token";
+
+NSString *const OIDMockOpenIDProviderUserinfoPath = @"userinfo";
+
+NSString *const OIDMockOpenIDProviderJWKSPath = @"jwks";
+
+/*! @brief Host of every issuer served by the mock provider.
+ */
+static NSString *const kMockProviderHost = @"op.example.com";
+
+/*! @brief Subject of the single end-user of the mock provider.
+ */
+static NSString *const kMockSubject = @"mock-subject";
+
+/*! @brief Lifetime of the access tokens and ID Tokens issued by the mock provider.
+ */
+static NSTimeInterval const kMockTokenLifetime = 3600;
+
+/*! @brief Test ID of the issuer of the authorization states built by the mock provider.
+ */
+static NSString *const kAuthStateTestID = @"unit-test";
+
+/*! @brief Client ID of the authorization states built by the mock provider.
+ */
+static NSString *const kAuthStateClientID = @"mock-client";
+
+/*! @brief Client secret of the authorization states built by the mock provider.
+ */
+static NSString *const kAuthStateClientSecret = @"mock-client-secret";
+
+/*! @brief Redirect URI of the authorization states built by the mock provider.
+ */
+static NSString *const kAuthStateRedirectURI = @"com.example.app:/oauth2redirect";
+
+/*! @brief Key of the client ID in a stored grant.
+ */
+static NSString *const kGrantClientIDKey = @"client_id";
+
+/*! @brief Key of the redirect URI in a stored grant.
+ */
+static NSString *const kGrantRedirectURIKey = @"redirect_uri";
+
+/*! @brief Key of the scope in a stored grant.
+ */
+static NSString *const kGrantScopeKey = @"scope";
+
+/*! @brief Key of the nonce in a stored grant.
+ */
+static NSString *const kGrantNonceKey = @"nonce";
+
+/*! @brief Key of the PKCE code challenge in a stored grant.
+ */
+static NSString *const kGrantCodeChallengeKey = @"code_challenge";
+
+/*! @brief Key of the test ID in a stored grant.
+ */
+static NSString *const kGrantTestIDKey = @"test_id";
+
+/*! @brief Client secrets of the registered clients, keyed by client ID.
+ */
+static NSMutableDictionary<NSString *, NSString *> *gClientSecrets;
+
+/*! @brief Grants of the issued authorization codes, keyed by code.
+ */
+static NSMutableDictionary<NSString *, NSDictionary *> *gAuthorizationCodes;
+
+/*! @brief Grants of the issued refresh tokens, keyed by refresh token.
+ */
+static NSMutableDictionary<NSString *, NSDictionary *> *gRefreshTokens;
+
+/*! @brief Grants of the issued access tokens, keyed by access token.
+ */
+static NSMutableDictionary<NSString *, NSDictionary *> *gAccessTokens;
+
+/*! @brief A scripted response of the mock provider.
+ */
+@interface OIDMockOpenIDProviderResponse : NSObject
+
+/*! @brief The HTTP status code.
+ */
+@property(nonatomic) NSInteger statusCode;
+
+/*! @brief Additional HTTP headers.
+ */
+@property(nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *headers;
+
+/*! @brief An object to send as the JSON body, if any.
+ */
+@property(nonatomic, strong, nullable) id JSON;
+
+@end
+
+@implementation OIDMockOpenIDProviderResponse
+@end
+
+/*! @brief Scripted responses to every request, keyed by endpoint path.
+ */
+static NSMutableDictionary<NSString *, OIDMockOpenIDProviderResponse *> *gResponses;
+
+/*! @brief Scripted responses to the next requests, keyed by endpoint path.
+ */
+static NSMutableDictionary<NSString *, NSMutableArray<OIDMockOpenIDProviderResponse *> *>
+    *gQueuedResponses;
+
+/*! @brief Scripted delay before each response.
+ */
+static NSTimeInterval gLatency;
+
+/*! @brief Whether requests fail as when offline.
+ */
+static BOOL gOffline;
+
+/*! @brief Number of requests received since the last reset.
+ */
+static NSUInteger gRequestCount;
+
+/*! @brief Number of requests received since the last reset, by endpoint path.
+ */
+static NSCountedSet<NSString *> *gRequestCounts;
+
+/*! @brief Number of requests received but not yet answered or stopped.
+ */
+static NSUInteger gInFlightRequestCount;
+
+/*! @brief Highest value of @c gInFlightRequestCount since the last reset.
+ */
+static NSUInteger gMaximumConcurrentRequestCount;
+
+/*! @brief Number of requests stopped before they were answered since the last reset.
+ */
+static NSUInteger gStoppedRequestCount;
+
+/*! @brief Session tasks of the requests received since the last reset.
+ */
+static NSMutableArray<NSURLSessionTask *> *gReceivedTasks;
+
+/*! @brief Number of token responses issued since the last reset, which numbers the tokens.
+ */
+static NSUInteger gIssuedTokenCount;
+
+@implementation OIDMockOpenIDProvider {
+  /*! @brief The test ID the request is routed to.
+   */
+  NSString *_testID;
+
+  /*! @brief The endpoint path the request is routed to, or nil if it has none.
+   */
+  NSString *_Nullable _path;
+
+  /*! @brief Whether the request was answered or stopped.
+   */
+  BOOL _done;
+}
+
+#pragma mark - Configuration
+
++ (NSURL *)issuerForTestID:(NSString *)testID {
+  NSString *issuer = [NSString stringWithFormat:@"https://%@/%@", kMockProviderHost, testID];
+  return [NSURL URLWithString:issuer];
+}
+
++ (NSURLSessionConfiguration *)sessionConfiguration {
+  NSURLSessionConfiguration *configuration =
+      [NSURLSessionConfiguration ephemeralSessionConfiguration];
+  configuration.protocolClasses = @[ [OIDMockOpenIDProvider class] ];
+  return configuration;
+}
+
++ (void)install {
+  [self reset];
+  NSURLSession *session = [NSURLSession sessionWithConfiguration:[self sessionConfiguration]];
+  [OIDURLSessionProvider setSession:session];
+}
+
++ (void)uninstall {
+  [OIDURLSessionProvider setSession:[NSURLSession sharedSession]];
+  [self reset];
+}
+
++ (void)reset {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gClientSecrets = [NSMutableDictionary dictionary];
+    gAuthorizationCodes = [NSMutableDictionary dictionary];
+    gRefreshTokens = [NSMutableDictionary dictionary];
+    gAccessTokens = [NSMutableDictionary dictionary];
+    gResponses = [NSMutableDictionary dictionary];
+    gQueuedResponses = [NSMutableDictionary dictionary];
+    gLatency = 0;
+    gOffline = NO;
+    gRequestCount = 0;
+    gRequestCounts = [NSCountedSet set];
+    gInFlightRequestCount = 0;
+    gMaximumConcurrentRequestCount = 0;
+    gStoppedRequestCount = 0;
+    gReceivedTasks = [NSMutableArray array];
+    gIssuedTokenCount = 0;
+  }
+}
+
++ (void)setLatency:(NSTimeInterval)latency {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gLatency = latency;
+  }
+}
+
++ (void)setStatusCode:(NSInteger)statusCode forPath:(NSString *)path {
+  [self setResponseWithStatusCode:statusCode
+                          headers:nil
+                             JSON:@{ @"error" : @"server_error" }
+                          forPath:path];
+}
+
++ (void)setResponseWithStatusCode:(NSInteger)statusCode
+                          headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                             JSON:(nullable id)JSON
+                          forPath:(NSString *)path {
+  OIDMockOpenIDProviderResponse *response = nil;
+  if (statusCode) {
+    response = [[OIDMockOpenIDProviderResponse alloc] init];
+    response.statusCode = statusCode;
+    response.headers = headers;
+    response.JSON = JSON;
+  }
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gResponses[path] = response;
+  }
+}
+
++ (void)enqueueResponseWithStatusCode:(NSInteger)statusCode
+                              headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                                 JSON:(nullable id)JSON
+                              forPath:(NSString *)path {
+  OIDMockOpenIDProviderResponse *response = [[OIDMockOpenIDProviderResponse alloc] init];
+  response.statusCode = statusCode;
+  response.headers = headers;
+  response.JSON = JSON;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    if (!gQueuedResponses[path]) {
+      gQueuedResponses[path] = [NSMutableArray array];
+    }
+    [gQueuedResponses[path] addObject:response];
+  }
+}
+
++ (void)setOffline:(BOOL)offline {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gOffline = offline;
+  }
+}
+
++ (void)revokeToken:(NSString *)token {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    [gAccessTokens removeObjectForKey:token];
+    [gRefreshTokens removeObjectForKey:token];
+  }
+}
+
++ (NSUInteger)requestCount {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    return gRequestCount;
+  }
+}
+
++ (NSUInteger)requestCountForPath:(NSString *)path {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    return [gRequestCounts countForObject:path];
+  }
+}
+
++ (NSUInteger)maximumConcurrentRequestCount {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    return gMaximumConcurrentRequestCount;
+  }
+}
+
++ (NSUInteger)stoppedRequestCount {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    return gStoppedRequestCount;
+  }
+}
+
++ (NSArray<NSURLSessionTask *> *)receivedTasks {
+  @synchronized([OIDMockOpenIDProvider class]) {
+    return [gReceivedTasks copy];
+  }
+}
+
+#pragma mark - Authorization states
+
++ (OIDAuthState *)authStateWithAccessToken:(NSString *)accessToken
+                              refreshToken:(NSString *)refreshToken
+                                 expiresIn:(NSTimeInterval)expiresIn
+                                   subject:(nullable NSString *)subject {
+  NSURL *issuer = [self issuerForTestID:kAuthStateTestID];
+  NSURL *authorizationEndpoint =
+      [issuer URLByAppendingPathComponent:OIDMockOpenIDProviderAuthorizationPath];
+  NSURL *tokenEndpoint = [issuer URLByAppendingPathComponent:OIDMockOpenIDProviderTokenPath];
+  NSURL *registrationEndpoint =
+      [issuer URLByAppendingPathComponent:OIDMockOpenIDProviderRegistrationPath];
+  OIDServiceConfiguration *configuration =
+      [[OIDServiceConfiguration alloc] initWithAuthorizationEndpoint:authorizationEndpoint
+                                                       tokenEndpoint:tokenEndpoint
+                                                              issuer:issuer
+                                                registrationEndpoint:registrationEndpoint];
+  NSURL *redirectURL = [NSURL URLWithString:kAuthStateRedirectURI];
+  OIDAuthorizationRequest *authorizationRequest =
+      [[OIDAuthorizationRequest alloc] initWithConfiguration:configuration
+                                                    clientId:kAuthStateClientID
+                                                clientSecret:kAuthStateClientSecret
+                                                      scopes:@[ OIDScopeOpenID ]
+                                                 redirectURL:redirectURL
+                                                responseType:OIDResponseTypeCode
+                                        additionalParameters:nil];
+  NSDictionary *authorizationParameters =
+      @{ @"code" : [NSUUID UUID].UUIDString, @"state" : authorizationRequest.state };
+  OIDAuthorizationResponse *authorizationResponse =
+      [[OIDAuthorizationResponse alloc] initWithRequest:authorizationRequest
+                                             parameters:authorizationParameters];
+
+  NSMutableDictionary *grant = [NSMutableDictionary dictionary];
+  grant[kGrantClientIDKey] = kAuthStateClientID;
+  grant[kGrantRedirectURIKey] = kAuthStateRedirectURI;
+  grant[kGrantScopeKey] = authorizationRequest.scope;
+  grant[kGrantNonceKey] = authorizationRequest.nonce;
+  grant[kGrantTestIDKey] = kAuthStateTestID;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gClientSecrets[kAuthStateClientID] = kAuthStateClientSecret;
+    gAccessTokens[accessToken] = grant;
+    gRefreshTokens[refreshToken] = grant;
+  }
+
+  NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
+  parameters[@"access_token"] = accessToken;
+  parameters[@"token_type"] = @"Bearer";
+  parameters[@"expires_in"] = @(expiresIn);
+  parameters[@"refresh_token"] = refreshToken;
+  if (subject) {
+    parameters[@"id_token"] = [self IDTokenForGrant:grant subject:subject testID:kAuthStateTestID];
+  }
+  OIDTokenResponse *tokenResponse =
+      [[OIDTokenResponse alloc] initWithRequest:[authorizationResponse tokenExchangeRequest]
+                                     parameters:parameters];
+  return [[OIDAuthState alloc] initWithAuthorizationResponse:authorizationResponse
+                                               tokenResponse:tokenResponse];
+}
+
++ (OIDAuthState *)authStateWithExpiresIn:(NSTimeInterval)expiresIn {
+  return [self authStateWithAccessToken:@"access_token"
+                           refreshToken:@"refresh_token"
+                              expiresIn:expiresIn
+                                subject:nil];
+}
+
+#pragma mark - NSURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+  NSString *scheme = request.URL.scheme.lowercaseString;
+  return [scheme isEqualToString:@"https"] || [scheme isEqualToString:@"http"];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+  return request;
+}
+
+- (void)startLoading {
+  NSString *testID = nil;
+  _path = [[self class] pathOfURL:self.request.URL testID:&testID];
+  _testID = testID ?: @"";
+  NSTimeInterval latency;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gRequestCount++;
+    if (_path) {
+      [gRequestCounts addObject:_path];
+    }
+    if (self.task) {
+      [gReceivedTasks addObject:self.task];
+    }
+    gInFlightRequestCount++;
+    gMaximumConcurrentRequestCount = MAX(gMaximumConcurrentRequestCount, gInFlightRequestCount);
+    latency = gLatency;
+  }
+  if (latency > 0) {
+    // Runs on the loading thread's run loop, where the client expects to be called.
+    [self performSelector:@selector(respond) withObject:nil afterDelay:latency];
+  } else {
+    [self respond];
+  }
+}
+
+- (void)stopLoading {
+  [NSObject cancelPreviousPerformRequestsWithTarget:self];
+  if ([self markDone]) {
+    @synchronized([OIDMockOpenIDProvider class]) {
+      gStoppedRequestCount++;
+    }
+  }
+}
+
+#pragma mark - Routing
+
+/*! @brief Returns the endpoint path of a URL, or nil if it has none.
+    @param URL The URL of the request.
+    @param testID Set to the test ID of the issuer, which is empty for hosts other than the mock
+        provider's.
+ */
++ (nullable NSString *)pathOfURL:(NSURL *)URL testID:(NSString *_Nullable *_Nonnull)testID {
+  NSArray<NSString *> *pathComponents = URL.pathComponents;
+  NSUInteger firstEndpointComponent = 1;
+  *testID = @"";
+  if ([URL.host isEqualToString:kMockProviderHost]) {
+    if (pathComponents.count < 3) {
+      return nil;
+    }
+    *testID = pathComponents[1];
+    firstEndpointComponent = 2;
+  } else if (pathComponents.count < 2) {
+    return nil;
+  }
+  NSRange endpointRange =
+      NSMakeRange(firstEndpointComponent, pathComponents.count - firstEndpointComponent);
+  return [[pathComponents subarrayWithRange:endpointRange] componentsJoinedByString:@"/"];
+}
+
+/*! @brief Marks the request as answered or stopped.
+    @return NO if it already was.
+ */
+- (BOOL)markDone {
+  if (_done) {
+    return NO;
+  }
+  _done = YES;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gInFlightRequestCount--;
+  }
+  return YES;
+}
+
+/*! @brief Answers the request, after injecting any scripted fault.
+ */
+- (void)respond {
+  NSString *testID = _testID;
+  NSString *path = _path;
+  if (!path) {
+    [self finishWithStatusCode:404 headers:nil JSON:nil];
+    return;
+  }
+
+  BOOL offline;
+  OIDMockOpenIDProviderResponse *scriptedResponse;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    offline = gOffline;
+    NSMutableArray<OIDMockOpenIDProviderResponse *> *queuedResponses = gQueuedResponses[path];
+    scriptedResponse = queuedResponses.firstObject;
+    if (scriptedResponse) {
+      [queuedResponses removeObjectAtIndex:0];
+    } else {
+      scriptedResponse = gResponses[path];
+    }
+  }
+  if (offline) {
+    [self markDone];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain
+                                         code:NSURLErrorNotConnectedToInternet
+                                     userInfo:nil];
+    [self.client URLProtocol:self didFailWithError:error];
+    return;
+  }
+  if (scriptedResponse) {
+    [self finishWithStatusCode:scriptedResponse.statusCode
+                       headers:scriptedResponse.headers
+                          JSON:scriptedResponse.JSON];
+    return;
+  }
+
+  if ([path isEqualToString:OIDMockOpenIDProviderDiscoveryPath]) {
+    [self respondToDiscoveryRequestForTestID:testID];
+  } else if ([path isEqualToString:OIDMockOpenIDProviderRegistrationPath]) {
+    [self respondToRegistrationRequestForTestID:testID];
+  } else if ([path isEqualToString:OIDMockOpenIDProviderAuthorizationPath]) {
+    [self respondToAuthorizationRequestForTestID:testID];
+  } else if ([path isEqualToString:OIDMockOpenIDProviderTokenPath]) {
+    [self respondToTokenRequestForTestID:testID];
+  } else if ([path isEqualToString:OIDMockOpenIDProviderUserinfoPath]) {
+    [self respondToUserinfoRequestForTestID:testID];
+  } else if ([path isEqualToString:OIDMockOpenIDProviderJWKSPath]) {
+    [self finishWithStatusCode:200 headers:nil JSON:@{ @"keys" : @[] }];
+  } else {
+    [self finishWithStatusCode:404 headers:nil JSON:nil];
+  }
+}
+
+/*! @brief Sends a response to the client and finishes loading.
+    @param statusCode The HTTP status code.
+    @param headers Additional HTTP headers.
+    @param JSON An object to send as the JSON body, if any.
+ */
+- (void)finishWithStatusCode:(NSInteger)statusCode
+                     headers:(nullable NSDictionary<NSString *, NSString *> *)headers
+                        JSON:(nullable id)JSON {
+  NSMutableDictionary<NSString *, NSString *> *headerFields = [NSMutableDictionary dictionary];
+  NSData *body = nil;
+  if (JSON) {
+    body = [NSJSONSerialization dataWithJSONObject:JSON options:0 error:NULL];
+    headerFields[@"Content-Type"] = @"application/json";
+  }
+  [headerFields addEntriesFromDictionary:headers];
+
+  NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                            statusCode:statusCode
+                                                           HTTPVersion:@"HTTP/1.1"
+                                                          headerFields:headerFields];
+  [self markDone];
+  [self.client URLProtocol:self
+        didReceiveResponse:response
+        cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+  if (body) {
+    [self.client URLProtocol:self didLoadData:body];
+  }
+  [self.client URLProtocolDidFinishLoading:self];
+}
+
+#pragma mark - Endpoints
+
+- (void)respondToDiscoveryRequestForTestID:(NSString *)testID {
+  NSURL *issuer = [[self class] issuerForTestID:testID];
+  NSString *(^endpoint)(NSString *) = ^(NSString *path) {
+    return [issuer URLByAppendingPathComponent:path].absoluteString;
+  };
+  NSDictionary *discoveryDocument = @{
+    @"issuer" : issuer.absoluteString,
+    @"authorization_endpoint" : endpoint(OIDMockOpenIDProviderAuthorizationPath),
+    @"token_endpoint" : endpoint(OIDMockOpenIDProviderTokenPath),
+    @"registration_endpoint" : endpoint(OIDMockOpenIDProviderRegistrationPath),
+    @"userinfo_endpoint" : endpoint(OIDMockOpenIDProviderUserinfoPath),
+    @"jwks_uri" : endpoint(OIDMockOpenIDProviderJWKSPath),
+    @"response_types_supported" : @[ @"code" ],
+    @"subject_types_supported" : @[ @"public" ],
+    @"id_token_signing_alg_values_supported" : @[ @"none" ],
+    @"token_endpoint_auth_methods_supported" : @[ @"client_secret_basic" ],
+    @"code_challenge_methods_supported" : @[ @"S256" ],
+  };
+  [self finishWithStatusCode:200 headers:nil JSON:discoveryDocument];
+}
+
+- (void)respondToRegistrationRequestForTestID:(NSString *)testID {
+  NSData *body = [[self class] bodyOfRequest:self.request];
+  NSDictionary *metadata = body ? [NSJSONSerialization JSONObjectWithData:body
+                                                                  options:0
+                                                                    error:NULL] : nil;
+  if (![metadata isKindOfClass:[NSDictionary class]]) {
+    [self finishWithStatusCode:400
+                       headers:nil
+                          JSON:@{ @"error" : @"invalid_client_metadata" }];
+    return;
+  }
+
+  // The signature tests need signed ID Tokens, so reject clients which ask for unsigned ones, as
+  // the certification server does.
+  BOOL requiresSignature = [testID hasPrefix:@"rp-id_token-kid"]
+      || [testID rangeOfString:@"rs256"].location != NSNotFound;
+  if (requiresSignature && [metadata[@"id_token_signed_response_alg"] isEqual:@"none"]) {
+    NSDictionary *error = @{
+      @"error" : @"invalid_client_metadata",
+      @"error_description" : @"This test requires signed ID Tokens.",
+    };
+    [self finishWithStatusCode:400 headers:nil JSON:error];
+    return;
+  }
+
+  NSString *clientID = [NSUUID UUID].UUIDString;
+  NSString *clientSecret = [NSUUID UUID].UUIDString;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gClientSecrets[clientID] = clientSecret;
+  }
+
+  NSMutableDictionary *response = [metadata mutableCopy];
+  response[@"client_id"] = clientID;
+  response[@"client_id_issued_at"] = @((long long)[[NSDate date] timeIntervalSince1970]);
+  response[@"client_secret"] = clientSecret;
+  response[@"client_secret_expires_at"] = @0;
+  if (!response[@"token_endpoint_auth_method"]) {
+    response[@"token_endpoint_auth_method"] = @"client_secret_basic";
+  }
+  [self finishWithStatusCode:201 headers:nil JSON:response];
+}
+
+- (void)respondToAuthorizationRequestForTestID:(NSString *)testID {
+  NSURLComponents *requestComponents =
+      [NSURLComponents componentsWithURL:self.request.URL resolvingAgainstBaseURL:NO];
+  NSDictionary<NSString *, NSString *> *parameters =
+      [[self class] dictionaryWithQueryItems:requestComponents.queryItems];
+
+  NSString *clientID = parameters[@"client_id"];
+  NSURL *redirectURI =
+      parameters[@"redirect_uri"] ? [NSURL URLWithString:parameters[@"redirect_uri"]] : nil;
+  BOOL registered;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    registered = clientID && gClientSecrets[clientID];
+  }
+  if (!registered || !redirectURI) {
+    // Errors which can't be returned to the client are shown to the user instead.
+    [self finishWithStatusCode:400 headers:nil JSON:@{ @"error" : @"invalid_request" }];
+    return;
+  }
+
+  NSMutableArray<NSURLQueryItem *> *redirectParameters = [NSMutableArray array];
+  if (![parameters[@"response_type"] isEqualToString:@"code"]) {
+    [redirectParameters addObject:[NSURLQueryItem queryItemWithName:@"error"
+                                                              value:@"unsupported_response_type"]];
+  } else {
+    NSString *code = [NSUUID UUID].UUIDString;
+    NSMutableDictionary *grant = [NSMutableDictionary dictionary];
+    grant[kGrantClientIDKey] = clientID;
+    grant[kGrantRedirectURIKey] = parameters[@"redirect_uri"];
+    grant[kGrantScopeKey] = parameters[@"scope"];
+    grant[kGrantNonceKey] = parameters[@"nonce"];
+    grant[kGrantCodeChallengeKey] = parameters[@"code_challenge"];
+    grant[kGrantTestIDKey] = testID;
+    @synchronized([OIDMockOpenIDProvider class]) {
+      gAuthorizationCodes[code] = grant;
+    }
+    [redirectParameters addObject:[NSURLQueryItem queryItemWithName:@"code" value:code]];
+  }
+  if (parameters[@"state"]) {
+    [redirectParameters addObject:[NSURLQueryItem queryItemWithName:@"state"
+                                                              value:parameters[@"state"]]];
+  }
+
+  NSURLComponents *redirectComponents =
+      [NSURLComponents componentsWithURL:redirectURI resolvingAgainstBaseURL:NO];
+  redirectComponents.queryItems =
+      [redirectComponents.queryItems ?: @[] arrayByAddingObjectsFromArray:redirectParameters];
+  [self finishWithStatusCode:302
+                     headers:@{ @"Location" : redirectComponents.URL.absoluteString }
+                        JSON:nil];
+}
+
+- (void)respondToTokenRequestForTestID:(NSString *)testID {
+  NSDictionary<NSString *, NSString *> *parameters =
+      [[self class] formParametersOfRequest:self.request];
+
+  // Authenticates the client, using client_secret_basic for confidential clients.
+  NSString *clientID = parameters[@"client_id"];
+  NSString *clientSecret = nil;
+  NSString *authorization = [self.request valueForHTTPHeaderField:@"Authorization"];
+  if ([authorization hasPrefix:@"Basic "]) {
+    NSData *credentialsData =
+        [[NSData alloc] initWithBase64EncodedString:[authorization substringFromIndex:6] options:0];
+    NSString *credentials =
+        [[NSString alloc] initWithData:credentialsData encoding:NSUTF8StringEncoding];
+    NSRange separator = [credentials rangeOfString:@":"];
+    if (separator.location != NSNotFound) {
+      clientID = [[self class] formDecode:[credentials substringToIndex:separator.location]];
+      clientSecret = [[self class] formDecode:
+          [credentials substringFromIndex:separator.location + separator.length]];
+    }
+  }
+  NSString *expectedSecret;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    expectedSecret = clientID ? gClientSecrets[clientID] : nil;
+  }
+  if (!expectedSecret || ![clientSecret isEqualToString:expectedSecret]) {
+    [self finishWithStatusCode:401
+                       headers:@{ @"WWW-Authenticate" : @"Basic" }
+                          JSON:@{ @"error" : @"invalid_client" }];
+    return;
+  }
+
+  NSDictionary *grant = nil;
+  NSString *grantType = parameters[@"grant_type"];
+  if ([grantType isEqualToString:@"authorization_code"]) {
+    NSString *code = parameters[@"code"];
+    @synchronized([OIDMockOpenIDProvider class]) {
+      // Authorization codes can only be used once.
+      grant = code ? gAuthorizationCodes[code] : nil;
+      if (code) {
+        [gAuthorizationCodes removeObjectForKey:code];
+      }
+    }
+    NSString *codeChallenge = grant[kGrantCodeChallengeKey];
+    NSString *codeVerifier = parameters[@"code_verifier"];
+    if (codeChallenge) {
+      NSString *expectedChallenge = codeVerifier
+          ? [OIDTokenUtilities encodeBase64urlNoPadding:[OIDTokenUtilities sha256:codeVerifier]]
+          : nil;
+      if (![codeChallenge isEqualToString:expectedChallenge]) {
+        grant = nil;
+      }
+    }
+    if (![grant[kGrantRedirectURIKey] isEqual:parameters[@"redirect_uri"]]) {
+      grant = nil;
+    }
+  } else if ([grantType isEqualToString:@"refresh_token"]) {
+    NSString *refreshToken = parameters[@"refresh_token"];
+    @synchronized([OIDMockOpenIDProvider class]) {
+      grant = refreshToken ? gRefreshTokens[refreshToken] : nil;
+    }
+  } else {
+    [self finishWithStatusCode:400 headers:nil JSON:@{ @"error" : @"unsupported_grant_type" }];
+    return;
+  }
+  if (!grant || ![grant[kGrantClientIDKey] isEqualToString:clientID]) {
+    [self finishWithStatusCode:400 headers:nil JSON:@{ @"error" : @"invalid_grant" }];
+    return;
+  }
+
+  NSString *accessToken;
+  NSString *refreshToken;
+  @synchronized([OIDMockOpenIDProvider class]) {
+    gIssuedTokenCount++;
+    accessToken = [NSString stringWithFormat:@"access_token_%lu", (unsigned long)gIssuedTokenCount];
+    refreshToken =
+        [NSString stringWithFormat:@"refresh_token_%lu", (unsigned long)gIssuedTokenCount];
+    gAccessTokens[accessToken] = grant;
+    gRefreshTokens[refreshToken] = grant;
+  }
+
+  NSMutableDictionary *response = [NSMutableDictionary dictionary];
+  response[@"access_token"] = accessToken;
+  response[@"token_type"] = @"Bearer";
+  response[@"expires_in"] = @(kMockTokenLifetime);
+  response[@"refresh_token"] = refreshToken;
+  NSArray<NSString *> *scopes = [grant[kGrantScopeKey] componentsSeparatedByString:@" "];
+  if ([grantType isEqualToString:@"authorization_code"] && [scopes containsObject:@"openid"]) {
+    response[@"id_token"] =
+        [[self class] IDTokenForGrant:grant subject:kMockSubject testID:testID];
+  }
+  [self finishWithStatusCode:200 headers:@{ @"Cache-Control" : @"no-store" } JSON:response];
+}
+
+- (void)respondToUserinfoRequestForTestID:(NSString *)testID {
+  NSString *authorization = [self.request valueForHTTPHeaderField:@"Authorization"];
+  NSDictionary *grant = nil;
+  if ([authorization hasPrefix:@"Bearer "]) {
+    @synchronized([OIDMockOpenIDProvider class]) {
+      grant = gAccessTokens[[authorization substringFromIndex:7]];
+    }
+  }
+  if (!grant) {
+    [self finishWithStatusCode:401
+                       headers:@{ @"WWW-Authenticate" : @"Bearer error=\"invalid_token\"" }
+                          JSON:nil];
+    return;
+  }
+
+  NSMutableDictionary *claims = [NSMutableDictionary dictionary];
+  claims[@"sub"] = kMockSubject;
+  if ([testID isEqualToString:@"rp-userinfo-bad-sub-claim"]) {
+    claims[@"sub"] = @"bad-sub";
+  }
+  NSArray<NSString *> *scopes = [grant[kGrantScopeKey] componentsSeparatedByString:@" "];
+  if ([scopes containsObject:@"profile"]) {
+    claims[@"name"] = @"Mock User";
+  }
+  if ([scopes containsObject:@"email"]) {
+    claims[@"email"] = @"mock.user@example.com";
+    claims[@"email_verified"] = @YES;
+  }
+  if ([scopes containsObject:@"address"]) {
+    claims[@"address"] = @{ @"country" : @"US" };
+  }
+  if ([scopes containsObject:@"phone"]) {
+    claims[@"phone_number"] = @"+1 555 0100";
+  }
+  [self finishWithStatusCode:200 headers:nil JSON:claims];
+}
+
+#pragma mark - Helpers
+
+/*! @brief Builds an unsigned ID Token for the grant, with the fault selected by the test ID.
+ */
++ (NSString *)IDTokenForGrant:(NSDictionary *)grant
+                      subject:(NSString *)subject
+                       testID:(NSString *)testID {
+  long long now = (long long)[[NSDate date] timeIntervalSince1970];
+  NSMutableDictionary *claims = [NSMutableDictionary dictionary];
+  claims[@"iss"] = [self issuerForTestID:testID].absoluteString;
+  claims[@"sub"] = subject;
+  claims[@"aud"] = grant[kGrantClientIDKey];
+  claims[@"exp"] = @(now + (long long)kMockTokenLifetime);
+  claims[@"iat"] = @(now);
+  claims[@"nonce"] = grant[kGrantNonceKey];
+
+  if ([testID isEqualToString:@"rp-id_token-aud"]) {
+    claims[@"aud"] = @"invalid-client-id";
+  } else if ([testID isEqualToString:@"rp-id_token-iat"]) {
+    [claims removeObjectForKey:@"iat"];
+  } else if ([testID isEqualToString:@"rp-id_token-sub"]) {
+    [claims removeObjectForKey:@"sub"];
+  } else if ([testID isEqualToString:@"rp-id_token-issuer-mismatch"]) {
+    claims[@"iss"] = [self issuerForTestID:@"invalid-issuer"].absoluteString;
+  } else if ([testID isEqualToString:@"rp-nonce-invalid"]) {
+    claims[@"nonce"] = @"invalid-nonce";
+  }
+
+  NSDictionary *header = @{ @"alg" : @"none", @"typ" : @"JWT" };
+  NSData *headerData = [NSJSONSerialization dataWithJSONObject:header options:0 error:NULL];
+  NSData *claimsData = [NSJSONSerialization dataWithJSONObject:claims options:0 error:NULL];
+  return [NSString stringWithFormat:@"%@.%@.",
+                                    [OIDTokenUtilities encodeBase64urlNoPadding:headerData],
+                                    [OIDTokenUtilities encodeBase64urlNoPadding:claimsData]];
+}
+
+/*! @brief Returns the body of a request, which @c NSURLSession passes to protocols as a stream.
+ */
++ (nullable NSData *)bodyOfRequest:(NSURLRequest *)request {
+  if (request.HTTPBody) {
+    return request.HTTPBody;
+  }
+  NSInputStream *stream = request.HTTPBodyStream;
+  if (!stream) {
+    return nil;
+  }
+  NSMutableData *body = [NSMutableData data];
+  uint8_t buffer[4096];
+  [stream open];
+  NSInteger length;
+  while ((length = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+    [body appendBytes:buffer length:(NSUInteger)length];
+  }
+  [stream close];
+  return body;
+}
+
+/*! @brief Parses the "application/x-www-form-urlencoded" body of a request.
+ */
++ (NSDictionary<NSString *, NSString *> *)formParametersOfRequest:(NSURLRequest *)request {
+  NSData *body = [self bodyOfRequest:request];
+  NSString *bodyString = body ? [[NSString alloc] initWithData:body
+                                                      encoding:NSUTF8StringEncoding] : nil;
+  NSURLComponents *components = [[NSURLComponents alloc] init];
+  components.percentEncodedQuery =
+      [bodyString stringByReplacingOccurrencesOfString:@"+" withString:@"%20"];
+  return [self dictionaryWithQueryItems:components.queryItems];
+}
+
+/*! @brief Flattens query items into a dictionary, keeping the first value of each name.
+ */
++ (NSDictionary<NSString *, NSString *> *)dictionaryWithQueryItems:
+    (nullable NSArray<NSURLQueryItem *> *)queryItems {
+  NSMutableDictionary<NSString *, NSString *> *parameters = [NSMutableDictionary dictionary];
+  for (NSURLQueryItem *item in queryItems) {
+    if (item.value && !parameters[item.name]) {
+      parameters[item.name] = item.value;
+    }
+  }
+  return parameters;
+}
+
+/*! @brief Decodes an "application/x-www-form-urlencoded" value.
+ */
++ (nullable NSString *)formDecode:(NSString *)value {
+  return [value stringByReplacingOccurrencesOfString:@"+" withString:@" "]
+      .stringByRemovingPercentEncoding;
+}
+
+@end
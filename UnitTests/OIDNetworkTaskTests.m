@@ -0,0 +1,289 @@
+/*! @file OIDNetworkTaskTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+#import "OIDRegistrationRequestTests.h"
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDNetworkTask.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for cancelling network operations, and for their deadlines.
+ */
+@interface OIDNetworkTaskTests : XCTestCase
+@end
+
+@implementation OIDNetworkTaskTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+  // Requests are never answered during a test, as by a server which does not respond in time.
+  [OIDMockOpenIDProvider setLatency:3600];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Asserts that an error reports a cancelled operation, or one which missed its deadline.
+    @param error The error.
+    @param code The expected @c NSURLErrorDomain code of the underlying error.
+ */
+- (void)assertError:(nullable NSError *)error hasUnderlyingURLErrorCode:(NSInteger)code {
+  XCTAssertEqualObjects(error.domain, OIDGeneralErrorDomain);
+  XCTAssertEqual(error.code, OIDErrorCodeNetworkError);
+  NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+  XCTAssertEqualObjects(underlyingError.domain, NSURLErrorDomain);
+  XCTAssertEqual(underlyingError.code, code);
+}
+
+/*! @brief Returns an expectation which fails the test if it is fulfilled more than once.
+ */
+- (XCTestExpectation *)callbackExpectation {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback called."];
+  expectation.assertForOverFulfill = YES;
+  return expectation;
+}
+
+/*! @brief Lets the main queue run briefly, so that any extra callback is called.
+ */
+- (void)waitForLateCallbacks {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Waited."];
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)),
+                 dispatch_get_main_queue(), ^{
+    [expectation fulfill];
+  });
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
+/*! @brief Returns an expectation fulfilled once a request was stopped before being answered, as
+        when its session task is cancelled.
+ */
+- (XCTestExpectation *)stoppedRequestExpectation {
+  NSPredicate *requestStopped = [NSPredicate predicateWithBlock:^BOOL(id object,
+                                                                      NSDictionary *bindings) {
+    return [OIDMockOpenIDProvider stoppedRequestCount] > 0;
+  }];
+  return [self expectationForPredicate:requestStopped evaluatedWithObject:self handler:nil];
+}
+
+- (void)testCancelTokenRequest {
+  XCTestExpectation *callbackExpectation = [self callbackExpectation];
+  [self stoppedRequestExpectation];
+  OIDNetworkTask *networkTask =
+      [OIDAuthorizationService performTokenRequest:[OIDTokenRequestTests testInstance]
+                                          callback:^(OIDTokenResponse *_Nullable tokenResponse,
+                                                     NSError *_Nullable error) {
+    XCTAssertNil(tokenResponse);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorCancelled];
+    [callbackExpectation fulfill];
+  }];
+  XCTAssertFalse(networkTask.isFinished);
+
+  [networkTask cancel];
+  XCTAssertTrue(networkTask.isCancelled);
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [self waitForLateCallbacks];
+}
+
+- (void)testTokenRequestDeadline {
+  XCTestExpectation *callbackExpectation = [self callbackExpectation];
+  [self stoppedRequestExpectation];
+  OIDNetworkTask *networkTask =
+      [OIDAuthorizationService performTokenRequest:[OIDTokenRequestTests testInstance]
+                     originalAuthorizationResponse:nil
+                                           timeout:0.1
+                                          callback:^(OIDTokenResponse *_Nullable tokenResponse,
+                                                     NSError *_Nullable error) {
+    XCTAssertNil(tokenResponse);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorTimedOut];
+    [callbackExpectation fulfill];
+  }];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertTrue(networkTask.isCancelled);
+  [self waitForLateCallbacks];
+}
+
+- (void)testCancelRegistrationRequest {
+  XCTestExpectation *callbackExpectation = [self callbackExpectation];
+  [self stoppedRequestExpectation];
+  OIDNetworkTask *networkTask =
+      [OIDAuthorizationService performRegistrationRequest:[OIDRegistrationRequestTests testInstance]
+                                               completion:^(OIDRegistrationResponse *_Nullable
+                                                                registrationResponse,
+                                                            NSError *_Nullable error) {
+    XCTAssertNil(registrationResponse);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorCancelled];
+    [callbackExpectation fulfill];
+  }];
+
+  [networkTask cancel];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [self waitForLateCallbacks];
+}
+
+/*! @brief Tests that cancelling one of the discoveries sharing a fetch only completes that one, and
+        that the fetch is cancelled along with the last of them.
+ */
+- (void)testCancelSharedDiscovery {
+  NSString *discoveryURLString =
+      [NSString stringWithFormat:@"https://%@.example.com/.well-known/openid-configuration",
+                                 [NSUUID UUID].UUIDString];
+  NSURL *discoveryURL = [NSURL URLWithString:discoveryURLString];
+  __block NSUInteger completionCount = 0;
+  OIDDiscoveryCallback completion =
+      ^(OIDServiceConfiguration *_Nullable configuration, NSError *_Nullable error) {
+    XCTAssertNil(configuration);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorCancelled];
+    completionCount++;
+  };
+  OIDNetworkTask *firstDiscovery =
+      [OIDAuthorizationService discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                                                completion:completion];
+  OIDNetworkTask *secondDiscovery =
+      [OIDAuthorizationService discoverServiceConfigurationForDiscoveryURL:discoveryURL
+                                                                completion:completion];
+
+  [firstDiscovery cancel];
+  [self waitForLateCallbacks];
+  XCTAssertEqual(completionCount, 1);
+  XCTAssertFalse(secondDiscovery.isFinished);
+
+  [self stoppedRequestExpectation];
+  [secondDiscovery cancel];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [self waitForLateCallbacks];
+  XCTAssertEqual(completionCount, 2);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 1);
+}
+
+/*! @brief Tests that cancelling one of the actions waiting for a refresh only calls that one, and
+        that a refresh which was sent is not cancelled along with the last of them.
+ */
+- (void)testCancelActionsWaitingForRefresh {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:0];
+  __block NSUInteger actionCount = 0;
+  OIDAuthStateAction action =
+      ^(NSString *_Nullable accessToken, NSString *_Nullable idToken, NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorCancelled];
+    actionCount++;
+  };
+  OIDNetworkTask *firstAction = [authState performActionWithFreshTokens:action];
+  OIDNetworkTask *secondAction = [authState performActionWithFreshTokens:action];
+
+  [firstAction cancel];
+  [self waitForLateCallbacks];
+  XCTAssertEqual(actionCount, 1);
+  XCTAssertFalse(secondAction.isFinished);
+
+  [secondAction cancel];
+  [self waitForLateCallbacks];
+  XCTAssertEqual(actionCount, 2);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 1);
+  XCTAssertEqual([OIDMockOpenIDProvider stoppedRequestCount], 0);
+}
+
+/*! @brief Tests that cancelling the only action waiting for a refresh which the server already
+        received lets the refresh complete, so that the refresh token it rotated is stored.
+ */
+- (void)testCancellingActionKeepsRotatedRefreshToken {
+  [OIDMockOpenIDProvider setLatency:0.3];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:0];
+  XCTestExpectation *actionExpectation = [self callbackExpectation];
+  OIDNetworkTask *networkTask =
+      [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                                NSString *_Nullable idToken,
+                                                NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorCancelled];
+    [actionExpectation fulfill];
+  }];
+  NSPredicate *requestReceived = [NSPredicate predicateWithBlock:^BOOL(id object,
+                                                                       NSDictionary *bindings) {
+    return [OIDMockOpenIDProvider requestCount] > 0;
+  }];
+  XCTestExpectation *requestExpectation =
+      [self expectationForPredicate:requestReceived evaluatedWithObject:self handler:nil];
+  [self waitForExpectations:@[ requestExpectation ] timeout:5];
+
+  [networkTask cancel];
+  [self waitForExpectations:@[ actionExpectation ] timeout:5];
+  [self expectationForPredicate:[NSPredicate predicateWithFormat:@"refreshToken == %@",
+                                                                 @"refresh_token_1"]
+            evaluatedWithObject:authState
+                        handler:nil];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqualObjects(authState.accessToken, @"access_token_1");
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 1);
+  XCTAssertEqual([OIDMockOpenIDProvider stoppedRequestCount], 0);
+}
+
+- (void)testActionWaitingForRefreshDeadline {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:0];
+  XCTestExpectation *actionExpectation = [self callbackExpectation];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    [self assertError:error hasUnderlyingURLErrorCode:NSURLErrorTimedOut];
+    [actionExpectation fulfill];
+  }
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                  timeout:0.1];
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [self waitForLateCallbacks];
+  XCTAssertEqual([OIDMockOpenIDProvider stoppedRequestCount], 0);
+}
+
+- (void)testCancellingFinishedTaskHasNoEffect {
+  __block NSUInteger cancellationCount = 0;
+  OIDNetworkTask *networkTask =
+      [[OIDNetworkTask alloc] initWithTimeout:0 cancellationHandler:^(NSError *error) {
+    cancellationCount++;
+  }];
+  XCTAssertTrue([networkTask finish]);
+  XCTAssertFalse([networkTask finish]);
+
+  [networkTask cancel];
+  XCTAssertEqual(cancellationCount, 0);
+  XCTAssertTrue(networkTask.isFinished);
+  XCTAssertFalse(networkTask.isCancelled);
+}
+
+@end
+
+#pragma GCC diagnostic pop
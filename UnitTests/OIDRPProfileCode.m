@@ -18,6 +18,8 @@
 
 #import "OIDRPProfileCode.h"
 
+#import "OIDMockOpenIDProvider.h"
+
 #import "OIDAuthorizationRequest.h"
 #import "OIDAuthorizationResponse.h"
 #import "OIDAuthorizationService.h"
@@ -34,9 +36,9 @@
 
 static NSString *const kRedirectURI = @"com.example.app:/oauth2redirect/example-provider";
 
-// Open ID RP Certification test server http://openid.net/certification/rp_testing/
-static NSString *const kTestURIBase =
-    @"https://rp.certification.openid.net:8080/appauth-ios-macos/";
+/*! @brief Number of complete code flows performed in each iteration of the throughput benchmark.
+ */
+static NSUInteger const kThroughputFlowCount = 20;
 
 /*! @brief A UI Coordinator for testing, has no user agent and doesn't support user interaction.
         Simply performs the authorization request as a GET request, and looks for a redirect in
@@ -55,7 +57,7 @@ static NSString *const kTestURIBase =
   _session = session;
   NSURL *requestURL = [request externalUserAgentRequestURL];
   NSMutableURLRequest *URLRequest = [[NSURLRequest requestWithURL:requestURL] mutableCopy];
-  NSURLSessionConfiguration* config = [NSURLSessionConfiguration defaultSessionConfiguration];
+  NSURLSessionConfiguration* config = [OIDMockOpenIDProvider sessionConfiguration];
   _urlSession = [NSURLSession sessionWithConfiguration:config delegate:self delegateQueue:nil];
   [[_urlSession dataTaskWithRequest:URLRequest
                   completionHandler:^(NSData *_Nullable data,
@@ -118,15 +120,18 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
 @implementation OIDRPProfileCode
 
 - (void)setUp {
-  XCTSkip("Need to migrate to the new OpenID conformance testing system.");
   [super setUp];
+  // Runs the OpenID RP certification tests against an in-process provider which mirrors the
+  // behavior of the certification server http://openid.net/certification/rp_testing/
+  [OIDMockOpenIDProvider install];
 }
 
 - (void)tearDown {
-  XCTSkip("Need to migrate to the new OpenID conformance testing system.");
+  [OIDMockOpenIDProvider uninstall];
+  if (_logFile) {
+    [self endCertificationTest];
+  }
   [super tearDown];
-  
-  [self endCertificationTest];
 }
 
 /*! @brief Performs client registration.
@@ -188,8 +193,6 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
                               scope:(NSArray<NSString *> *)scope
                          completion:(CodeExchangeCompletion)completion {
 
-  NSString *issuerString = [kTestURIBase stringByAppendingString:test];
-
   XCTestExpectation *expectation =
   [self expectationWithDescription:@"Discovery and registration should complete."];
   XCTestExpectation *auth_complete =
@@ -197,7 +200,7 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
   XCTestExpectation *token_exchange =
   [self expectationWithDescription:@"Token Exchange should complete."];
 
-  NSURL *issuer = [NSURL URLWithString:issuerString];
+  NSURL *issuer = [OIDMockOpenIDProvider issuerForTestID:test];
   
   [self doRegistrationWithIssuer:issuer callback:^(OIDServiceConfiguration *configuration,
                                                    OIDRegistrationResponse *registrationResponse,
@@ -266,7 +269,6 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
 }
 
 - (void)testRP_response_type_code {
-  XCTSkip("Not working at the moment.");
   NSString *testName = @"rp-response_type-code";
   [self startCertificationTest:testName];
   [self codeFlowWithExchangeExpectSuccessForTest:testName];
@@ -372,8 +374,7 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
       NSString *authorizationHeaderValue = [NSString stringWithFormat:@"Bearer %@", accessToken];
       [request addValue:authorizationHeaderValue forHTTPHeaderField:@"Authorization"];
 
-      NSURLSessionConfiguration *configuration =
-      [NSURLSessionConfiguration defaultSessionConfiguration];
+      NSURLSessionConfiguration *configuration = [OIDMockOpenIDProvider sessionConfiguration];
       NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration
                                                             delegate:nil
                                                        delegateQueue:nil];
@@ -487,12 +488,10 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
 - (void)skippedTest:(NSString *)testName {
   [self startCertificationTest:testName];
 
-  NSString *issuerString = [kTestURIBase stringByAppendingString:testName];
-
   XCTestExpectation *expectation =
     [self expectationWithDescription:@"Discovery and registration should complete."];
 
-  NSURL *issuer = [NSURL URLWithString:issuerString];
+  NSURL *issuer = [OIDMockOpenIDProvider issuerForTestID:testName];
 
   [self doRegistrationWithIssuer:issuer callback:^(OIDServiceConfiguration *configuration,
                                                    OIDRegistrationResponse *registrationResponse,
@@ -511,6 +510,27 @@ typedef void (^UserInfoCompletion)(OIDAuthState *_Nullable authState,
   [self waitForExpectationsWithTimeout:30 handler:nil];
 }
 
+/*! @brief Tests that a failing token endpoint is reported as an error of the code exchange.
+ */
+- (void)testTokenEndpointServerError {
+  NSString *testName = @"token-endpoint-server-error";
+  [self startCertificationTest:testName];
+  [OIDMockOpenIDProvider setStatusCode:503 forPath:OIDMockOpenIDProviderTokenPath];
+  [self codeFlowWithExchangeExpectFailForTest:testName];
+}
+
+/*! @brief Measures the throughput of complete code flows, from discovery to token exchange,
+        against the in-process provider.
+ */
+- (void)testCodeFlowThroughput {
+  NSString *testName = @"rp-response_type-code";
+  [self startCertificationTest:testName];
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < kThroughputFlowCount; i++) {
+      [self codeFlowWithExchangeExpectSuccessForTest:testName];
+    }
+  }];
+}
 
 /*! @brief Creates a log file to record the certification logs.
     @param testName The test ID used to configure the test server.
@@ -358,6 +358,71 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
   [self waitForExpectationsWithTimeout:2 handler:nil];
 }
 
+/*! @brief Tests that concurrent discoveries of the same document share a single fetch and
+        configuration instance.
+ */
+- (void)testFetcherCoalescesConcurrentRequests {
+  __block NSUInteger fetchCount = 0;
+  __block DataTaskWithURLCompletionHandler pendingCompletionHandler;
+  DataTaskWithURLCompletionImplementation pendingResponse =
+      ^NSURLSessionDataTask *(
+          id _self, NSURL *url, DataTaskWithURLCompletionHandler completionHandler) {
+        fetchCount++;
+        pendingCompletionHandler = completionHandler;
+        return nil;
+      };
+
+  [self replaceInstanceMethodForClass:[NSURLSession class]
+                             selector:@selector(dataTaskWithURL:completionHandler:)
+                            withBlock:pendingResponse];
+
+  NSURL *url = [NSURL URLWithString:kInitializerTestDiscoveryEndpoint];
+  NSMutableArray<OIDServiceConfiguration *> *configurations = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 3; i++) {
+    XCTestExpectation *expectation =
+        [self expectationWithDescription:@"Callback should be fired."];
+    [OIDAuthorizationService discoverServiceConfigurationForDiscoveryURL:url
+        completion:^(OIDServiceConfiguration *_Nullable serviceConfiguration,
+                     NSError *_Nullable error) {
+      XCTAssertNil(error, @"");
+      XCTAssertNotNil(serviceConfiguration, @"");
+      [configurations addObject:serviceConfiguration];
+      [expectation fulfill];
+    }];
+  }
+  XCTAssertEqual(fetchCount, 1, @"");
+
+  NSData *jsonData =
+      [NSJSONSerialization dataWithJSONObject:[OIDServiceDiscoveryTests
+                                                  completeServiceDiscoveryDictionary]
+                                      options:0
+                                        error:NULL];
+  NSHTTPURLResponse *jsonResponse = [[NSHTTPURLResponse alloc] initWithURL:url
+                                                                statusCode:200
+                                                               HTTPVersion:@"1.1"
+                                                              headerFields:nil];
+  pendingCompletionHandler(jsonData, jsonResponse, nil);
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+
+  XCTAssertEqual(configurations.count, 3, @"");
+  XCTAssertEqual(configurations[0], configurations[1], @"");
+  XCTAssertEqual(configurations[0], configurations[2], @"");
+
+  // Once completed, the next discovery fetches the document again.
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Callback should be fired."];
+  [OIDAuthorizationService discoverServiceConfigurationForDiscoveryURL:url
+      completion:^(OIDServiceConfiguration *_Nullable serviceConfiguration,
+                   NSError *_Nullable error) {
+    XCTAssertNotNil(error, @"");
+    [expectation fulfill];
+  }];
+  XCTAssertEqual(fetchCount, 2, @"");
+  pendingCompletionHandler(nil, nil, [NSError errorWithDomain:NSURLErrorDomain
+                                                         code:NSURLErrorCancelled
+                                                     userInfo:nil]);
+  [self waitForExpectationsWithTimeout:2 handler:nil];
+}
+
 /*! @brief Tests the @c NSSecureCoding by round-tripping an instance through the coding process and
         checking to make sure the source and destination instances have equivalent dictionaries.
  */
@@ -385,6 +450,45 @@ static NSString *const kIssuerTestExpectedFullDiscoveryURL =
   XCTAssertEqualObjects(configuration.registrationEndpoint, unarchived.registrationEndpoint, @"");
 }
 
+- (void)testIdenticalConfigurationsAreInterned {
+  OIDServiceConfiguration *configuration = [[self class] testInstance];
+  XCTAssertEqual([[self class] testInstance], configuration);
+
+  OIDServiceConfiguration *otherConfiguration = [[OIDServiceConfiguration alloc]
+      initWithAuthorizationEndpoint:configuration.authorizationEndpoint
+                      tokenEndpoint:[NSURL URLWithString:@"https://www.example.com/token2"]];
+  XCTAssertNotEqual(otherConfiguration, configuration);
+
+  NSDictionary *dictionary = [OIDServiceDiscoveryTests completeServiceDiscoveryDictionary];
+  OIDServiceDiscovery *discoveryDocument =
+      [[OIDServiceDiscovery alloc] initWithDictionary:dictionary error:NULL];
+  XCTAssertEqual([[OIDServiceDiscovery alloc] initWithDictionary:dictionary error:NULL],
+                 discoveryDocument);
+  OIDServiceConfiguration *discoveredConfiguration =
+      [[OIDServiceConfiguration alloc] initWithDiscoveryDocument:discoveryDocument];
+  XCTAssertEqual([[OIDServiceConfiguration alloc] initWithDiscoveryDocument:discoveryDocument],
+                 discoveredConfiguration);
+}
+
+- (void)testDecodedConfigurationsAreInterned {
+  if (@available(iOS 12.0, macOS 10.13, tvOS 11.0, watchOS 4.0, *)) {
+    NSDictionary *dictionary = [OIDServiceDiscoveryTests completeServiceDiscoveryDictionary];
+    OIDServiceDiscovery *discoveryDocument =
+        [[OIDServiceDiscovery alloc] initWithDictionary:dictionary error:NULL];
+    OIDServiceConfiguration *configuration =
+        [[OIDServiceConfiguration alloc] initWithDiscoveryDocument:discoveryDocument];
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:configuration
+                                         requiringSecureCoding:YES
+                                                         error:NULL];
+    OIDServiceConfiguration *unarchived =
+        [NSKeyedUnarchiver unarchivedObjectOfClass:[OIDServiceConfiguration class]
+                                          fromData:data
+                                             error:NULL];
+    XCTAssertEqual(unarchived, configuration);
+    XCTAssertEqual(unarchived.discoveryDocument, discoveryDocument);
+  }
+}
+
 /*! @brief Tests the @c NSCopying implementation by round-tripping an instance through the copying
         process and checking to make sure the source and destination instances have equivalent
         dictionaries.
@@ -438,6 +438,36 @@ static NSString *const kDiscoveryDocumentNotDictionary =
             @"When not specified, |requestURIParameterSupported| should return YES.");
 }
 
+/*! @brief Tests that we get an error rather than an exception when a required URL field isn't a
+        string.
+ */
+- (void)testErrorWhenRequiredURLFieldNotString {
+  NSError *error;
+  NSMutableDictionary *serviceDiscoveryDictionary =
+      [[[self class] minimumServiceDiscoveryDictionary] mutableCopy];
+  serviceDiscoveryDictionary[kTokenEndpointKey] = @42;
+  OIDServiceDiscovery *discovery =
+      [[OIDServiceDiscovery alloc] initWithDictionary:serviceDiscoveryDictionary error:&error];
+  XCTAssertNil(discovery);
+  XCTAssertEqualObjects(error.domain, OIDGeneralErrorDomain);
+  XCTAssertEqual(error.code, OIDErrorCodeInvalidDiscoveryDocument);
+}
+
+/*! @brief Measures repeated access of the token endpoint, as done for every token refresh.
+ */
+- (void)testTokenEndpointAccessPerformance {
+  NSDictionary *serviceDiscoveryDictionary = [[self class] completeServiceDiscoveryDictionary];
+  OIDServiceDiscovery *discovery =
+      [[OIDServiceDiscovery alloc] initWithDictionary:serviceDiscoveryDictionary error:NULL];
+  [self measureBlock:^{
+    for (int i = 0; i < 50000; i++) {
+      @autoreleasepool {
+        XCTAssertNotNil(discovery.tokenEndpoint);
+      }
+    }
+  }];
+}
+
 /*! @brief Tests the NSSecureCoding by round-tripping an instance through the coding process and
         checking to make sure the source and destination instances have equivalent dictionaries.
  */
@@ -0,0 +1,203 @@
+/*! @file OIDSharedAuthStateCoordinatorTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <fcntl.h>
+#import <sys/file.h>
+#import <unistd.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDSharedAuthStateCoordinator.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDSharedAuthStateCoordinator. Each process sharing an authorization
+        is simulated by a coordinator with its own copy of the authorization state.
+ */
+@interface OIDSharedAuthStateCoordinatorTests : XCTestCase
+@end
+
+@implementation OIDSharedAuthStateCoordinatorTests {
+  /*! @brief The directory shared by the coordinators of a test.
+   */
+  NSURL *_directoryURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  _directoryURL = [NSURL fileURLWithPath:[NSTemporaryDirectory()
+      stringByAppendingPathComponent:[NSUUID UUID].UUIDString]];
+  [[NSFileManager defaultManager] createDirectoryAtURL:_directoryURL
+                           withIntermediateDirectories:YES
+                                            attributes:nil
+                                                 error:NULL];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [[NSFileManager defaultManager] removeItemAtURL:_directoryURL error:NULL];
+  [super tearDown];
+}
+
+/*! @brief Returns a coordinator for a new copy of an authorization whose access token has expired.
+        The tokens of the refreshes are numbered from 1 by the mock provider.
+ */
+- (OIDSharedAuthStateCoordinator *)coordinatorWithExpiredAuthState {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithAccessToken:@"access_token_0"
+                                                               refreshToken:@"refresh_token_0"
+                                                                  expiresIn:0
+                                                                    subject:nil];
+  return [[OIDSharedAuthStateCoordinator alloc] initWithAuthState:authState
+                                                     directoryURL:_directoryURL
+                                                       identifier:@"account"];
+}
+
+/*! @brief Performs an action with fresh tokens, expecting the given access token.
+ */
+- (void)performActionWithCoordinator:(OIDSharedAuthStateCoordinator *)coordinator
+                 expectedAccessToken:(NSString *)expectedAccessToken {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Action performed."];
+  [coordinator performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                              NSString *_Nullable idToken,
+                                              NSError *_Nullable error) {
+    XCTAssertTrue([NSThread isMainThread]);
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(accessToken, expectedAccessToken);
+    [expectation fulfill];
+  }];
+}
+
+- (void)testOtherProcessAdoptsRefreshedTokens {
+  OIDSharedAuthStateCoordinator *app = [self coordinatorWithExpiredAuthState];
+  OIDSharedAuthStateCoordinator *extension = [self coordinatorWithExpiredAuthState];
+
+  [self performActionWithCoordinator:app expectedAccessToken:@"access_token_1"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:app.stateFileURL.path]);
+
+  [self performActionWithCoordinator:extension expectedAccessToken:@"access_token_1"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+  XCTAssertEqualObjects(extension.authState.refreshToken, @"refresh_token_1");
+}
+
+- (void)testConcurrentRefreshesAreCoordinated {
+  OIDSharedAuthStateCoordinator *app = [self coordinatorWithExpiredAuthState];
+  OIDSharedAuthStateCoordinator *extension = [self coordinatorWithExpiredAuthState];
+
+  [self performActionWithCoordinator:app expectedAccessToken:@"access_token_1"];
+  [self performActionWithCoordinator:app expectedAccessToken:@"access_token_1"];
+  [self performActionWithCoordinator:extension expectedAccessToken:@"access_token_1"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+  XCTAssertEqualObjects(app.authState.refreshToken, @"refresh_token_1");
+  XCTAssertEqualObjects(extension.authState.refreshToken, @"refresh_token_1");
+}
+
+- (void)testProcessRefreshesWhenSharedTokensAreStale {
+  OIDSharedAuthStateCoordinator *app = [self coordinatorWithExpiredAuthState];
+  OIDSharedAuthStateCoordinator *extension = [self coordinatorWithExpiredAuthState];
+
+  [self performActionWithCoordinator:app expectedAccessToken:@"access_token_1"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  // The token was revoked, so the extension refreshes with the refresh token rotated by the app.
+  [extension.authState updateWithSnapshot:app.authState.snapshot];
+  [extension.authState setNeedsTokenRefresh];
+  [self performActionWithCoordinator:extension expectedAccessToken:@"access_token_2"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 2);
+
+  [app.authState setNeedsTokenRefresh];
+  [self performActionWithCoordinator:app expectedAccessToken:@"access_token_2"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 2);
+}
+
+/*! @brief Writes the refresh lease of another process, expiring after an interval.
+ */
+- (void)writeLeaseOfOtherProcessForCoordinator:(OIDSharedAuthStateCoordinator *)coordinator
+                                    expiringIn:(NSTimeInterval)interval {
+  NSDictionary *lease = @{
+    @"owner" : [NSUUID UUID].UUIDString,
+    @"expires" : @([NSDate date].timeIntervalSince1970 + interval),
+  };
+  XCTAssertTrue([lease writeToURL:coordinator.leaseFileURL atomically:YES]);
+}
+
+/*! @brief Tests that a process waits for another process holding the refresh lease without holding
+        the lock file, then refreshes once the lease expires without the tokens having been written.
+ */
+- (void)testWaitsForLeaseOfOtherProcess {
+  OIDSharedAuthStateCoordinator *extension = [self coordinatorWithExpiredAuthState];
+  [self writeLeaseOfOtherProcessForCoordinator:extension expiringIn:0.6];
+  NSDate *start = [NSDate date];
+
+  [self performActionWithCoordinator:extension expectedAccessToken:@"access_token_1"];
+  XCTestExpectation *lockExpectation = [self expectationWithDescription:@"Lock file checked."];
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.3 * NSEC_PER_SEC)),
+                 dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+    XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 0);
+    int fd = open(extension.lockFileURL.fileSystemRepresentation, O_RDWR | O_CLOEXEC);
+    XCTAssertGreaterThanOrEqual(fd, 0);
+    XCTAssertEqual(flock(fd, LOCK_EX | LOCK_NB), 0, @"lock held while waiting for the lease");
+    flock(fd, LOCK_UN);
+    close(fd);
+    [lockExpectation fulfill];
+  });
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertGreaterThanOrEqual([[NSDate date] timeIntervalSinceDate:start], 0.5);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+}
+
+/*! @brief Tests that the expired lease of a process which stopped while refreshing doesn't block
+        the other processes, and that the lease is released after the refresh.
+ */
+- (void)testExpiredLeaseIsTakenOver {
+  OIDSharedAuthStateCoordinator *app = [self coordinatorWithExpiredAuthState];
+  [self writeLeaseOfOtherProcessForCoordinator:app expiringIn:-1];
+
+  [self performActionWithCoordinator:app expectedAccessToken:@"access_token_1"];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+
+  // The lease is released on the lock queue, after the actions are called.
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:2];
+  while ([[NSFileManager defaultManager] fileExistsAtPath:app.leaseFileURL.path] &&
+         [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+  }
+  XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:app.leaseFileURL.path]);
+  XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:app.stateFileURL.path]);
+}
+
+@end
+
+#pragma GCC diagnostic pop
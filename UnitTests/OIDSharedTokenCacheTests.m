@@ -0,0 +1,276 @@
+/*! @file OIDSharedTokenCacheTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDAuthorizationResponseTests.h"
+#import "OIDTokenRequestTests.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthStateSnapshot.h"
+#import "Sources/AppAuthCore/OIDSharedTokenCache.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDSharedTokenCache. The owning process and the reading processes are
+        simulated by caches mapping the same file.
+ */
+@interface OIDSharedTokenCacheTests : XCTestCase
+@end
+
+@implementation OIDSharedTokenCacheTests {
+  /*! @brief The cache file of a test.
+   */
+  NSURL *_fileURL;
+}
+
+- (void)setUp {
+  [super setUp];
+  _fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory()
+      stringByAppendingPathComponent:[NSUUID UUID].UUIDString]];
+}
+
+- (void)tearDown {
+  [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:NULL];
+  [super tearDown];
+}
+
+/*! @brief Returns an authorization state with the given access token.
+ */
++ (OIDAuthState *)authStateWithAccessToken:(NSString *)accessToken
+                                 expiresIn:(NSTimeInterval)expiresIn {
+  OIDTokenResponse *tokenResponse =
+      [[OIDTokenResponse alloc] initWithRequest:[OIDTokenRequestTests testInstance]
+                                     parameters:@{
+                                       @"access_token" : accessToken,
+                                       @"token_type" : @"Bearer",
+                                       @"expires_in" : @(expiresIn),
+                                     }];
+  return [[OIDAuthState alloc]
+      initWithAuthorizationResponse:[OIDAuthorizationResponseTests testInstanceCodeFlow]
+                      tokenResponse:tokenResponse];
+}
+
+- (void)testReaderSeesWrittenToken {
+  NSError *error;
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:&error];
+  XCTAssertNotNil(writer, @"%@", error);
+  OIDSharedTokenCache *reader = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:NO
+                                                                       error:&error];
+  XCTAssertNotNil(reader, @"%@", error);
+  XCTAssertNil([reader currentEntry]);
+
+  OIDAuthState *authState = [[self class] authStateWithAccessToken:@"access_token_1"
+                                                         expiresIn:3600];
+  XCTAssertTrue([writer writeAuthState:authState]);
+  OIDSharedTokenCacheEntry *entry = [reader currentEntry];
+  XCTAssertEqualObjects(entry.accessToken, @"access_token_1");
+  XCTAssertEqualObjects(entry.tokenType, @"Bearer");
+  XCTAssertEqualWithAccuracy(entry.accessTokenExpirationDate.timeIntervalSince1970,
+                             authState.snapshot.accessTokenExpirationDate.timeIntervalSince1970,
+                             0.001);
+  XCTAssertEqual(entry.generation, 1);
+  XCTAssertTrue(entry.isFresh);
+
+  // the cache is written when the state changes
+  authState.stateChangeDelegate = writer;
+  [authState updateWithTokenResponse:[[[self class] authStateWithAccessToken:@"access_token_2"
+                                                                   expiresIn:3600]
+                                         lastTokenResponse]
+                               error:nil];
+  XCTAssertEqualObjects([reader freshAccessToken], @"access_token_2");
+  XCTAssertEqual([reader currentEntry].generation, 2);
+
+  // reading doesn't write
+  XCTAssertFalse([reader writeAuthState:authState]);
+}
+
+- (void)testStaleTokensAreNotFresh {
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:NULL];
+  OIDAuthState *authState = [[self class] authStateWithAccessToken:@"expired" expiresIn:0];
+  [writer writeAuthState:authState];
+  XCTAssertEqualObjects([writer currentEntry].accessToken, @"expired");
+  XCTAssertNil([writer freshAccessToken]);
+
+  // a token needing refresh is cleared
+  authState = [[self class] authStateWithAccessToken:@"revoked" expiresIn:3600];
+  [authState setNeedsTokenRefresh];
+  [writer writeAuthState:authState];
+  XCTAssertNil([writer currentEntry]);
+}
+
+/*! @brief Tests that forcing a refresh clears the cache of the state, so that other processes
+        stop using the invalidated token.
+ */
+- (void)testForcedRefreshClearsCache {
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:NULL];
+  OIDSharedTokenCache *reader = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:NO
+                                                                       error:NULL];
+  OIDAuthState *authState = [[self class] authStateWithAccessToken:@"revoked" expiresIn:3600];
+  authState.stateChangeDelegate = writer;
+  [writer writeAuthState:authState];
+  XCTAssertEqualObjects([reader freshAccessToken], @"revoked");
+
+  [authState setNeedsTokenRefresh];
+  XCTAssertNil([reader freshAccessToken]);
+  XCTAssertNil([reader currentEntry]);
+}
+
+- (void)testTooLongTokenClearsCache {
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:NULL];
+  [writer writeAuthState:[[self class] authStateWithAccessToken:@"short" expiresIn:3600]];
+  NSUInteger length = [OIDSharedTokenCache maximumAccessTokenLength] + 1;
+  NSString *longToken = [@"" stringByPaddingToLength:length withString:@"a" startingAtIndex:0];
+  XCTAssertFalse([writer writeAuthState:[[self class] authStateWithAccessToken:longToken
+                                                                     expiresIn:3600]]);
+  XCTAssertNil([writer currentEntry]);
+}
+
+/*! @brief Tests that a file left mid-write by a writer which terminated, with an odd sequence, is
+        repaired when opened for writing, so that later writes are seen by readers.
+ */
+- (void)testReopeningFileLeftMidWrite {
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:NULL];
+  [writer writeAuthState:[[self class] authStateWithAccessToken:@"first" expiresIn:3600]];
+  writer = nil;
+
+  // Makes the sequence, after the 32-bit magic and version, odd as in the middle of a write.
+  NSFileHandle *fileHandle = [NSFileHandle fileHandleForUpdatingURL:_fileURL error:NULL];
+  [fileHandle seekToFileOffset:8];
+  uint64_t sequence = 3;
+  [fileHandle writeData:[NSData dataWithBytes:&sequence length:sizeof(sequence)]];
+  [fileHandle closeFile];
+  OIDSharedTokenCache *reader = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:NO
+                                                                       error:NULL];
+  XCTAssertNil([reader currentEntry]);
+
+  writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL writable:YES error:NULL];
+  XCTAssertNil([reader currentEntry]);
+  [writer writeAuthState:[[self class] authStateWithAccessToken:@"second" expiresIn:3600]];
+  OIDSharedTokenCacheEntry *entry = [reader currentEntry];
+  XCTAssertEqualObjects(entry.accessToken, @"second");
+  XCTAssertEqual(entry.generation, 3);
+}
+
+- (void)testReadingMissingFileFails {
+  NSError *error;
+  XCTAssertNil([[OIDSharedTokenCache alloc] initWithFileURL:_fileURL writable:NO error:&error]);
+  XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+  XCTAssertEqual(error.code, ENOENT);
+}
+
+/*! @brief Reads the cache on several threads while another thread keeps writing, checking that
+        every entry read holds the values of a single write.
+ */
+- (void)testConcurrentReadersObserveConsistentEntries {
+  static NSUInteger const kWrites = 20000;
+  static NSUInteger const kReads = 20000;
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:NULL];
+  OIDSharedTokenCache *reader = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:NO
+                                                                       error:NULL];
+  NSMutableArray<OIDAuthState *> *authStates = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 16; i++) {
+    // token lengths differ, so that a torn read would be detected
+    NSString *character = [NSString stringWithFormat:@"%lx", (unsigned long)i];
+    NSString *accessToken = [@"" stringByPaddingToLength:(i + 1) * 100
+                                              withString:character
+                                         startingAtIndex:0];
+    [authStates addObject:[[self class] authStateWithAccessToken:accessToken
+                                                       expiresIn:(i + 1) * 1000]];
+  }
+
+  __block NSUInteger inconsistentEntries = 0;
+  dispatch_group_t group = dispatch_group_create();
+  dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+  dispatch_group_async(group, queue, ^{
+    for (NSUInteger w = 0; w < kWrites; w++) {
+      [writer writeAuthState:authStates[w % authStates.count]];
+    }
+  });
+  for (NSUInteger r = 0; r < 4; r++) {
+    dispatch_group_async(group, queue, ^{
+      NSUInteger inconsistent = 0;
+      for (NSUInteger read = 0; read < kReads; read++) {
+        @autoreleasepool {
+          OIDSharedTokenCacheEntry *entry = [reader currentEntry];
+          if (!entry) {
+            continue;
+          }
+          NSUInteger i = entry.accessToken.length / 100 - 1;
+          OIDAuthState *expected = i < authStates.count ? authStates[i] : nil;
+          if (![entry.accessToken isEqualToString:expected.snapshot.accessToken] ||
+              fabs(entry.accessTokenExpirationDate.timeIntervalSince1970 -
+                   expected.snapshot.accessTokenExpirationDate.timeIntervalSince1970) > 0.001) {
+            inconsistent++;
+          }
+        }
+      }
+      @synchronized(authStates) {
+        inconsistentEntries += inconsistent;
+      }
+    });
+  }
+  dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+  XCTAssertEqual(inconsistentEntries, 0);
+  XCTAssertEqual([reader currentEntry].generation, kWrites);
+}
+
+- (void)testReadPerformance {
+  OIDSharedTokenCache *writer = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:YES
+                                                                       error:NULL];
+  [writer writeAuthState:[[self class] authStateWithAccessToken:@"access_token" expiresIn:3600]];
+  OIDSharedTokenCache *reader = [[OIDSharedTokenCache alloc] initWithFileURL:_fileURL
+                                                                    writable:NO
+                                                                       error:NULL];
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < 100000; i++) {
+      @autoreleasepool {
+        XCTAssertNotNil([reader freshAccessToken]);
+      }
+    }
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,261 @@
+/*! @file OIDTokenBrokerTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <sys/stat.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDTokenBroker.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief The number of clients of the load test, each fetching tokens on its own thread.
+ */
+static NSUInteger const kLoadTestClientCount = 16;
+
+/*! @brief The number of tokens each client of the load test fetches.
+ */
+static NSUInteger const kLoadTestRequestsPerClient = 1000;
+
+/*! @brief How long the token endpoint takes to respond, in seconds.
+ */
+static NSTimeInterval const kTokenEndpointLatency = 0.05;
+
+/*! @brief Unit tests and a load test for @c OIDTokenBroker and @c OIDTokenBrokerClient.
+ */
+@interface OIDTokenBrokerTests : XCTestCase
+@end
+
+@implementation OIDTokenBrokerTests {
+  /*! @brief The socket path of a test.
+   */
+  NSString *_socketPath;
+}
+
+- (void)setUp {
+  [super setUp];
+  // kept short, as socket paths are limited to about a hundred bytes
+  NSString *name = [NSString stringWithFormat:@"oid-%@.sock",
+                                              [[NSUUID UUID].UUIDString substringToIndex:8]];
+  _socketPath = [NSTemporaryDirectory() stringByAppendingPathComponent:name];
+  [OIDMockOpenIDProvider install];
+  [OIDMockOpenIDProvider setLatency:kTokenEndpointLatency];
+}
+
+- (void)tearDown {
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Returns a started broker.
+ */
+- (OIDTokenBroker *)startedBrokerWithAuthState:(OIDAuthState *)authState {
+  OIDTokenBroker *broker = [[OIDTokenBroker alloc] initWithAuthState:authState
+                                                          socketPath:_socketPath];
+  NSError *error;
+  XCTAssertTrue([broker startWithError:&error], @"%@", error);
+  return broker;
+}
+
+/*! @brief Fetches tokens on a background thread with each client, as the refreshes performed by
+        the broker complete on the main queue, which is kept running while waiting.
+    @param clients The clients, each fetching on its own thread.
+    @param requestsPerClient The number of tokens each client fetches.
+    @param check Called with the result of each fetch.
+ */
+- (void)fetchWithClients:(NSArray<OIDTokenBrokerClient *> *)clients
+       requestsPerClient:(NSUInteger)requestsPerClient
+                   check:(void (^)(NSString *_Nullable accessToken,
+                                   NSError *_Nullable error))check {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Tokens fetched."];
+  expectation.expectedFulfillmentCount = clients.count;
+  for (OIDTokenBrokerClient *client in clients) {
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+      for (NSUInteger i = 0; i < requestsPerClient; i++) {
+        NSError *error;
+        NSString *accessToken = [client fetchFreshAccessTokenWithExpirationDate:NULL
+                                                                          error:&error];
+        check(accessToken, error);
+      }
+      [expectation fulfill];
+    });
+  }
+  [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testClientFetchesFreshToken {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDTokenBroker *broker = [self startedBrokerWithAuthState:authState];
+  OIDTokenBrokerClient *client = [[OIDTokenBrokerClient alloc] initWithSocketPath:_socketPath];
+
+  NSDate *expirationDate;
+  NSError *error;
+  XCTAssertEqualObjects([client fetchFreshAccessTokenWithExpirationDate:&expirationDate
+                                                                  error:&error],
+                        @"access_token", @"%@", error);
+  XCTAssertEqualWithAccuracy(expirationDate.timeIntervalSince1970,
+                             authState.snapshot.accessTokenExpirationDate.timeIntervalSince1970,
+                             1);
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 0);
+  [broker stop];
+}
+
+- (void)testConcurrentClientsShareOneRefresh {
+  OIDTokenBroker *broker =
+      [self startedBrokerWithAuthState:[OIDMockOpenIDProvider authStateWithExpiresIn:0]];
+  NSMutableArray<OIDTokenBrokerClient *> *clients = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 8; i++) {
+    [clients addObject:[[OIDTokenBrokerClient alloc] initWithSocketPath:_socketPath]];
+  }
+  [self fetchWithClients:clients
+       requestsPerClient:3
+                   check:^(NSString *_Nullable accessToken, NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"access_token_1", @"%@", error);
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+  [broker stop];
+}
+
+- (void)testRefreshErrorIsReturnedToClient {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:0];
+  [OIDMockOpenIDProvider revokeToken:authState.refreshToken];
+  OIDTokenBroker *broker = [self startedBrokerWithAuthState:authState];
+  OIDTokenBrokerClient *client = [[OIDTokenBrokerClient alloc] initWithSocketPath:_socketPath];
+  [self fetchWithClients:@[ client ]
+       requestsPerClient:1
+                   check:^(NSString *_Nullable accessToken, NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    XCTAssertEqualObjects(error.domain, OIDGeneralErrorDomain);
+    XCTAssertEqual(error.code, OIDErrorCodeTokenRefreshError);
+  }];
+  [broker stop];
+}
+
+- (void)testClientReconnectsAfterBrokerRestart {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDTokenBroker *broker = [self startedBrokerWithAuthState:authState];
+  OIDTokenBrokerClient *client = [[OIDTokenBrokerClient alloc] initWithSocketPath:_socketPath];
+  XCTAssertNotNil([client fetchFreshAccessTokenWithExpirationDate:NULL error:NULL]);
+  [broker stop];
+
+  NSError *error;
+  XCTAssertNil([client fetchFreshAccessTokenWithExpirationDate:NULL error:&error]);
+  XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+
+  broker = [self startedBrokerWithAuthState:authState];
+  XCTAssertEqualObjects([client fetchFreshAccessTokenWithExpirationDate:NULL error:&error],
+                        @"access_token", @"%@", error);
+  [broker stop];
+}
+
+/*! @brief Tests that the socket is only accessible to the user, and that no file is left behind
+        where it was bound.
+ */
+- (void)testSocketIsPrivate {
+  OIDTokenBroker *broker =
+      [self startedBrokerWithAuthState:[OIDMockOpenIDProvider authStateWithExpiresIn:3600]];
+  struct stat status;
+  XCTAssertEqual(lstat(_socketPath.fileSystemRepresentation, &status), 0);
+  XCTAssertTrue(S_ISSOCK(status.st_mode));
+  XCTAssertEqual(status.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO), S_IRUSR | S_IWUSR);
+  NSArray<NSString *> *files =
+      [[NSFileManager defaultManager] contentsOfDirectoryAtPath:NSTemporaryDirectory() error:NULL];
+  for (NSString *file in files) {
+    XCTAssertFalse([file hasPrefix:@".oidtb"], @"%@ left behind", file);
+  }
+  [broker stop];
+}
+
+/*! @brief Tests that a file other than a socket at the socket path is left alone.
+ */
+- (void)testDoesNotReplaceOtherFiles {
+  NSData *contents = [@"not a socket" dataUsingEncoding:NSUTF8StringEncoding];
+  XCTAssertTrue([contents writeToFile:_socketPath atomically:NO]);
+  OIDTokenBroker *broker =
+      [[OIDTokenBroker alloc] initWithAuthState:[OIDMockOpenIDProvider authStateWithExpiresIn:3600]
+                                     socketPath:_socketPath];
+  NSError *error;
+  XCTAssertFalse([broker startWithError:&error]);
+  XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+  XCTAssertEqual(error.code, EEXIST);
+  XCTAssertEqualObjects([NSData dataWithContentsOfFile:_socketPath], contents);
+  [[NSFileManager defaultManager] removeItemAtPath:_socketPath error:NULL];
+}
+
+/*! @brief Tests that a second broker doesn't take the socket away from a live one, and that it
+        starts once the first one stopped.
+ */
+- (void)testDoesNotReplaceLiveSocket {
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDTokenBroker *broker = [self startedBrokerWithAuthState:authState];
+  OIDTokenBroker *secondBroker = [[OIDTokenBroker alloc] initWithAuthState:authState
+                                                                socketPath:_socketPath];
+  NSError *error;
+  XCTAssertFalse([secondBroker startWithError:&error]);
+  XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+  XCTAssertEqual(error.code, EADDRINUSE);
+  OIDTokenBrokerClient *client = [[OIDTokenBrokerClient alloc] initWithSocketPath:_socketPath];
+  XCTAssertEqualObjects([client fetchFreshAccessTokenWithExpirationDate:NULL error:&error],
+                        @"access_token", @"%@", error);
+
+  [broker stop];
+  XCTAssertTrue([secondBroker startWithError:&error], @"%@", error);
+  [secondBroker stop];
+}
+
+/*! @brief Load test in which many clients fetch tokens as fast as they can over their kept-alive
+        connections.
+ */
+- (void)testManyClientsLoadPerformance {
+  OIDTokenBroker *broker =
+      [self startedBrokerWithAuthState:[OIDMockOpenIDProvider authStateWithExpiresIn:3600]];
+  NSMutableArray<OIDTokenBrokerClient *> *clients = [NSMutableArray array];
+  for (NSUInteger i = 0; i < kLoadTestClientCount; i++) {
+    [clients addObject:[[OIDTokenBrokerClient alloc] initWithSocketPath:_socketPath]];
+  }
+  [self measureBlock:^{
+    __block NSUInteger failures = 0;
+    [self fetchWithClients:clients
+         requestsPerClient:kLoadTestRequestsPerClient
+                     check:^(NSString *_Nullable accessToken, NSError *_Nullable error) {
+      if (!accessToken) {
+        @synchronized(clients) {
+          failures++;
+        }
+      }
+    }];
+    XCTAssertEqual(failures, 0);
+  }];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 0);
+  [broker stop];
+}
+
+@end
+
+#pragma GCC diagnostic pop
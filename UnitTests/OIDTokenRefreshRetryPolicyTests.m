@@ -0,0 +1,261 @@
+/*! @file OIDTokenRefreshRetryPolicyTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDErrorUtilities.h"
+#import "Sources/AppAuthCore/OIDMetrics.h"
+#import "Sources/AppAuthCore/OIDMetricsAggregator.h"
+#import "Sources/AppAuthCore/OIDTokenRefreshRetryPolicy.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDTokenRefreshRetryPolicy.
+ */
+@interface OIDTokenRefreshRetryPolicyTests : XCTestCase
+@end
+
+@implementation OIDTokenRefreshRetryPolicyTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDMetrics setObserver:nil];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Returns a server error as returned by a token request answered with a status code.
+    @param statusCode The HTTP status code.
+    @param retryAfter The value of the Retry-After header, if any.
+ */
++ (NSError *)serverErrorWithStatusCode:(NSInteger)statusCode
+                            retryAfter:(nullable NSString *)retryAfter {
+  NSDictionary *headers = retryAfter ? @{ @"Retry-After" : retryAfter } : @{};
+  NSHTTPURLResponse *response =
+      [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://www.example.com/"]
+                                  statusCode:statusCode
+                                 HTTPVersion:@"HTTP/1.1"
+                                headerFields:headers];
+  NSError *HTTPError = [OIDErrorUtilities HTTPErrorWithHTTPResponse:response data:nil];
+  return [OIDErrorUtilities errorWithCode:OIDErrorCodeServerError
+                          underlyingError:HTTPError
+                              description:nil];
+}
+
+- (void)testRetryableErrors {
+  NSError *networkError = [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
+                                           underlyingError:nil
+                                               description:nil];
+  NSError *cancelledError =
+      [OIDErrorUtilities errorWithCode:OIDErrorCodeNetworkError
+                       underlyingError:[NSError errorWithDomain:NSURLErrorDomain
+                                                           code:NSURLErrorCancelled
+                                                       userInfo:nil]
+                           description:nil];
+  NSError *temporarilyUnavailable =
+      [OIDErrorUtilities OAuthErrorWithDomain:OIDOAuthTokenErrorDomain
+                                OAuthResponse:@{ @"error" : @"temporarily_unavailable" }
+                              underlyingError:nil];
+  NSError *invalidGrant =
+      [OIDErrorUtilities OAuthErrorWithDomain:OIDOAuthTokenErrorDomain
+                                OAuthResponse:@{ @"error" : @"invalid_grant" }
+                              underlyingError:nil];
+
+  XCTAssertTrue([OIDTokenRefreshRetryPolicy isRetryableError:networkError]);
+  XCTAssertFalse([OIDTokenRefreshRetryPolicy isRetryableError:cancelledError]);
+  XCTAssertTrue([OIDTokenRefreshRetryPolicy isRetryableError:temporarilyUnavailable]);
+  XCTAssertFalse([OIDTokenRefreshRetryPolicy isRetryableError:invalidGrant]);
+  XCTAssertTrue([OIDTokenRefreshRetryPolicy
+      isRetryableError:[[self class] serverErrorWithStatusCode:503 retryAfter:nil]]);
+  XCTAssertTrue([OIDTokenRefreshRetryPolicy
+      isRetryableError:[[self class] serverErrorWithStatusCode:429 retryAfter:nil]]);
+  XCTAssertFalse([OIDTokenRefreshRetryPolicy
+      isRetryableError:[[self class] serverErrorWithStatusCode:404 retryAfter:nil]]);
+}
+
+- (void)testRetryAfter {
+  NSDate *now = [NSDate dateWithTimeIntervalSince1970:784111777];  // Sun, 06 Nov 1994 08:49:37
+  NSError *seconds = [[self class] serverErrorWithStatusCode:503 retryAfter:@"120"];
+  NSError *date =
+      [[self class] serverErrorWithStatusCode:503 retryAfter:@"Sun, 06 Nov 1994 08:50:07 GMT"];
+  NSError *invalid = [[self class] serverErrorWithStatusCode:503 retryAfter:@"soon"];
+  NSError *missing = [[self class] serverErrorWithStatusCode:503 retryAfter:nil];
+
+  XCTAssertEqual([OIDTokenRefreshRetryPolicy retryAfterDelayForError:seconds now:now], 120);
+  XCTAssertEqual([OIDTokenRefreshRetryPolicy retryAfterDelayForError:date now:now], 30);
+  XCTAssertLessThan([OIDTokenRefreshRetryPolicy retryAfterDelayForError:invalid now:now], 0);
+  XCTAssertLessThan([OIDTokenRefreshRetryPolicy retryAfterDelayForError:missing now:now], 0);
+}
+
+- (void)testBackoff {
+  OIDTokenRefreshRetryPolicy *policy = [[OIDTokenRefreshRetryPolicy alloc] init];
+  policy.maximumAttempts = 5;
+  policy.initialBackoff = 1;
+  policy.backoffMultiplier = 2;
+  policy.maximumBackoff = 5;
+  policy.jitter = 0;
+  NSError *error = [[self class] serverErrorWithStatusCode:503 retryAfter:nil];
+
+  NSTimeInterval delay = 0;
+  XCTAssertTrue([policy shouldRetryAttempt:1 afterError:error delay:&delay]);
+  XCTAssertEqual(delay, 1);
+  XCTAssertTrue([policy shouldRetryAttempt:2 afterError:error delay:&delay]);
+  XCTAssertEqual(delay, 2);
+  XCTAssertTrue([policy shouldRetryAttempt:4 afterError:error delay:&delay]);
+  XCTAssertEqual(delay, 5);
+  XCTAssertFalse([policy shouldRetryAttempt:5 afterError:error delay:&delay]);
+
+  // Retry-After extends the backoff, unless it exceeds the maximum backoff.
+  NSError *retryAfterError = [[self class] serverErrorWithStatusCode:503 retryAfter:@"3"];
+  XCTAssertTrue([policy shouldRetryAttempt:1 afterError:retryAfterError delay:&delay]);
+  XCTAssertEqual(delay, 3);
+  retryAfterError = [[self class] serverErrorWithStatusCode:503 retryAfter:@"60"];
+  XCTAssertFalse([policy shouldRetryAttempt:1 afterError:retryAfterError delay:&delay]);
+
+  // Jitter only ever shortens the backoff.
+  policy.jitter = 1;
+  for (NSUInteger i = 0; i < 100; i++) {
+    XCTAssertTrue([policy shouldRetryAttempt:2 afterError:error delay:&delay]);
+    XCTAssertGreaterThanOrEqual(delay, 0);
+    XCTAssertLessThanOrEqual(delay, 2);
+  }
+}
+
+/*! @brief Tests that a refresh is retried through transient failures, while the actions waiting on
+        it stay queued and are all called once with the refreshed token.
+ */
+- (void)testRefreshRetriesKeepActionsQueued {
+  [OIDMockOpenIDProvider enqueueResponseWithStatusCode:503
+                                               headers:@{ @"Retry-After" : @"0" }
+                                                  JSON:@{ @"error" : @"server_error" }
+                                               forPath:OIDMockOpenIDProviderTokenPath];
+  [OIDMockOpenIDProvider enqueueResponseWithStatusCode:400
+                                               headers:@{ @"Retry-After" : @"0" }
+                                                  JSON:@{ @"error" : @"temporarily_unavailable" }
+                                               forPath:OIDMockOpenIDProviderTokenPath];
+  OIDMetricsAggregator *aggregator = [[OIDMetricsAggregator alloc] init];
+  [OIDMetrics setObserver:aggregator];
+
+  NSMutableArray<NSNumber *> *delays = [NSMutableArray array];
+  OIDTokenRefreshRetryPolicy *policy = [[OIDTokenRefreshRetryPolicy alloc] init];
+  policy.scheduler = ^(NSTimeInterval delay, dispatch_block_t block) {
+    @synchronized(delays) {
+      [delays addObject:@(delay)];
+    }
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), block);
+  };
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  authState.refreshRetryPolicy = policy;
+  [authState setNeedsTokenRefresh];
+
+  NSUInteger actionCount = 3;
+  for (NSUInteger i = 0; i < actionCount; i++) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Action is performed."];
+    [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                              NSString *_Nullable idToken,
+                                              NSError *_Nullable error) {
+      XCTAssertEqualObjects(accessToken, @"access_token_1");
+      XCTAssertNil(error);
+      [expectation fulfill];
+    }];
+  }
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 3);
+  XCTAssertEqual(delays.count, 2);
+  XCTAssertEqual([aggregator snapshot].tokenRefreshRetries, 2);
+  XCTAssertEqual([aggregator snapshot].tokenRefreshes.successes, 1);
+}
+
+/*! @brief Tests that a retry uses the refresh token current when it is sent, rather than the one
+        the failed attempt sent, if the refresh token was rotated in the meantime.
+ */
+- (void)testRetryUsesRotatedRefreshToken {
+  [OIDMockOpenIDProvider enqueueResponseWithStatusCode:503
+                                               headers:@{ @"Retry-After" : @"0" }
+                                                  JSON:@{ @"error" : @"server_error" }
+                                               forPath:OIDMockOpenIDProviderTokenPath];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDAuthState *rotatedAuthState =
+      [OIDMockOpenIDProvider authStateWithAccessToken:@"rotated_access_token"
+                                         refreshToken:@"rotated_refresh_token"
+                                            expiresIn:3600
+                                              subject:nil];
+  OIDTokenRefreshRetryPolicy *policy = [[OIDTokenRefreshRetryPolicy alloc] init];
+  policy.scheduler = ^(NSTimeInterval delay, dispatch_block_t block) {
+    // another refresh rotates the refresh token before the retry
+    [authState updateWithTokenResponse:rotatedAuthState.lastTokenResponse error:nil];
+    [OIDMockOpenIDProvider revokeToken:@"refresh_token"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), block);
+  };
+  authState.refreshRetryPolicy = policy;
+  [authState setNeedsTokenRefresh];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Action is performed."];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertEqualObjects(accessToken, @"access_token_1", @"%@", error);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  NSArray<NSURLSessionTask *> *tasks = [OIDMockOpenIDProvider receivedTasks];
+  XCTAssertEqual(tasks.count, 2);
+  NSString *retryBody = [[NSString alloc] initWithData:tasks.lastObject.originalRequest.HTTPBody
+                                              encoding:NSUTF8StringEncoding];
+  XCTAssertTrue([retryBody containsString:@"refresh_token=rotated_refresh_token"], @"%@",
+                retryBody);
+}
+
+/*! @brief Tests that without a retry policy, a transient failure fails the queued actions.
+ */
+- (void)testNoRetryWithoutPolicy {
+  [OIDMockOpenIDProvider setStatusCode:503 forPath:OIDMockOpenIDProviderTokenPath];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  [authState setNeedsTokenRefresh];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Action is performed."];
+  [authState performActionWithFreshTokens:^(NSString *_Nullable accessToken,
+                                            NSString *_Nullable idToken,
+                                            NSError *_Nullable error) {
+    XCTAssertEqual(error.code, OIDErrorCodeServerError);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCountForPath:OIDMockOpenIDProviderTokenPath], 1);
+}
+
+@end
+
+#pragma GCC diagnostic pop
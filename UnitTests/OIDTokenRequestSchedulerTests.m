@@ -0,0 +1,347 @@
+/*! @file OIDTokenRequestSchedulerTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDError.h"
+#import "Sources/AppAuthCore/OIDNetworkTask.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenRequestScheduler.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Unit tests for @c OIDTokenRequestScheduler.
+ */
+@interface OIDTokenRequestSchedulerTests : XCTestCase
+@end
+
+@implementation OIDTokenRequestSchedulerTests {
+  /*! @brief A token request which the mock provider answers successfully.
+   */
+  OIDTokenRequest *_tokenRequest;
+}
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+  // Answers after a delay, as a server under load.
+  [OIDMockOpenIDProvider setLatency:0.05];
+  _tokenRequest = [[OIDMockOpenIDProvider authStateWithExpiresIn:3600] tokenRefreshRequest];
+}
+
+- (void)tearDown {
+  [OIDTokenRequestScheduler setSharedScheduler:nil];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Installs a shared scheduler letting one background request in flight at a time.
+ */
+- (OIDTokenRequestScheduler *)installScheduler {
+  OIDTokenRequestScheduler *scheduler = [[OIDTokenRequestScheduler alloc] init];
+  [scheduler setMaximumConcurrentRequests:1 forPriority:OIDTokenRequestPriorityBackground];
+  [OIDTokenRequestScheduler setSharedScheduler:scheduler];
+  return scheduler;
+}
+
+/*! @brief Returns the @c NSURLSessionTask.priority of each request the mock provider received, in
+        order.
+ */
+- (NSArray<NSNumber *> *)sessionTaskPriorities {
+  NSMutableArray<NSNumber *> *priorities = [NSMutableArray array];
+  for (NSURLSessionTask *task in [OIDMockOpenIDProvider receivedTasks]) {
+    [priorities addObject:@(task.priority)];
+  }
+  return priorities;
+}
+
+/*! @brief Performs a token request which is expected to succeed.
+    @param priority The priority of the request.
+    @param completion Called on the main queue once the request completes.
+ */
+- (OIDNetworkTask *)performTokenRequestWithPriority:(OIDTokenRequestPriority)priority
+                                         completion:(dispatch_block_t)completion {
+  return [OIDAuthorizationService performTokenRequest:_tokenRequest
+                        originalAuthorizationResponse:nil
+                                             priority:priority
+                                              timeout:0
+                                             callback:^(OIDTokenResponse *_Nullable response,
+                                                        NSError *_Nullable error) {
+    XCTAssertNotNil(response, @"%@", error);
+    completion();
+  }];
+}
+
+- (void)testLimitsConcurrentRequestsOfPriority {
+  OIDTokenRequestScheduler *scheduler = [self installScheduler];
+  [scheduler setMaximumConcurrentRequests:2 forPriority:OIDTokenRequestPriorityBackground];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Requests completed."];
+  expectation.expectedFulfillmentCount = 6;
+  for (NSUInteger i = 0; i < 6; i++) {
+    [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                               completion:^{
+      [expectation fulfill];
+    }];
+  }
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityBackground], 2);
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 4);
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 6);
+  XCTAssertEqual([OIDMockOpenIDProvider maximumConcurrentRequestCount], 2);
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityBackground], 0);
+}
+
+/*! @brief Tests that an interactive request is sent right away, while background requests are
+        queued, and completes before them.
+ */
+- (void)testInteractiveRequestNotQueuedBehindBackgroundRequests {
+  OIDTokenRequestScheduler *scheduler = [self installScheduler];
+  [OIDMockOpenIDProvider setLatency:0.2];
+  XCTestExpectation *backgroundExpectation =
+      [self expectationWithDescription:@"Background requests completed."];
+  backgroundExpectation.expectedFulfillmentCount = 5;
+  __block NSUInteger completedBackgroundRequests = 0;
+  for (NSUInteger i = 0; i < 5; i++) {
+    [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                               completion:^{
+      completedBackgroundRequests++;
+      [backgroundExpectation fulfill];
+    }];
+  }
+  XCTestExpectation *interactiveExpectation =
+      [self expectationWithDescription:@"Interactive request completed."];
+  __block NSUInteger backgroundRequestsCompletedFirst = 0;
+  [OIDAuthorizationService performTokenRequest:_tokenRequest
+                 originalAuthorizationResponse:nil
+                                      priority:OIDTokenRequestPriorityInteractive
+                                       timeout:0
+                                      callback:^(OIDTokenResponse *_Nullable response,
+                                                 NSError *_Nullable error) {
+    XCTAssertNotNil(response, @"%@", error);
+    backgroundRequestsCompletedFirst = completedBackgroundRequests;
+    [interactiveExpectation fulfill];
+  }];
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityInteractive], 1);
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 4);
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertLessThanOrEqual(backgroundRequestsCompletedFirst, 1);
+}
+
+- (void)testRaisePriorityOfWaitingRequest {
+  OIDTokenRequestScheduler *scheduler = [self installScheduler];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Requests completed."];
+  expectation.expectedFulfillmentCount = 3;
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                             completion:^{
+    [expectation fulfill];
+  }];
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                             completion:^{
+    [expectation fulfill];
+  }];
+  OIDNetworkTask *networkTask =
+      [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                                 completion:^{
+    [expectation fulfill];
+  }];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 2);
+
+  [networkTask raisePriority:OIDTokenRequestPriorityInteractive];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 1);
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityInteractive], 1);
+
+  // lowering the priority has no effect
+  [networkTask raisePriority:OIDTokenRequestPriorityBackground];
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityInteractive], 1);
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertTrue([[self sessionTaskPriorities] containsObject:@(NSURLSessionTaskPriorityHigh)]);
+}
+
+/*! @brief Tests that the priority of a request sets that of its session task, whether or not
+        requests are scheduled.
+ */
+- (void)testSessionTaskPriority {
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Request completed."];
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityInteractive
+                             completion:^{
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  [self installScheduler];
+  expectation = [self expectationWithDescription:@"Scheduled request completed."];
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                             completion:^{
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  NSArray<NSNumber *> *expectedPriorities =
+      @[ @(NSURLSessionTaskPriorityHigh), @(NSURLSessionTaskPriorityLow) ];
+  XCTAssertEqualObjects([self sessionTaskPriorities], expectedPriorities);
+}
+
+/*! @brief Tests that a request cancelled while waiting in the scheduler leaves the queue at once,
+        and is never sent.
+ */
+- (void)testCancelWaitingRequest {
+  OIDTokenRequestScheduler *scheduler = [self installScheduler];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Request completed."];
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                             completion:^{
+    [expectation fulfill];
+  }];
+  XCTestExpectation *cancelExpectation = [self expectationWithDescription:@"Request cancelled."];
+  OIDNetworkTask *networkTask =
+      [OIDAuthorizationService performTokenRequest:_tokenRequest
+                     originalAuthorizationResponse:nil
+                                          priority:OIDTokenRequestPriorityBackground
+                                           timeout:0
+                                          callback:^(OIDTokenResponse *_Nullable response,
+                                                     NSError *_Nullable error) {
+    XCTAssertNil(response);
+    NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+    XCTAssertEqual(underlyingError.code, NSURLErrorCancelled);
+    [cancelExpectation fulfill];
+  }];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 1);
+
+  [networkTask cancel];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 0);
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 1);
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityBackground], 0);
+}
+
+/*! @brief Tests that an interactive action joining a background refresh raises its priority.
+ */
+- (void)testInteractiveActionRaisesPriorityOfRefresh {
+  OIDTokenRequestScheduler *scheduler = [self installScheduler];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Requests completed."];
+  expectation.expectedFulfillmentCount = 3;
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                             completion:^{
+    [expectation fulfill];
+  }];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:0];
+  OIDAuthStateAction action =
+      ^(NSString *_Nullable accessToken, NSString *_Nullable idToken, NSError *_Nullable error) {
+    XCTAssertNotNil(accessToken, @"%@", error);
+    [expectation fulfill];
+  };
+  [authState performActionWithFreshTokens:action
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                 priority:OIDTokenRequestPriorityBackground
+                                  timeout:0];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 1);
+
+  [authState performActionWithFreshTokens:action
+              additionalRefreshParameters:nil
+                            dispatchQueue:dispatch_get_main_queue()
+                                 priority:OIDTokenRequestPriorityInteractive
+                                  timeout:0];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 0);
+  XCTAssertEqual([scheduler runningRequestCountForPriority:OIDTokenRequestPriorityInteractive], 1);
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 2);
+}
+
+/*! @brief Tests that cancelling the only action waiting for a refresh which still waits in the
+        scheduler withdraws the refresh, which is never sent.
+ */
+- (void)testCancellingActionWithdrawsWaitingRefresh {
+  OIDTokenRequestScheduler *scheduler = [self installScheduler];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Request completed."];
+  [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                             completion:^{
+    [expectation fulfill];
+  }];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:0];
+  XCTestExpectation *actionExpectation = [self expectationWithDescription:@"Action cancelled."];
+  OIDAuthStateAction action =
+      ^(NSString *_Nullable accessToken, NSString *_Nullable idToken, NSError *_Nullable error) {
+    XCTAssertNil(accessToken);
+    NSError *underlyingError = error.userInfo[NSUnderlyingErrorKey];
+    XCTAssertEqual(underlyingError.code, NSURLErrorCancelled);
+    [actionExpectation fulfill];
+  };
+  OIDNetworkTask *networkTask =
+      [authState performActionWithFreshTokens:action
+                  additionalRefreshParameters:nil
+                                dispatchQueue:dispatch_get_main_queue()
+                                     priority:OIDTokenRequestPriorityBackground
+                                      timeout:0];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 1);
+
+  [networkTask cancel];
+  XCTAssertEqual([scheduler waitingRequestCountForPriority:OIDTokenRequestPriorityBackground], 0);
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqual([OIDMockOpenIDProvider requestCount], 1);
+  XCTAssertEqualObjects(authState.refreshToken, @"refresh_token");
+}
+
+/*! @brief Measures the latency of an interactive token request while background requests contend
+        for a server answering each request after a delay.
+ */
+- (void)testInteractiveRequestUnderContentionPerformance {
+  [self installScheduler];
+  [OIDMockOpenIDProvider setLatency:0.02];
+  [self measureMetrics:@[ XCTPerformanceMetric_WallClockTime ]
+      automaticallyStartMeasuring:NO
+                         forBlock:^{
+    XCTestExpectation *backgroundExpectation =
+        [self expectationWithDescription:@"Background requests completed."];
+    backgroundExpectation.expectedFulfillmentCount = 20;
+    for (NSUInteger i = 0; i < 20; i++) {
+      [self performTokenRequestWithPriority:OIDTokenRequestPriorityBackground
+                                 completion:^{
+        [backgroundExpectation fulfill];
+      }];
+    }
+    XCTestExpectation *interactiveExpectation =
+        [self expectationWithDescription:@"Interactive request completed."];
+    [self startMeasuring];
+    [self performTokenRequestWithPriority:OIDTokenRequestPriorityInteractive
+                               completion:^{
+      [interactiveExpectation fulfill];
+    }];
+    [self waitForExpectations:@[ interactiveExpectation ] timeout:5];
+    [self stopMeasuring];
+    [self waitForExpectations:@[ backgroundExpectation ] timeout:5];
+  }];
+}
+
+@end
+
+#pragma GCC diagnostic pop
@@ -29,6 +29,7 @@
 #import "Sources/AppAuthCore/OIDScopeUtilities.h"
 #import "Sources/AppAuthCore/OIDServiceConfiguration.h"
 #import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDURLQueryComponent.h"
 #endif
 
 // Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
@@ -337,6 +338,69 @@ static NSString *const kTestAdditionalHeaderValue2 = @"3";
   XCTAssertNotNil(authorization);
 }
 
+/*! @brief Parses an "application/x-www-form-urlencoded" request body into a dictionary.
+ */
++ (NSDictionary *)parametersInBody:(NSData *)body {
+  NSString *bodyString = [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding];
+  NSURL *URL = [NSURL URLWithString:[@"https://www.example.com/?" stringByAppendingString:bodyString]];
+  return [[OIDURLQueryComponent alloc] initWithURL:URL].dictionaryValue;
+}
+
+/*! @brief Tests that the body sent for repeated requests of the same client has every parameter of
+        the request, including the client ID when no client secret is used.
+ */
+- (void)testURLRequestBody {
+  for (int i = 0; i < 2; i++) {
+    OIDTokenRequest *request = [[self class] testInstanceCodeExchange];
+    NSDictionary *parameters = [[self class] parametersInBody:[request URLRequest].HTTPBody];
+    NSMutableDictionary *expectedParameters = [request.additionalParameters mutableCopy];
+    expectedParameters[@"grant_type"] = request.grantType;
+    expectedParameters[@"code"] = request.authorizationCode;
+    expectedParameters[@"redirect_uri"] = request.redirectURL.absoluteString;
+    expectedParameters[@"scope"] = request.scope;
+    expectedParameters[@"refresh_token"] = request.refreshToken;
+    expectedParameters[@"code_verifier"] = request.codeVerifier;
+    expectedParameters[@"client_id"] = request.clientID;
+    XCTAssertEqualObjects(parameters, expectedParameters);
+  }
+
+  OIDTokenRequest *refresh = [[self class] testInstanceRefresh];
+  NSDictionary *parameters = [[self class] parametersInBody:[refresh URLRequest].HTTPBody];
+  XCTAssertEqualObjects(parameters[@"refresh_token"], refresh.refreshToken);
+  XCTAssertEqualObjects(parameters[@"grant_type"], refresh.grantType);
+}
+
+/*! @brief Tests that the cached Basic credential matches the credentials of each request.
+ */
+- (void)testURLRequestBasicClientAuthCredentials {
+  OIDTokenRequest *request = [[self class] testInstanceCodeExchangeClientAuth];
+  for (int i = 0; i < 2; i++) {
+    NSString *authorization = [request URLRequest].allHTTPHeaderFields[@"Authorization"];
+    NSString *credentials = [NSString stringWithFormat:@"%@:%@",
+                                                       request.clientID,
+                                                       request.clientSecret];
+    NSString *expected = [NSString stringWithFormat:@"Basic %@",
+        [[credentials dataUsingEncoding:NSUTF8StringEncoding] base64EncodedStringWithOptions:0]];
+    XCTAssertEqualObjects(authorization, expected);
+
+    NSDictionary *parameters = [[self class] parametersInBody:[request URLRequest].HTTPBody];
+    XCTAssertNil(parameters[@"client_id"]);
+  }
+}
+
+/*! @brief Measures building the URL request for repeated token refreshes of the same client.
+ */
+- (void)testRefreshURLRequestPerformance {
+  OIDTokenRequest *request = [[self class] testInstanceRefresh];
+  [self measureBlock:^{
+    for (int i = 0; i < 5000; i++) {
+      @autoreleasepool {
+        XCTAssertNotNil([request URLRequest].HTTPBody);
+      }
+    }
+  }];
+}
+
 - (void)testAuthorizationCodeNullRedirectURL {
   OIDAuthorizationResponse *authResponse = [OIDAuthorizationResponseTests testInstance];
   NSArray<NSString *> *scopesArray =
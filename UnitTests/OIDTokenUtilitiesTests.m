@@ -28,6 +28,17 @@
 @end
 @implementation OIDTokenUtilitiesTests
 
+- (void)testDecodeBase64urlNoPadding {
+  const uint8_t bytes[] = {0xfb, 0xff, 0x3f};
+  NSData *data = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+  NSString *encoded = [OIDTokenUtilities encodeBase64urlNoPadding:data];
+  XCTAssertEqualObjects(encoded, @"-_8_", @"");
+  XCTAssertEqualObjects([OIDTokenUtilities decodeBase64urlNoPadding:encoded], data, @"");
+  XCTAssertEqualObjects([OIDTokenUtilities decodeBase64urlNoPadding:@"YQ"],
+                        [@"a" dataUsingEncoding:NSUTF8StringEncoding], @"");
+  XCTAssertNil([OIDTokenUtilities decodeBase64urlNoPadding:@"Y"], @"");
+}
+
 - (void)testRedact {
   XCTAssertEqualObjects([OIDTokenUtilities redact:@"0123456789"], @"012345...[redacted]", @"");
 }
@@ -0,0 +1,166 @@
+/*! @file OIDTraceTests.m
+    @brief AppAuth iOS SDK
+    @copyright
+        Copyright 2026 The AppAuth Authors. All Rights Reserved.
+    @copydetails
+        Licensed under the Apache License, Version 2.0 (the "License");
+        you may not use this file except in compliance with the License.
+        You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+        Unless required by applicable law or agreed to in writing, software
+        distributed under the License is distributed on an "AS IS" BASIS,
+        WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+        See the License for the specific language governing permissions and
+        limitations under the License.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import "OIDMockOpenIDProvider.h"
+
+#if SWIFT_PACKAGE
+@import AppAuthCore;
+#else
+#import "Sources/AppAuthCore/OIDAuthState.h"
+#import "Sources/AppAuthCore/OIDAuthorizationService.h"
+#import "Sources/AppAuthCore/OIDTokenRequest.h"
+#import "Sources/AppAuthCore/OIDTokenResponse.h"
+#import "Sources/AppAuthCore/OIDTrace.h"
+#endif
+
+// Ignore warnings about "Use of GNU statement expression extension" which is raised by our use of
+// the XCTAssert___ macros.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+
+/*! @brief Records the traced intervals it observes.
+ */
+@interface OIDTraceTestsObserver : NSObject <OIDTraceObserver>
+
+/*! @brief The observed events, as "begin <phase>" or "end <phase>".
+ */
+@property(nonatomic, readonly) NSArray<NSString *> *events;
+
+/*! @brief The identifiers of intervals which began but have not ended.
+ */
+@property(nonatomic, readonly) NSSet<NSNumber *> *openIdentifiers;
+
+@end
+
+@implementation OIDTraceTestsObserver {
+  NSMutableArray<NSString *> *_events;
+  NSMutableSet<NSNumber *> *_openIdentifiers;
+}
+
+- (instancetype)init {
+  self = [super init];
+  if (self) {
+    _events = [NSMutableArray array];
+    _openIdentifiers = [NSMutableSet set];
+  }
+  return self;
+}
+
+- (NSArray<NSString *> *)events {
+  @synchronized(self) {
+    return [_events copy];
+  }
+}
+
+- (NSSet<NSNumber *> *)openIdentifiers {
+  @synchronized(self) {
+    return [_openIdentifiers copy];
+  }
+}
+
+- (void)tracePhase:(OIDTracePhase)phase didBeginWithIdentifier:(uint64_t)identifier {
+  @synchronized(self) {
+    [_events addObject:[@"begin " stringByAppendingString:[OIDTrace nameForPhase:phase]]];
+    [_openIdentifiers addObject:@(identifier)];
+  }
+}
+
+- (void)tracePhase:(OIDTracePhase)phase didEndWithIdentifier:(uint64_t)identifier {
+  @synchronized(self) {
+    [_events addObject:[@"end " stringByAppendingString:[OIDTrace nameForPhase:phase]]];
+    [_openIdentifiers removeObject:@(identifier)];
+  }
+}
+
+@end
+
+/*! @brief Unit tests for @c OIDTrace.
+ */
+@interface OIDTraceTests : XCTestCase
+@end
+
+@implementation OIDTraceTests
+
+- (void)setUp {
+  [super setUp];
+  [OIDMockOpenIDProvider install];
+}
+
+- (void)tearDown {
+  [OIDTrace setObserver:nil];
+  [OIDTrace setSignpostsEnabled:NO];
+  [OIDMockOpenIDProvider uninstall];
+  [super tearDown];
+}
+
+/*! @brief Tests that tracing is disabled until an observer is set or signposts are enabled.
+ */
+- (void)testDisabledByDefault {
+  XCTAssertNil([OIDTrace observer]);
+  XCTAssertFalse([OIDTrace signpostsEnabled]);
+  XCTAssertEqual(OIDTraceBeginPhase(OIDTracePhaseJSONParse), 0);
+
+  OIDTraceTestsObserver *observer = [[OIDTraceTestsObserver alloc] init];
+  [OIDTrace setObserver:observer];
+  uint64_t identifier = OIDTraceBeginPhase(OIDTracePhaseJSONParse);
+  XCTAssertNotEqual(identifier, 0);
+  OIDTraceEndPhase(OIDTracePhaseJSONParse, identifier);
+  NSArray<NSString *> *expected = @[ @"begin JSONParse", @"end JSONParse" ];
+  XCTAssertEqualObjects(observer.events, expected);
+
+  [OIDTrace setObserver:nil];
+  XCTAssertEqual(OIDTraceBeginPhase(OIDTracePhaseJSONParse), 0);
+  XCTAssertEqualObjects(observer.events, expected);
+}
+
+/*! @brief Tests that every phase of a token request is traced in order, and every interval ends.
+ */
+- (void)testTokenRequestPhases {
+  OIDTraceTestsObserver *observer = [[OIDTraceTestsObserver alloc] init];
+  [OIDTrace setObserver:observer];
+  [OIDTrace setSignpostsEnabled:YES];
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Token request completes."];
+  OIDAuthState *authState = [OIDMockOpenIDProvider authStateWithExpiresIn:3600];
+  OIDTokenRequest *request = [authState tokenRefreshRequest];
+  [OIDAuthorizationService performTokenRequest:request
+                                      callback:^(OIDTokenResponse *_Nullable tokenResponse,
+                                                 NSError *_Nullable error) {
+    XCTAssertNotNil(tokenResponse);
+    XCTAssertNil(error);
+    [expectation fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  NSArray<NSString *> *expected = @[
+    @"begin TokenRequestBuild", @"end TokenRequestBuild",
+    @"begin NetworkWait", @"end NetworkWait",
+    @"begin JSONParse", @"end JSONParse",
+    @"begin FieldMapping", @"end FieldMapping",
+    @"begin IDTokenValidation", @"end IDTokenValidation",
+    @"begin CallbackDispatch", @"end CallbackDispatch",
+  ];
+  XCTAssertEqualObjects(observer.events, expected);
+  XCTAssertEqual(observer.openIdentifiers.count, 0);
+}
+
+@end
+
+#pragma GCC diagnostic pop